@@ -0,0 +1,104 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include "quantsystem/common/util/file.h"
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/compression/compression.h"
+#include "quantsystem/algorithm/history_reader.h"
+namespace quantsystem {
+namespace algorithm {
+HistoryReader::HistoryReader() {
+}
+
+HistoryReader::~HistoryReader() {
+}
+
+int HistoryReader::ReadTradeBars(const SubscriptionDataConfig& config,
+                                 const DateTime& end, int count,
+                                 vector<TradeBar*>* bars) {
+  if (count <= 0) {
+    return 0;
+  }
+  // Days are read newest first, each one in time order
+  vector<vector<TradeBar*> > days;
+  int found = 0;
+  int missing_days = 0;
+  DateTime date = end.Date();
+  while (found < count && missing_days < kMaxMissingDays) {
+    date = date - TimeSpan::FromDays(1);
+    days.push_back(vector<TradeBar*>());
+    if (!ReadDay(config, date, &days.back()) || days.back().empty()) {
+      days.pop_back();
+      ++missing_days;
+      continue;
+    }
+    missing_days = 0;
+    found += days.back().size();
+  }
+  // Drop the oldest bars beyond count, then append in time order
+  const int dropped = std::max(found - count, 0);
+  int skip = dropped;
+  for (int i = static_cast<int>(days.size()) - 1; i >= 0; --i) {
+    vector<TradeBar*>& day = days[i];
+    int first = std::min(skip, static_cast<int>(day.size()));
+    STLDeleteContainerPointers(day.begin(), day.begin() + first);
+    skip -= first;
+    bars->insert(bars->end(), day.begin() + first, day.end());
+  }
+  return found - dropped;
+}
+
+bool HistoryReader::ReadDay(const SubscriptionDataConfig& config,
+                            const DateTime& date, vector<TradeBar*>* bars) {
+  string source = config.GetLocalSource(date);
+  if (!File::Exists(source)) {
+    return false;
+  }
+  string contents = compression::UnzipToString(source);
+  TradeBar factory;
+  string::size_type begin = 0;
+  while (begin < contents.size()) {
+    string::size_type end = contents.find('\n', begin);
+    if (end == string::npos) {
+      end = contents.size();
+    }
+    StringPiece line(contents.data() + begin, end - begin);
+    begin = end + 1;
+    if (!line.empty() && line[line.size() - 1] == '\r') {
+      line.remove_suffix(1);
+    }
+    data::BaseData* data = factory.Reader(config, line, date,
+                                          DataFeedEndpoint::kFileSystem);
+    if (data == NULL) {
+      continue;
+    }
+    TradeBar* bar = dynamic_cast<TradeBar*>(data);
+    if (bar == NULL) {
+      LOG(ERROR) << "Not a TradeBar line in " << source;
+      delete data;
+      continue;
+    }
+    bars->push_back(bar);
+  }
+  return true;
+}
+}  // namespace algorithm
+}  // namespace quantsystem
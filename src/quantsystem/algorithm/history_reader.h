@@ -0,0 +1,84 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_ALGORITYM_HISTORY_READER_H_
+#define QUANTSYSTEM_ALGORITYM_HISTORY_READER_H_
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/data/subscription_data_config.h"
+#include "quantsystem/common/data/market/tradebar.h"
+namespace quantsystem {
+using data::SubscriptionDataConfig;
+using data::market::TradeBar;
+namespace algorithm {
+/**
+ * Reads the most recent bars of a subscription straight from the local
+ * data store, in the day file layout used by the backtesting feed
+ * (SubscriptionDataConfig::GetLocalSource). Used to warm up indicators
+ * at registration without running the history through the engine.
+ * @ingroup AlgorithmLayer
+ */
+class HistoryReader {
+ public:
+  /**
+   * Standard constructor.
+   */
+  HistoryReader();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~HistoryReader();
+
+  /**
+   * Read the last bars of the subscription before a date.
+   *
+   * Day files are read backwards from the day before end until enough
+   * bars are found or kMaxMissingDays consecutive days have no file.
+   * @param config Subscription of the bars, must be a TradeBar subscription
+   * @param end The bars are taken from the days strictly before this date
+   * @param count Maximum number of bars
+   * @param bars[out] Bars in time order, owned by the caller
+   * @return Number of bars read.
+   */
+  int ReadTradeBars(const SubscriptionDataConfig& config, const DateTime& end,
+                    int count, vector<TradeBar*>* bars);
+
+  /**
+   * Parse every bar of one day file.
+   * @param config Subscription of the bars, must be a TradeBar subscription
+   * @param date Day of the file
+   * @param bars[out] Bars of the day in time order, owned by the caller
+   * @return False if there is no file for this day.
+   */
+  bool ReadDay(const SubscriptionDataConfig& config, const DateTime& date,
+               vector<TradeBar*>* bars);
+
+ private:
+  // Days without data (weekends, holidays) tolerated before giving up
+  static const int kMaxMissingDays = 14;
+
+  DISALLOW_COPY_AND_ASSIGN(HistoryReader);
+};
+}  // namespace algorithm
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_ALGORITYM_HISTORY_READER_H_
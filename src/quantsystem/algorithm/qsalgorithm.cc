@@ -17,20 +17,27 @@
  * @}
  */
 
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 using std::make_pair;
 #include <thread>
 #include <chrono>
 #include "quantsystem/common/strings/case.h"
+#include "quantsystem/common/strings/strcat.h"
 #include "quantsystem/common/orders/order.h"
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/common/data/consolidators/identity_data_consolidator.h"
+#include "quantsystem/common/data/consolidators/tradebar_consolidator.h"
+#include "quantsystem/algorithm/history_reader.h"
 #include "quantsystem/algorithm/qsalgorithm.h"
 namespace quantsystem {
 namespace algorithm {
 QSAlgorithm::QSAlgorithm()
     : locked_(false),
       quit_(false),
-      sent_no_data_error_(false) {
+      sent_no_data_error_(false),
+      indicator_warm_up_bars_(0) {
   run_mode_ = kSeries;
   live_mode_ = false;
   start_date_ = DateTime(1998, 01, 01);
@@ -43,6 +50,8 @@ QSAlgorithm::QSAlgorithm()
 }
 
 QSAlgorithm::~QSAlgorithm() {
+  STLDeleteElements(&indicator_updaters_);
+  STLDeleteValues(&indicator_graphs_);
 }
 
 void QSAlgorithm::Debug(const string& message) {
@@ -138,14 +147,38 @@ AverageTrueRange* QSAlgorithm::ATR(
     const string& symbol, int period,
     Resolution::Enum resolution,
     indicators::MovingAverageType type) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  AverageTrueRange* atr = graph->ATR(period, type);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return atr;
 }
 
 ExponentialMovingAverage* QSAlgorithm::EMA(const string& symbol, int period,
                               Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  ExponentialMovingAverage* ema = graph->EMA(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return ema;
 }
 
 SimpleMovingAverage* QSAlgorithm::SMA(const string& symbol, int period,
                          Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  SimpleMovingAverage* sma = graph->SMA(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return sma;
 }
 
 MovingAverageConvergenceDivergence* QSAlgorithm::MACD(
@@ -154,31 +187,81 @@ MovingAverageConvergenceDivergence* QSAlgorithm::MACD(
     int signal_period,
     Resolution::Enum resolution,
     indicators::MovingAverageType type) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  MovingAverageConvergenceDivergence* macd = graph->MACD(
+      fast_period, slow_period, signal_period, type);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return macd;
 }
 
 Maximum* QSAlgorithm::MAX(const string& symbol,
                           int period, Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  Maximum* maximum = graph->MAX(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return maximum;
 }
 
 Minimum* QSAlgorithm::MIN(const string& symbol,
                           int period, Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  Minimum* minimum = graph->MIN(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return minimum;
 }
 
 AroonOscillator* QSAlgorithm::AROON(const string& symbol,
                                     int period, Resolution::Enum resolution) {
+  return AROON(symbol, period, period, resolution);
 }
 
 AroonOscillator* QSAlgorithm::AROON(const string& symbol,
                                     int up_period, int down_period,
                                     Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  AroonOscillator* aroon = graph->AROON(up_period, down_period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return aroon;
 }
 
 Momentum* QSAlgorithm::MOM(const string& symbol,
                            int period, Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  Momentum* momentum = graph->MOM(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return momentum;
 }
 
 MomentumPercent* QSAlgorithm::MOMP(const string& symbol, int period,
                                    Resolution::Enum resolution) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  MomentumPercent* momentum = graph->MOMP(period);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return momentum;
 }
 
 RelativeStrengthIndex* QSAlgorithm::RSI(
@@ -186,13 +269,114 @@ RelativeStrengthIndex* QSAlgorithm::RSI(
     int period,
     Resolution::Enum resolution,
     indicators::MovingAverageType moving_average_type) {
+  IndicatorGraph* graph = GetIndicatorGraph(symbol, resolution);
+  if (graph == NULL) {
+    return NULL;
+  }
+  int size = graph->size();
+  RelativeStrengthIndex* rsi = graph->RSI(period, moving_average_type);
+  WarmUpGraph(symbol, resolution, graph, size);
+  return rsi;
 }
 
 void QSAlgorithm::RegisterIndicator(
     const string& symbol,
-    IndicatorBase<IndicatorDataPoint>* indicator,
+    IndicatorBase<IndicatorSample>* indicator,
     DataConsolidator* consolidator,
     const std::function<double(BaseData*)>* selector) {
+  RegisterUpdater(symbol, new SampleIndicatorUpdater(indicator, selector),
+                  consolidator);
+}
+
+void QSAlgorithm::RegisterIndicator(const string& symbol,
+                                    IndicatorBase<TradeBar>* indicator,
+                                    DataConsolidator* consolidator) {
+  RegisterUpdater(symbol, new TradeBarIndicatorUpdater(indicator),
+                  consolidator);
+}
+
+void QSAlgorithm::RegisterUpdater(const string& symbol,
+                                  IndicatorUpdater* updater,
+                                  DataConsolidator* consolidator) {
+  if (consolidator == NULL) {
+    LOG(ERROR) << "No consolidator for the indicator of " << symbol;
+    delete updater;
+    return;
+  }
+  indicator_updaters_.push_back(updater);
+  consolidator->DataConsolidated.Bind<IndicatorUpdater,
+                                      &IndicatorUpdater::Update>(updater);
+  subscription_manager_->AddConsolidator(symbol, consolidator);
+  if (indicator_warm_up_bars_ > 0) {
+    WarmUp(symbol, consolidator);
+  }
+}
+
+IndicatorGraph* QSAlgorithm::GetIndicatorGraph(const string& symbol,
+                                               Resolution::Enum resolution) {
+  const SubscriptionDataConfig* config =
+      subscription_manager_->GetSetting(symbol);
+  if (config == NULL) {
+    LOG(ERROR) << "Please subscribe to " << symbol <<
+        " before creating an indicator for it.";
+    return NULL;
+  }
+  pair<string, Resolution::Enum> key = make_pair(config->symbol, resolution);
+  IndicatorGraphMap::const_iterator found = indicator_graphs_.find(key);
+  if (found != indicator_graphs_.end()) {
+    return found->second;
+  }
+  DataConsolidator* consolidator = ResolveConsolidator(symbol, resolution);
+  if (consolidator == NULL) {
+    return NULL;
+  }
+  IndicatorGraph* graph = new IndicatorGraph(
+      CreateIndicatorName(config->symbol, "", resolution));
+  indicator_graphs_.insert(make_pair(key, graph));
+  IndicatorUpdater* updater = new IndicatorGraphUpdater(graph);
+  indicator_updaters_.push_back(updater);
+  consolidator->DataConsolidated.Bind<IndicatorUpdater,
+                                      &IndicatorUpdater::Update>(updater);
+  subscription_manager_->AddConsolidator(symbol, consolidator);
+  return graph;
+}
+
+void QSAlgorithm::WarmUpGraph(const string& symbol,
+                              Resolution::Enum resolution,
+                              IndicatorGraph* graph, int previous_size) {
+  if (indicator_warm_up_bars_ <= 0 || graph->size() == previous_size) {
+    return;
+  }
+  graph->Reset();
+  scoped_ptr<DataConsolidator> consolidator(
+      ResolveConsolidator(symbol, resolution));
+  IndicatorGraphUpdater updater(graph);
+  consolidator->DataConsolidated.Bind<IndicatorUpdater,
+                                      &IndicatorUpdater::Update>(&updater);
+  WarmUp(symbol, consolidator.get());
+}
+
+void QSAlgorithm::WarmUp(const string& symbol,
+                         DataConsolidator* consolidator) {
+  const SubscriptionDataConfig* config =
+      subscription_manager_->GetSetting(symbol);
+  if (config == NULL || config->type_name != typeid(TradeBar).name()) {
+    LOG(ERROR) << "Indicator warm up needs a TradeBar subscription: " <<
+        symbol;
+    return;
+  }
+  const Security* security = securities_->Get(config->symbol);
+  vector<TradeBar*> bars;
+  HistoryReader reader;
+  reader.ReadTradeBars(*config, live_mode_ ? DateTime() : start_date_,
+                       indicator_warm_up_bars_, &bars);
+  for (int i = 0; i < bars.size(); ++i) {
+    if (config->extended_market_hours || security == NULL ||
+        security->exchange()->DateTimeIsOpen(bars[i]->time())) {
+      consolidator->Update(bars[i]);
+    }
+  }
+  STLDeleteElements(&bars);
 }
 
 ///////////////// Plotting  /////////////////////////////////
@@ -215,121 +399,247 @@ int QSAlgorithm::SendOrder(const string& symbol,
                            OrderType type,
                            bool asynchronous,
                            const string& tag) {
-  int order_id = -1;
-  double price = 0;
-  if (symbol == "" || quantity == 0) {
-    return -1;
-  }
-  string symbol_up = strings::ToUpper(symbol);
-  if (!securities_->ContainsKey(symbol_up) && !sent_no_data_error_) {
-    sent_no_data_error_ = true;
-    Error("You haven't requested " + symbol +
-          " data. Add this with AddSecurity() in the Initialize() Method.");
-    return -1;
-  }
-  price = (*securities_)[symbol_up]->Price();
-  if (price == 0) {
-    Error("Asset price is $0."
-          "If using custom data make sure you've set the 'Value' property.");
-    return -1;
-  }
-  // Check the exchange is open before sending a market order
-  if (type == orders::kMarket &&
-      !(*securities_)[symbol_up]->exchange()->ExchangeOpen()) {
-    Error("Market order and exchange not open");
-    return -3;
+  Security* security = NULL;
+  int error = ValidateOrder(symbol, quantity, type, &security);
+  if (error < 0) {
+    return error;
   }
   // Add the order and create a new order Id
-  order_id = transactions_->AddOrder(new Order(symbol, quantity, type, time(),
-                                               price, tag));
+  int order_id = transactions_->AddOrder(
+      new Order(security->symbol(), quantity, type, time(),
+                security->Price(), tag));
   // Wait for the order event to process
   if (!asynchronous && type == orders::kMarket) {
-    // Wait for the market order to fill
-    const securities::OrderMap& orders = transactions_->orders();
-    securities::OrderMap::const_iterator it;
-    while ((it = orders.find(order_id)) == orders.end() ||
-           (it->second->status != orders::kFilled &&
-            it->second->status != orders::kInvalid &&
-            it->second->status != orders::kCanceled)
-           || processing_order_) {
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
+    WaitForOrders(vector<int>(1, order_id));
   }
   return order_id;
 }
 
+int QSAlgorithm::SendOrders(const vector<OrderRequest>& requests,
+                            vector<int>* order_ids,
+                            bool asynchronous) {
+  vector<Order*> new_orders;
+  vector<int> slots;
+  new_orders.reserve(requests.size());
+  order_ids->assign(requests.size(), -1);
+  for (int i = 0; i < requests.size(); ++i) {
+    const OrderRequest& request = requests[i];
+    Security* security = NULL;
+    int error = ValidateOrder(request.symbol, request.quantity, request.type,
+                              &security);
+    if (error < 0) {
+      (*order_ids)[i] = error;
+      continue;
+    }
+    new_orders.push_back(new Order(security->symbol(), request.quantity,
+                                   request.type, time(), security->Price(),
+                                   request.tag));
+    slots.push_back(i);
+  }
+  if (new_orders.empty()) {
+    return 0;
+  }
+  // Queue the whole batch under one lock
+  vector<int> ids;
+  transactions_->AddOrders(new_orders, &ids);
+  vector<int> market_ids;
+  for (int i = 0; i < ids.size(); ++i) {
+    (*order_ids)[slots[i]] = ids[i];
+    if (requests[slots[i]].type == orders::kMarket) {
+      market_ids.push_back(ids[i]);
+    }
+  }
+  if (!asynchronous) {
+    WaitForOrders(market_ids);
+  }
+  return ids.size();
+}
+
 void QSAlgorithm::Liquidate(vector<int>* order_list,
                             const string& symbol_to_liquidate) {
-  if (symbol_to_liquidate == "") {
-    return;
-  }
   string symbol_to = strings::ToUpper(symbol_to_liquidate);
   vector<string> symbols;
   securities_->Keys(&symbols);
+  vector<OrderRequest> requests;
   for (int i = 0; i < symbols.size(); ++i) {
     const string& symbol = symbols[i];
-    if (!(*portfolio_)[symbol]->HoldStock() || symbol != symbol_to) {
+    if (!(*portfolio_)[symbol]->HoldStock() ||
+        (symbol_to != "" && symbol != symbol_to)) {
       continue;
     }
-    int quantity = 0;
-    quantity = -(*portfolio_)[symbol]->quantity();
     // Liquidate at market price
-    order_list->push_back(SendOrder(symbol, quantity, orders::kMarket));
+    requests.push_back(
+        OrderRequest(symbol, -(*portfolio_)[symbol]->quantity()));
   }
+  vector<int> order_ids;
+  SendOrders(requests, &order_ids);
+  order_list->insert(order_list->end(), order_ids.begin(), order_ids.end());
 }
 
 void QSAlgorithm::SetHoldings(const string& symbol,
                               double percentage,
                               bool liquidate_existing_holdings,
                               const string& tag) {
-  if (!portfolio_->ContainsKey(symbol)) {
-    Debug(symbol +
-          " not found in portfolio. Request this data"
-          "when initializing the algorithm.");
-    return;
+  SetHoldingsBatch(vector<pair<string, double> >(
+      1, make_pair(symbol, percentage)), liquidate_existing_holdings, tag);
+}
+
+void QSAlgorithm::SetHoldingsBatch(
+    const vector<pair<string, double> >& targets,
+    bool liquidate_existing_holdings,
+    const string& tag,
+    vector<int>* order_ids) {
+  vector<OrderRequest> requests;
+  map<string, double> target_map;
+  for (int i = 0; i < targets.size(); ++i) {
+    const string& symbol = targets[i].first;
+    if (!portfolio_->ContainsKey(symbol)) {
+      Debug(symbol +
+            " not found in portfolio. Request this data"
+            "when initializing the algorithm.");
+      continue;
+    }
+    // Range check values:
+    double percentage = targets[i].second;
+    if (percentage > 1) percentage = 1;
+    if (percentage < -1) percentage = -1;
+    target_map[symbol] = percentage;
   }
-  // Range check values:
-  if (percentage > 1) percentage = 1;
-  if (percentage < -1) percentage = -1;
+  vector<int> ids;
   // If they triggered a liquidate
   if (liquidate_existing_holdings) {
+    vector<OrderRequest> liquidations;
     vector<string> holding_symbols;
     portfolio_->Keys(&holding_symbols);
     for (int i = 0; i < holding_symbols.size(); ++i) {
       const string& holding_symbol = holding_symbols[i];
-      if (holding_symbol != symbol &&
+      if (target_map.count(holding_symbol) == 0 &&
           (*portfolio_)[holding_symbol]->AbsoluteQuantity() > 0) {
-        // Go through all existing holdings [synchronously],
-        // market order the inverse quantity
-        SendOrder(holding_symbol, -(*portfolio_)[holding_symbol]->quantity());
+        // Market order the inverse quantity
+        liquidations.push_back(OrderRequest(
+            holding_symbol, -(*portfolio_)[holding_symbol]->quantity()));
       }
     }
+    // The targets need the cash the liquidations free: wait for their
+    // fills before sizing, except under simulated latency
+    SendOrders(liquidations, &ids);
   }
-  // the whole: Cash * Leverage for remaining buying power
-  double total = portfolio_->TotalHoldingsValue() + portfolio_->cash() *
-      (*securities_)[symbol]->leverage();
-  // Difference between our target % and our current holdings:
-  // (relative +- number).
-  double delta_value = (total * percentage) -
-      (*portfolio_)[symbol]->HoldingsValue();
-  int delta_quantity = 0;
-  if (abs((*securities_)[symbol]->Price()) > 0) {
-    delta_quantity = delta_value / (*securities_)[symbol]->Price();
+  // Every target is sized against the same snapshot of the portfolio
+  double holdings_value = portfolio_->TotalHoldingsValue();
+  for (map<string, double>::const_iterator it = target_map.begin();
+       it != target_map.end(); ++it) {
+    Security* security = (*securities_)[it->first];
+    // the whole: Cash * Leverage for remaining buying power
+    double total = holdings_value + portfolio_->cash() * security->leverage();
+    // Difference between our target % and our current holdings:
+    // (relative +- number).
+    double delta_value = (total * it->second) -
+        security->holdings()->HoldingsValue();
+    double price = security->Price();
+    int delta_quantity = 0;
+    if (std::fabs(price) > 0) {
+      delta_quantity = delta_value / price;
+    }
+    if (abs(delta_quantity) > 0) {
+      requests.push_back(OrderRequest(it->first, delta_quantity,
+                                      orders::kMarket, tag));
+    }
   }
-  if (abs(delta_quantity) > 0) {
-    SendOrder(symbol, delta_quantity, orders::kMarket, false, tag);
+  vector<int> target_ids;
+  SendOrders(requests, &target_ids);
+  ids.insert(ids.end(), target_ids.begin(), target_ids.end());
+  if (order_ids != NULL) {
+    order_ids->insert(order_ids->end(), ids.begin(), ids.end());
+  }
+}
+
+int QSAlgorithm::ValidateOrder(const string& symbol, int quantity,
+                               OrderType type, Security** security) {
+  if (symbol == "" || quantity == 0) {
+    return -1;
+  }
+  string symbol_up = strings::ToUpper(symbol);
+  *security = securities_->Get(symbol_up);
+  if (*security == NULL) {
+    if (!sent_no_data_error_) {
+      sent_no_data_error_ = true;
+      Error("You haven't requested " + symbol +
+            " data. Add this with AddSecurity() in the Initialize() Method.");
+    }
+    return -1;
+  }
+  if ((*security)->Price() == 0) {
+    Error("Asset price is $0."
+          "If using custom data make sure you've set the 'Value' property.");
+    return -1;
+  }
+  // Check the exchange is open before sending a market order
+  if (type == orders::kMarket && !(*security)->exchange()->ExchangeOpen()) {
+    Error("Market order and exchange not open");
+    return -3;
+  }
+  return 0;
+}
+
+void QSAlgorithm::WaitForOrders(const vector<int>& order_ids) {
+  // Under simulated latency the fills only come once time moves on
+  if (transactions_->simulated_latency()) {
+    return;
+  }
+  // Wait for the market orders to fill
+  const securities::OrderMap& orders = transactions_->orders();
+  for (int i = 0; i < order_ids.size(); ++i) {
+    securities::OrderMap::const_iterator it;
+    while ((it = orders.find(order_ids[i])) == orders.end() ||
+           (it->second->status != orders::kFilled &&
+            it->second->status != orders::kInvalid &&
+            it->second->status != orders::kCanceled)
+           || processing_order_) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
   }
 }
 
 DataConsolidator* QSAlgorithm::ResolveConsolidator(
     const string& symbol,
     Resolution::Enum resolution) {
+  const SubscriptionDataConfig* config =
+      subscription_manager_->GetSetting(symbol);
+  if (config == NULL) {
+    LOG(ERROR) << "Please subscribe to " << symbol <<
+        " before registering an indicator for it.";
+    return NULL;
+  }
+  if (config->resolution == resolution) {
+    return new data::consolidators::IdentityDataConsolidator();
+  }
+  return data::consolidators::TradeBarConsolidator::FromResolution(
+      resolution);
 }
 
 string QSAlgorithm::CreateIndicatorName(
     const string& symbol,
     const string& type,
     Resolution::Enum resolution) {
+  string suffix;
+  switch (resolution) {
+    case Resolution::kTick:
+      suffix = "_tick";
+      break;
+    case Resolution::kSecond:
+      suffix = "_sec";
+      break;
+    case Resolution::kMinute:
+      suffix = "_min";
+      break;
+    case Resolution::kHour:
+      suffix = "_hr";
+      break;
+    case Resolution::kDaily:
+      suffix = "_day";
+      break;
+  }
+  return StrCat(type, "(", symbol, suffix, ")");
 }
 
 }  // namespace algorithm
@@ -33,6 +33,9 @@ using std::string;
 using std::vector;
 #include <map>
 using std::map;
+#include <utility>
+using std::pair;
+#include <functional>
 #include "quantsystem/interfaces/ialgorithm.h"
 #include "quantsystem/common/global.h"
 #include "quantsystem/common/time/date_time.h"
@@ -47,7 +50,8 @@ using std::map;
 #include "quantsystem/common/securities/security_portfolio_manager.h"
 #include "quantsystem/common/securities/security_transaction_manager.h"
 #include "quantsystem/indicators/indicator_base.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/indicator_graph.h"
 #include "quantsystem/indicators/average_true_range.h"
 #include "quantsystem/indicators/moving_average_type.h"
 #include "quantsystem/indicators/exponential_indicator.h"
@@ -66,8 +70,10 @@ using orders::OrderEvent;
 using orders::OrderType;
 using data::SubscriptionManager;
 using data::market::Ticks;
+using data::market::TradeBar;
 using data::market::TradeBars;
 using data::consolidators::DataConsolidator;
+using securities::Security;
 using securities::SecurityManager;
 using securities::SecurityPortfolioManager;
 using securities::SecurityTransactionManager;
@@ -82,7 +88,8 @@ using indicators::Momentum;
 using indicators::MomentumPercent;
 using indicators::RelativeStrengthIndex;
 using indicators::IndicatorBase;
-using indicators::IndicatorDataPoint;
+using indicators::IndicatorSample;
+using indicators::IndicatorGraph;
 namespace algorithm {
 /**
  * QS Algorithm Base Class - Handle the basic requirements of a
@@ -500,7 +507,7 @@ class QSAlgorithm : public IAlgorithm {
   void RegisterIndicator(
       const string& symbol,
       Resolution::Enum resolution,
-      IndicatorBase<IndicatorDataPoint>* indicator,
+      IndicatorBase<IndicatorSample>* indicator,
       const std::function<double(BaseData*)>* selector = NULL) {
     RegisterIndicator(symbol,  indicator,
                       ResolveConsolidator(symbol, resolution), selector);
@@ -518,10 +525,55 @@ class QSAlgorithm : public IAlgorithm {
    * (x => x.Value)
    */
   void RegisterIndicator(const string& symbol,
-                         IndicatorBase<IndicatorDataPoint>* indicator,
+                         IndicatorBase<IndicatorSample>* indicator,
                          DataConsolidator* consolidator,
                          const std::function<double(BaseData*)>* selector= NULL);
 
+  /**
+   * Creates and registers a new consolidator at the specified resolution
+   * and configures the TradeBar indicator to receive its bars.
+   *
+   * @param symbol The symbol to register against
+   * @param resolution The resolution at which to send data to the indicator
+   * @param indicator[out] The indicator to receive data from the consolidator
+   */
+  void RegisterIndicator(const string& symbol,
+                         Resolution::Enum resolution,
+                         IndicatorBase<TradeBar>* indicator) {
+    RegisterIndicator(symbol, indicator,
+                      ResolveConsolidator(symbol, resolution));
+  }
+
+  /**
+   * Registers the consolidator to receive automatic updates as well as
+   * configures the TradeBar indicator to receive its bars.
+   *
+   * @param symbol The symbol to register against
+   * @param indicator[out] The indicator to receive data from the consolidator
+   * @param consolidator[out] The consolidator to receive raw subscription data
+   */
+  void RegisterIndicator(const string& symbol,
+                         IndicatorBase<TradeBar>* indicator,
+                         DataConsolidator* consolidator);
+
+  /**
+   * Warm up every indicator registered from now on with the last bars
+   * of its subscription in the local data store, so it is ready at the
+   * first OnData. The history ends at the start date (backtest) or now
+   * (live) and is fed straight to the consolidator of the indicator.
+   * Call it in Initialize() after AddSecurity().
+   * @param bar_count Number of bars at the subscription resolution,
+   * 0 to disable the warm up
+   */
+  void SetIndicatorWarmUp(int bar_count) {
+    indicator_warm_up_bars_ = bar_count;
+  }
+
+  /**
+   * Number of bars used to warm up new indicators, 0 if disabled.
+   */
+  int indicator_warm_up_bars() const { return indicator_warm_up_bars_; }
+
   ///////////////// Plotting  /////////////////////////////////
   /**
    * Add a chart to the internal algorithm list.
@@ -598,6 +650,59 @@ class QSAlgorithm : public IAlgorithm {
                    bool liquidate_existing_holdings = false,
                    const string& tag = "");
 
+  /**
+   * One order of a batch submitted with SendOrders.
+   */
+  class OrderRequest {
+   public:
+    string symbol;  // Symbol of the asset
+    int quantity;  // Quantity to trade, + long, - short
+    OrderType type;  // Market, Limit or Stop Order
+    string tag;  // Custom data for this order
+    OrderRequest(const string& in_symbol, int in_quantity,
+                 OrderType in_type = orders::kMarket,
+                 const string& in_tag = "")
+        : symbol(in_symbol),
+          quantity(in_quantity),
+          type(in_type),
+          tag(in_tag) {
+    }
+  };
+
+  /**
+   * Validate and send a batch of orders to the transaction manager.
+   *
+   * Every request goes through the same checks as SendOrder, the valid
+   * orders are then queued under a single lock and, unless asynchronous,
+   * the market orders are waited for together.
+   * @param requests Orders to send
+   * @param order_ids[out] Order id for every request, in the same order,
+   * or the negative SendOrder error code of a rejected request
+   * @param asynchronous Don't wait for the responses
+   * @return Number of orders queued
+   */
+  virtual int SendOrders(const vector<OrderRequest>& requests,
+                         vector<int>* order_ids,
+                         bool asynchronous = false);
+
+  /**
+   * Set the holdings of a whole target portfolio in one pass.
+   *
+   * Like SetHoldings for every target: the liquidations are sent and,
+   * unless the transactions simulate latency, filled first; then every
+   * target is sized against the same portfolio snapshot and sent with
+   * one SendOrders.
+   * @param targets Symbol and fraction of portfolio for each holding
+   * @param liquidate_existing_holdings Bool flag to liquidate the
+   * holdings which are not in the targets
+   * @param tag Tag the orders with a short string
+   * @param order_ids[out] Ids of the orders sent, can be NULL
+   */
+  void SetHoldingsBatch(const vector<pair<string, double> >& targets,
+                        bool liquidate_existing_holdings = false,
+                        const string& tag = "",
+                        vector<int>* order_ids = NULL);
+
  protected:
   bool locked_;
   bool quit_;
@@ -611,6 +716,122 @@ class QSAlgorithm : public IAlgorithm {
   typedef map<string, Chart*> ChartsMap;
   ChartsMap charts_;
 
+  /**
+   * Feeds the consolidated data of a subscription to an indicator.
+   */
+  class IndicatorUpdater {
+   public:
+    virtual ~IndicatorUpdater() {}
+    virtual void Update(BaseData* data) = 0;
+  };
+
+  /**
+   * Updater of a value indicator: the selector picks the value of the
+   * data, BaseData::value() if there is none.
+   */
+  class SampleIndicatorUpdater : public IndicatorUpdater {
+   public:
+    SampleIndicatorUpdater(IndicatorBase<IndicatorSample>* indicator,
+                           const std::function<double(BaseData*)>* selector)
+        : indicator_(indicator),
+          has_selector_(selector != NULL) {
+      if (has_selector_) {
+        selector_ = *selector;
+      }
+    }
+    virtual void Update(BaseData* data) {
+      indicator_->Update(indicators::ToIndicatorSample(
+          data->time(), has_selector_ ? selector_(data) : data->value()));
+    }
+
+   private:
+    IndicatorBase<IndicatorSample>* indicator_;
+    bool has_selector_;
+    std::function<double(BaseData*)> selector_;
+  };
+
+  /**
+   * Updater of a TradeBar indicator.
+   */
+  class TradeBarIndicatorUpdater : public IndicatorUpdater {
+   public:
+    explicit TradeBarIndicatorUpdater(IndicatorBase<TradeBar>* indicator)
+        : indicator_(indicator) {
+    }
+    virtual void Update(BaseData* data) {
+      TradeBar* bar = dynamic_cast<TradeBar*>(data);
+      if (bar == NULL) {
+        LOG(ERROR) << "TradeBar indicator " << indicator_->name() <<
+            " registered on a non TradeBar subscription";
+        return;
+      }
+      indicator_->Update(*bar);
+    }
+
+   private:
+    IndicatorBase<TradeBar>* indicator_;
+  };
+
+  /**
+   * Updater of the indicator graph of a stream.
+   */
+  class IndicatorGraphUpdater : public IndicatorUpdater {
+   public:
+    explicit IndicatorGraphUpdater(IndicatorGraph* graph)
+        : graph_(graph) {
+    }
+    virtual void Update(BaseData* data) {
+      graph_->Update(*data);
+    }
+
+   private:
+    IndicatorGraph* graph_;
+  };
+
+  // Indicator updaters bound to the consolidators
+  vector<IndicatorUpdater*> indicator_updaters_;
+  // Indicators created by the helper functions (SMA, EMA, ...), one
+  // shared graph per symbol and resolution
+  typedef map<pair<string, Resolution::Enum>, IndicatorGraph*>
+      IndicatorGraphMap;
+  IndicatorGraphMap indicator_graphs_;
+  // Bars of history fed to new indicators, 0 if disabled
+  int indicator_warm_up_bars_;
+
+  /**
+   * Bind the updater to the consolidator, add the consolidator to the
+   * subscription of the symbol and warm it up.
+   */
+  void RegisterUpdater(const string& symbol, IndicatorUpdater* updater,
+                       DataConsolidator* consolidator);
+
+  /**
+   * Feed the history of the symbol to a new consolidator.
+   * @param symbol Symbol of the subscription
+   * @param consolidator Consolidator of the indicator
+   */
+  void WarmUp(const string& symbol, DataConsolidator* consolidator);
+
+  /**
+   * Get the indicator graph of a symbol and resolution, created and
+   * registered on a new consolidator the first time.
+   * @return The graph, NULL if the symbol is not subscribed.
+   */
+  IndicatorGraph* GetIndicatorGraph(const string& symbol,
+                                    Resolution::Enum resolution);
+
+  /**
+   * Warm up a graph again after the helper added nodes to it: every
+   * node is reset and the history replayed through a temporary
+   * consolidator, so new and shared nodes end in the same state.
+   * @param symbol Symbol of the subscription
+   * @param resolution Resolution of the graph
+   * @param graph Graph of the symbol and resolution
+   * @param previous_size Number of nodes before the helper call
+   */
+  void WarmUpGraph(const string& symbol, Resolution::Enum resolution,
+                   IndicatorGraph* graph, int previous_size);
+
   /**
    * Gets the default consolidator for the specified symbol and resolution
    *
@@ -632,6 +853,23 @@ class QSAlgorithm : public IAlgorithm {
   static string CreateIndicatorName(const string& symbol,
                                     const string& type,
                                     Resolution::Enum resolution);
+
+  /**
+   * Run the SendOrder checks on one order.
+   * @param symbol Symbol of the order
+   * @param quantity Quantity of the order
+   * @param type Order type
+   * @param security[out] Security of the upper cased symbol
+   * @return 0 if the order can be sent, or the negative error code.
+   */
+  int ValidateOrder(const string& symbol, int quantity, OrderType type,
+                    Security** security);
+
+  /**
+   * Block until the market orders are filled, invalidated or canceled.
+   * @param order_ids Ids of the market orders to wait for
+   */
+  void WaitForOrders(const vector<int>& order_ids);
 };
 
 }  // namespace algorithm
@@ -0,0 +1,140 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/algorithm/history_reader.h"
+#include "quantsystem/algorithm/qsalgorithm.h"
+#include "quantsystem/common/base/stringprintf.h"
+#include "quantsystem/common/strings/strcat.h"
+#include "quantsystem/common/util/file.h"
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/compression/compression.h"
+#include "quantsystem/configuration/test/quantsystem_gtest.h"
+#include "quantsystem/indicators/exponential_indicator.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace algorithm {
+using indicators::ExponentialMovingAverage;
+using indicators::MakeIndicatorSample;
+using indicators::SimpleMovingAverage;
+
+// Day files of SPY minute bars written in the data layout of the
+// backtesting feed, under the test temporary directory
+class HistoryReaderTestFixture : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    char cwd[4096];
+    CHECK(getcwd(cwd, sizeof(cwd)) != NULL);
+    cwd_ = cwd;
+    CHECK_EQ(0, chdir(GetTestingTempDir().c_str()));
+    ASSERT_TRUE(File::RecursivelyCreateDirWithPermissions(
+        "data/equity/minute/spy", S_IRWXU).ok());
+    // Friday and Monday, 10 bars each from 9:30
+    WriteDay(DateTime(2013, 10, 4), 0, 10);
+    WriteDay(DateTime(2013, 10, 7), 10, 10);
+  }
+
+  virtual void TearDown() {
+    CHECK_EQ(0, chdir(cwd_.c_str()));
+  }
+
+  // Close of the n-th bar of the fixture
+  static double Close(int n) {
+    return 100 + (n % 7) * 0.25 + n * 0.01;
+  }
+
+  void WriteDay(const DateTime& date, int first, int count) {
+    string contents;
+    for (int i = 0; i < count; ++i) {
+      int64 close = static_cast<int64>(Close(first + i) * 10000 + 0.5);
+      contents += StringPrintf("%d,%lld,%lld,%lld,%lld,%d\n",
+                               34200000 + i * 60000, close - 500, close + 1000,
+                               close - 1000, close, 1000 + i);
+    }
+    ASSERT_TRUE(compression::ZipFromString(
+        StrCat("data/equity/minute/spy/", date.ToShortString(), "_trade"),
+        contents));
+  }
+
+ private:
+  string cwd_;
+};
+
+TEST_F(HistoryReaderTestFixture, TestReadsLastBarsAcrossDays) {
+  SubscriptionDataConfig config(typeid(TradeBar).name(),
+                                SecurityType::kEquity, "SPY",
+                                Resolution::kMinute);
+  HistoryReader reader;
+  vector<TradeBar*> bars;
+  EXPECT_FALSE(reader.ReadDay(config, DateTime(2013, 10, 5), &bars));
+  // The weekend is skipped: 5 bars of Friday then the 10 of Monday
+  EXPECT_EQ(15, reader.ReadTradeBars(config, DateTime(2013, 10, 8), 15,
+                                     &bars));
+  ASSERT_EQ(15, bars.size());
+  for (int i = 0; i < bars.size(); ++i) {
+    EXPECT_NEAR(Close(5 + i), bars[i]->close(), 1e-9);
+    if (i > 0) {
+      EXPECT_TRUE(bars[i - 1]->time() < bars[i]->time());
+    }
+  }
+  EXPECT_TRUE(DateTime(2013, 10, 7) + TimeSpan::FromMinutes(9 * 60 + 39) ==
+              bars.back()->time());
+  STLDeleteElements(&bars);
+  // Not enough history: everything up to the end date
+  EXPECT_EQ(10, reader.ReadTradeBars(config, DateTime(2013, 10, 7), 100,
+                                     &bars));
+  EXPECT_NEAR(Close(0), bars.front()->close(), 1e-9);
+  STLDeleteElements(&bars);
+}
+
+TEST_F(HistoryReaderTestFixture, TestIndicatorWarmUpMatchesReplay) {
+  QSAlgorithm algorithm;
+  algorithm.SetStartDate(2013, 10, 8);
+  // Extended hours: no exchange filter on the warm up bars
+  algorithm.AddSecurity(SecurityType::kEquity, "SPY", Resolution::kMinute,
+                        true, 1, true);
+  algorithm.SetIndicatorWarmUp(15);
+  SimpleMovingAverage* sma = algorithm.SMA("SPY", 10, Resolution::kMinute);
+  ExponentialMovingAverage* ema = algorithm.EMA("SPY", 5,
+                                                Resolution::kMinute);
+  ASSERT_TRUE(sma != NULL);
+  ASSERT_TRUE(ema != NULL);
+  EXPECT_TRUE(sma->is_ready());
+  EXPECT_TRUE(ema->is_ready());
+  // The same bars streamed one by one into fresh indicators
+  SimpleMovingAverage sma_replay(10);
+  ExponentialMovingAverage ema_replay(5);
+  for (int i = 5; i < 20; ++i) {
+    sma_replay.Update(MakeIndicatorSample(i, Close(i)));
+    ema_replay.Update(MakeIndicatorSample(i, Close(i)));
+  }
+  EXPECT_EQ(sma_replay.samples(), sma->samples());
+  EXPECT_NEAR(sma_replay.value(), sma->value(), 1e-9);
+  EXPECT_EQ(ema_replay.samples(), ema->samples());
+  EXPECT_NEAR(ema_replay.value(), ema->value(), 1e-9);
+}
+}  // namespace algorithm
+}  // namespace quantsystem
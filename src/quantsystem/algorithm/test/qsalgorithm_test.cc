@@ -0,0 +1,227 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+using std::string;
+#include <thread>
+#include <utility>
+using std::make_pair;
+using std::pair;
+#include <vector>
+using std::vector;
+#include "quantsystem/algorithm/qsalgorithm.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/orders/order_event.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace algorithm {
+namespace {
+using data::market::TradeBar;
+const time_t kStart = 1420194600;  // 2015-01-02 10:30:00 UTC
+
+class TestAlgorithm : public QSAlgorithm {
+ public:
+  using QSAlgorithm::ValidateOrder;
+
+  // Base securities: always open, no fees. IBM is never priced.
+  TestAlgorithm() {
+    const char* symbols[] = {"AAPL", "IBM", "MSFT", "SPY"};
+    for (int i = 0; i < 4; ++i) {
+      AddSecurity(SecurityType::kBase, symbols[i], Resolution::kMinute,
+                  true, 1, false);
+    }
+    SetCash(100000);
+    // The orders stay queued: no transaction handler to wait for
+    transactions()->set_simulated_latency(true);
+  }
+
+  ~TestAlgorithm() {
+    for (int i = 0; i < bars_.size(); ++i) {
+      delete bars_[i];
+    }
+  }
+
+  void SetPrice(const string& symbol, double price) {
+    TradeBar* bar = new TradeBar(DateTime(kStart), symbol, price, price,
+                                 price, price, 100);
+    bars_.push_back(bar);
+    securities()->Update(DateTime(kStart), vector<BaseData*>(1, bar));
+  }
+
+  // Orders waiting for the transaction handler, in queue order
+  void PopOrders(vector<Order*>* orders) {
+    Order* order = NULL;
+    while (transactions()->PopOrder(&order)) {
+      orders->push_back(order);
+    }
+  }
+
+ private:
+  vector<TradeBar*> bars_;
+};
+
+// Transaction handler filling every market order at its price
+class FillingHandler {
+ public:
+  // Status of the order id after the filled one, at the time of the fill
+  vector<orders::OrderStatus> next_status;
+
+  explicit FillingHandler(QSAlgorithm* algorithm)
+      : algorithm_(algorithm),
+        done_(false),
+        thread_(&FillingHandler::Run, this) {
+  }
+
+  ~FillingHandler() {
+    done_.store(true);
+    thread_.join();
+  }
+
+ private:
+  QSAlgorithm* algorithm_;
+  std::atomic<bool> done_;
+  std::thread thread_;
+
+  void Run() {
+    while (!done_.load()) {
+      Order* order = NULL;
+      if (!algorithm_->transactions()->PopOrder(&order)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      next_status.push_back(
+          algorithm_->transactions()->GetOrderStatus(order->id + 1));
+      orders::OrderEvent fill(order->id, order->symbol, orders::kFilled,
+                              order->price, order->quantity);
+      algorithm_->portfolio()->ProcessFill(fill);
+      order->status = orders::kFilled;
+      algorithm_->transactions()->orders()[order->id] = order;
+    }
+  }
+};
+}  // namespace
+
+TEST(QSAlgorithm, TestSendOrdersKeepsErrorSlots) {
+  TestAlgorithm algorithm;
+  algorithm.SetPrice("SPY", 200);
+  algorithm.SetPrice("AAPL", 100);
+  Security* security = NULL;
+  EXPECT_EQ(0, algorithm.ValidateOrder("spy", 10, orders::kMarket,
+                                       &security));
+  EXPECT_EQ("SPY", security->symbol());
+  EXPECT_EQ(-1, algorithm.ValidateOrder("SPY", 0, orders::kMarket,
+                                        &security));
+  EXPECT_EQ(-1, algorithm.ValidateOrder("IBM", 5, orders::kLimit,
+                                        &security));
+  vector<QSAlgorithm::OrderRequest> requests;
+  requests.push_back(QSAlgorithm::OrderRequest("SPY", 10));
+  requests.push_back(QSAlgorithm::OrderRequest("", 5));
+  requests.push_back(QSAlgorithm::OrderRequest("IBM", 5, orders::kLimit));
+  requests.push_back(QSAlgorithm::OrderRequest("XYZ", 5));
+  requests.push_back(QSAlgorithm::OrderRequest("aapl", -3, orders::kLimit,
+                                               "tagged"));
+  vector<int> order_ids;
+  EXPECT_EQ(2, algorithm.SendOrders(requests, &order_ids));
+  ASSERT_EQ(5, order_ids.size());
+  EXPECT_LE(0, order_ids[0]);
+  EXPECT_EQ(-1, order_ids[1]);
+  EXPECT_EQ(-1, order_ids[2]);
+  EXPECT_EQ(-1, order_ids[3]);
+  EXPECT_EQ(order_ids[0] + 1, order_ids[4]);
+  vector<Order*> orders;
+  algorithm.PopOrders(&orders);
+  ASSERT_EQ(2, orders.size());
+  EXPECT_EQ(order_ids[0], orders[0]->id);
+  EXPECT_EQ("SPY", orders[0]->symbol);
+  EXPECT_EQ(10, orders[0]->quantity);
+  EXPECT_EQ(200, orders[0]->price);
+  EXPECT_EQ(order_ids[4], orders[1]->id);
+  EXPECT_EQ("AAPL", orders[1]->symbol);
+  EXPECT_EQ(orders::kLimit, orders[1]->type);
+  EXPECT_EQ("tagged", orders[1]->tag);
+  for (int i = 0; i < orders.size(); ++i) {
+    delete orders[i];
+  }
+}
+
+TEST(QSAlgorithm, TestSetHoldingsBatchSizesOneSnapshot) {
+  TestAlgorithm algorithm;
+  algorithm.SetPrice("SPY", 100);
+  algorithm.SetPrice("AAPL", 50);
+  algorithm.SetPrice("MSFT", 40);
+  // 10000 of SPY long, 1000 of MSFT short and 89000 of cash
+  algorithm.portfolio()->set_cash(89000);
+  algorithm.securities()->Get("SPY")->holdings()->SetHoldings(100, 100);
+  algorithm.securities()->Get("MSFT")->holdings()->SetHoldings(40, -25);
+  vector<pair<string, double> > targets;
+  targets.push_back(make_pair("SPY", 0.5));
+  targets.push_back(make_pair("AAPL", -0.25));
+  targets.push_back(make_pair("NOPE", 0.1));
+  vector<int> order_ids;
+  algorithm.SetHoldingsBatch(targets, true, "rebalance", &order_ids);
+  vector<Order*> orders;
+  algorithm.PopOrders(&orders);
+  ASSERT_EQ(3, orders.size());
+  ASSERT_EQ(3, order_ids.size());
+  // The holding outside the targets is liquidated first
+  EXPECT_EQ("MSFT", orders[0]->symbol);
+  EXPECT_EQ(25, orders[0]->quantity);
+  // Every target is sized off the same 100000 total, not off the
+  // portfolio left after the previous order
+  EXPECT_EQ("AAPL", orders[1]->symbol);
+  EXPECT_EQ(-500, orders[1]->quantity);
+  EXPECT_EQ("SPY", orders[2]->symbol);
+  EXPECT_EQ(400, orders[2]->quantity);
+  EXPECT_EQ("rebalance", orders[2]->tag);
+  for (int i = 0; i < orders.size(); ++i) {
+    EXPECT_EQ(order_ids[i], orders[i]->id);
+    delete orders[i];
+  }
+}
+
+TEST(QSAlgorithm, TestSetHoldingsBatchFillsLiquidationsFirst) {
+  TestAlgorithm algorithm;
+  algorithm.transactions()->set_simulated_latency(false);
+  algorithm.SetPrice("SPY", 100);
+  algorithm.SetPrice("AAPL", 50);
+  algorithm.SetPrice("MSFT", 40);
+  algorithm.portfolio()->set_cash(89000);
+  algorithm.securities()->Get("SPY")->holdings()->SetHoldings(100, 100);
+  algorithm.securities()->Get("MSFT")->holdings()->SetHoldings(40, -25);
+  vector<pair<string, double> > targets;
+  targets.push_back(make_pair("SPY", 0.5));
+  targets.push_back(make_pair("AAPL", -0.25));
+  vector<int> order_ids;
+  FillingHandler handler(&algorithm);
+  algorithm.SetHoldingsBatch(targets, true, "", &order_ids);
+  ASSERT_EQ(3, order_ids.size());
+  ASSERT_EQ(3, handler.next_status.size());
+  // The liquidation is filled before the targets are even sized
+  EXPECT_EQ(orders::kNone, handler.next_status[0]);
+  EXPECT_EQ(0, (*algorithm.portfolio())["MSFT"]->quantity());
+  // Sized off the 100000 left after the liquidation
+  EXPECT_EQ(-500, (*algorithm.portfolio())["AAPL"]->quantity());
+  EXPECT_EQ(500, (*algorithm.portfolio())["SPY"]->quantity());
+}
+}  // namespace algorithm
+}  // namespace quantsystem
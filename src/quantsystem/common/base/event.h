@@ -40,12 +40,12 @@ class Delegate {
   /**
    * Standard constructor.
    */
-  Delegate();
+  Delegate() {}
 
   /**
    * Standard destructor.
    */
-  virtual ~Delegate();
+  virtual ~Delegate() {}
 
   /**
    * Bind a free fucntion.
@@ -50,6 +50,8 @@ class LOCKABLE PThreadMutex {
 
   void Lock()     { CHECK_EQ(0, pthread_mutex_lock(&mutex_)); }
   void Unlock()   { CHECK_EQ(0, pthread_mutex_unlock(&mutex_)); }
+  // True if the mutex was taken, false if another thread holds it
+  bool TryLock()  { return pthread_mutex_trylock(&mutex_) == 0; }
 
  private:
   friend class PThreadCondVar;
@@ -106,6 +108,9 @@ class MsvcMutex {
   void Unlock() {
     LeaveCriticalSection(&mutex_);
   }
+  bool TryLock() {
+    return TryEnterCriticalSection(&mutex_) != 0;
+  }
 
  private:
   friend class MsvcCondVar;
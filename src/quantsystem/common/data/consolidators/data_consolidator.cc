@@ -23,7 +23,8 @@ namespace quantsystem {
 namespace data {
 namespace consolidators {
 
-DataConsolidator::DataConsolidator() {
+DataConsolidator::DataConsolidator()
+    : consolidated_(NULL) {
 }
 
 DataConsolidator::~DataConsolidator() {
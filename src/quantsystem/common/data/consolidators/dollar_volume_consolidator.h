@@ -0,0 +1,65 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_DOLLAR_VOLUME_CONSOLIDATOR_H_
+#define QUANTSYSTEM_COMMON_DOLLAR_VOLUME_CONSOLIDATOR_H_
+
+#include "quantsystem/common/data/consolidators/tick_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+/**
+ * A tick consolidator that emits a bar once the traded value, price
+ * times quantity, reaches the bar value. The tick which reaches it closes
+ * the bar.
+ *
+ * @ingroup CommonBaseData
+ */
+class DollarVolumeConsolidator : public TickConsolidator {
+ public:
+  /**
+   * Constructs the consolidator.
+   *
+   * @param bar_value The traded value of a bar
+   */
+  explicit DollarVolumeConsolidator(double bar_value);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~DollarVolumeConsolidator();
+
+ protected:
+  /**
+   * Whether the working bar is complete with the ticks aggregated so far.
+   *
+   * @param working_bar The bar we're building
+   */
+  virtual bool IsBarComplete(const TradeBar& working_bar) const;
+
+ private:
+  // The traded value of a bar
+  double bar_value_;
+};
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_DOLLAR_VOLUME_CONSOLIDATOR_H_
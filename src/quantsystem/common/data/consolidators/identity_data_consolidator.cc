@@ -31,6 +31,11 @@ IdentityDataConsolidator::~IdentityDataConsolidator() {
 void IdentityDataConsolidator::Update(BaseData* data) {
   OnDataConsolidated(data);
 }
+
+void IdentityDataConsolidator::OnDataConsolidated(BaseData* consolidated) {
+  DataConsolidated(consolidated);
+  DataConsolidator::OnDataConsolidated(consolidated);
+}
 }  // namespace consolidators
 }  // namespace data
 }  // namespace quantsystem
@@ -48,6 +48,13 @@ class IdentityDataConsolidator : public DataConsolidator {
    * Updates this consolidator with the specified data
    */
   virtual void Update(BaseData* data);
+
+ protected:
+  /**
+   * Event invocator for the DataConsolidated event.
+   * @param consolidated The consolidated data
+   */
+  virtual void OnDataConsolidated(BaseData* consolidated);
 };
 
 }  // namespace consolidators
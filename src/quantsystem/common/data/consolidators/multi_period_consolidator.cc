@@ -0,0 +1,164 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/common/data/consolidators/multi_period_consolidator.h"
+#include "quantsystem/common/data/consolidators/tradebar_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+namespace {
+const int64 kMicrosPerDay = 86400LL * 1000000;
+
+// Floor division, the start of a period before the open is negative
+int64 FloorDivide(int64 value, int64 divisor) {
+  int64 quotient = value / divisor;
+  if (value % divisor != 0 && value < 0) {
+    --quotient;
+  }
+  return quotient;
+}
+
+// Start the bar at the aligned start of its period
+void StartBar(const TradeBar& data, int64 start, TradeBar* bar) {
+  TradeBarConsolidator::StartBar(data, bar);
+  bar->set_time(DateTime::FromEpochMicroseconds(start));
+}
+}  // namespace
+
+MultiPeriodConsolidator::MultiPeriodConsolidator(
+    const vector<TimeSpan>& periods,
+    const TimeSpan& market_open)
+    : market_open_(market_open.TotalMicroseconds()) {
+  vector<int64> lengths;
+  for (int i = 0; i < periods.size(); ++i) {
+    lengths.push_back(periods[i].TotalMicroseconds());
+  }
+  std::sort(lengths.begin(), lengths.end());
+  for (int i = 0; i < lengths.size(); ++i) {
+    if (lengths[i] <= 0) {
+      LOG(ERROR) << "Period must be positive: " << lengths[i] << "us";
+      continue;
+    }
+    if (!levels_.empty()) {
+      const int64 previous = levels_.back()->period;
+      if (lengths[i] == previous) {
+        continue;
+      }
+      if (lengths[i] % previous != 0) {
+        LOG(ERROR) << "Period of " << lengths[i] << "us is not a multiple" <<
+            " of " << previous << "us, skipped";
+        continue;
+      }
+    }
+    levels_.push_back(new Level(lengths[i]));
+  }
+}
+
+MultiPeriodConsolidator::~MultiPeriodConsolidator() {
+  STLDeleteElements(&levels_);
+}
+
+int MultiPeriodConsolidator::GetPeriodIndex(const TimeSpan& period) const {
+  const int64 length = period.TotalMicroseconds();
+  for (int i = 0; i < levels_.size(); ++i) {
+    if (levels_[i]->period == length) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const TradeBar* MultiPeriodConsolidator::consolidated(int index) const {
+  const Level* level = levels_[index];
+  return level->emitted ? &level->bars[level->working ^ 1] : NULL;
+}
+
+void MultiPeriodConsolidator::Update(BaseData* data) {
+  // The data stays owned by the caller
+  const TradeBar* trade_data = dynamic_cast<const TradeBar*>(data);
+  if (trade_data == NULL) {
+    LOG(ERROR) << "Input are not TradeBar instance?";
+    return;
+  }
+  if (levels_.empty()) {
+    return;
+  }
+  const int64 time = trade_data->time().ToEpochMicroseconds();
+  Level* finest = levels_[0];
+  if (finest->has_working_bar && time >= finest->end) {
+    Close(0, time);
+  }
+  TradeBar* bar = &finest->bars[finest->working];
+  if (finest->has_working_bar) {
+    TradeBarConsolidator::AggregateTradeBar(*trade_data, bar);
+  } else {
+    const int64 start = AlignedStart(time, finest->period);
+    StartBar(*trade_data, start, bar);
+    finest->end = start + finest->period;
+    finest->has_working_bar = true;
+  }
+}
+
+int64 MultiPeriodConsolidator::AlignedStart(int64 time,
+                                            int64 period) const {
+  const int64 anchor = FloorDivide(time, kMicrosPerDay) * kMicrosPerDay +
+      market_open_;
+  return anchor + FloorDivide(time - anchor, period) * period;
+}
+
+void MultiPeriodConsolidator::Close(int index, int64 time) {
+  Level* level = levels_[index];
+  TradeBar* finished = &level->bars[level->working];
+  level->working ^= 1;
+  level->has_working_bar = false;
+  level->emitted = true;
+  // Fold the finished bar into the next period before it can close
+  if (index + 1 < levels_.size()) {
+    Level* next = levels_[index + 1];
+    TradeBar* bar = &next->bars[next->working];
+    if (next->has_working_bar) {
+      TradeBarConsolidator::AggregateTradeBar(*finished, bar);
+    } else {
+      const int64 start = AlignedStart(finished->time().ToEpochMicroseconds(),
+                                       next->period);
+      StartBar(*finished, start, bar);
+      next->end = start + next->period;
+      next->has_working_bar = true;
+    }
+  }
+  OnDataConsolidated(index, finished);
+  if (index + 1 < levels_.size() && time >= levels_[index + 1]->end) {
+    Close(index + 1, time);
+  }
+}
+
+void MultiPeriodConsolidator::OnDataConsolidated(int index,
+                                                 TradeBar* consolidated) {
+  levels_[index]->handler(consolidated);
+  DataConsolidated(consolidated);
+  DataConsolidator::OnDataConsolidated(consolidated);
+}
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
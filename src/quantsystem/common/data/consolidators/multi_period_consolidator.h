@@ -0,0 +1,158 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_MULTI_PERIOD_CONSOLIDATOR_H_
+#define QUANTSYSTEM_COMMON_MULTI_PERIOD_CONSOLIDATOR_H_
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/time/time_span.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/data/base_data.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/data/consolidators/data_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+using market::TradeBar;
+namespace consolidators {
+/**
+ * A data consolidator that makes bars of several periods, e.g. 1, 5, 15
+ * and 60 minutes, from one stream of smaller bars in a single pass.
+ *
+ * The bars are aligned to the market open of each day: a 15 minute
+ * bar of a market opening at 9:30 covers 9:30 to 9:45. Every period
+ * must be a multiple of the previous one, so only the bar of the
+ * shortest period aggregates the input, and a finished bar is folded
+ * into the bar of the next period. An update costs O(1) whatever the
+ * number of periods, plus one fold per finished bar.
+ *
+ * A bar is emitted by the first data at or after its end, finest period
+ * first, through the DataConsolidated event of this consolidator and
+ * the event of its period. The bar time is the start of its period.
+ * Like TradeBarConsolidator the bars are preallocated and an emitted
+ * bar is valid until the next bar of the same period is emitted.
+ *
+ * @ingroup CommonBaseData
+ */
+class MultiPeriodConsolidator : public DataConsolidator {
+ public:
+  /**
+   * Constructs a consolidator for the periods, aligned to the market open.
+   *
+   * @param periods The periods of the bars, each a multiple of the
+   * previous one once sorted
+   * @param market_open The time of day the market opens
+   */
+  MultiPeriodConsolidator(const vector<TimeSpan>& periods,
+                          const TimeSpan& market_open);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~MultiPeriodConsolidator();
+
+  /**
+   * Updates this consolidator with the specified data. This method is
+   * responsible for raising the DataConsolidated events.
+   *
+   * @param data The new data for the consolidator
+   */
+  virtual void Update(BaseData* data);
+
+  /**
+   * Get the number of periods, shortest first.
+   */
+  int period_count() const { return static_cast<int>(levels_.size()); }
+
+  /**
+   * Get the index of the period, -1 if it is not consolidated.
+   */
+  int GetPeriodIndex(const TimeSpan& period) const;
+
+  /**
+   * Get the event that fires when a bar of the period is emitted.
+   *
+   * @param index Index of the period, shortest first
+   */
+  DataConsolidatedHandler* PeriodConsolidated(int index) {
+    return &levels_[index]->handler;
+  }
+
+  /**
+   * Get the most recently emitted bar of the period, NULL if none.
+   *
+   * @param index Index of the period, shortest first
+   */
+  const TradeBar* consolidated(int index) const;
+
+ protected:
+  /**
+   * Event invocator for the DataConsolidated events.
+   *
+   * @param index Index of the period of the bar
+   * @param consolidated The newly consolidated bar
+   */
+  virtual void OnDataConsolidated(int index, TradeBar* consolidated);
+
+ private:
+  /**
+   * The bars of one period.
+   */
+  class Level {
+   public:
+    int64 period;  // Length of the period in microseconds
+    int64 end;  // End of the working bar in microseconds
+    bool has_working_bar;  // Whether the working bar holds data
+    int working;  // Index of the working bar, the other one was emitted
+    bool emitted;  // Whether a bar of this period was emitted
+    TradeBar bars[2];
+    DataConsolidatedHandler handler;
+    explicit Level(int64 in_period)
+        : period(in_period),
+          end(0),
+          has_working_bar(false),
+          working(0),
+          emitted(false) {
+    }
+  };
+  // The periods, shortest first
+  vector<Level*> levels_;
+  // The time of day the bars are aligned to in microseconds
+  int64 market_open_;
+
+  /**
+   * Start of the period which contains the time.
+   */
+  int64 AlignedStart(int64 time, int64 period) const;
+
+  /**
+   * Emit the working bar of the level and fold it into the next level.
+   */
+  void Close(int index, int64 time);
+
+  DISALLOW_COPY_AND_ASSIGN(MultiPeriodConsolidator);
+};
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_MULTI_PERIOD_CONSOLIDATOR_H_
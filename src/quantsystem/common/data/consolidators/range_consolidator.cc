@@ -0,0 +1,43 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+
+#include "quantsystem/common/data/consolidators/range_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+RangeConsolidator::RangeConsolidator(double range)
+    : range_(range) {
+  if (range <= 0) {
+    LOG(ERROR) << "Range must be positive: " << range;
+  }
+}
+
+RangeConsolidator::~RangeConsolidator() {
+}
+
+bool RangeConsolidator::IsBarComplete(const TradeBar& working_bar) const {
+  return working_bar.high() - working_bar.low() >= range_;
+}
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
@@ -0,0 +1,84 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+
+#include "quantsystem/common/data/consolidators/renko_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+RenkoConsolidator::RenkoConsolidator(double brick_size)
+    : brick_size_(brick_size),
+      has_reference_(false),
+      reference_(0),
+      pending_volume_(0),
+      start_(DateTime::DateTimeInvalid()) {
+  if (brick_size <= 0) {
+    LOG(ERROR) << "Brick size must be positive: " << brick_size;
+    brick_size_ = 1;
+  }
+}
+
+RenkoConsolidator::~RenkoConsolidator() {
+}
+
+void RenkoConsolidator::OnTick(const Tick& tick) {
+  const double price = tick.value();
+  if (!has_reference_) {
+    has_reference_ = true;
+    reference_ = price;
+    start_ = tick.time();
+    pending_volume_ = tick.quantity();
+    return;
+  }
+  if (!start_.is_valid()) {
+    start_ = tick.time();
+  }
+  pending_volume_ += tick.quantity();
+  while (price >= reference_ + brick_size_) {
+    EmitBrick(tick, reference_ + brick_size_);
+  }
+  while (price <= reference_ - brick_size_) {
+    EmitBrick(tick, reference_ - brick_size_);
+  }
+}
+
+void RenkoConsolidator::EmitBrick(const Tick& tick, double close) {
+  TradeBar* brick = mutable_working_bar();
+  brick->set_time(start_);
+  if (brick->symbol() != tick.symbol()) {
+    brick->set_symbol(tick.symbol());
+  }
+  brick->set_data_type(MarketDataType::kTradeBar);
+  brick->set_open(reference_);
+  brick->set_close(close);
+  brick->set_high(close > reference_ ? close : reference_);
+  brick->set_low(close < reference_ ? close : reference_);
+  brick->set_volume(pending_volume_);
+  reference_ = close;
+  pending_volume_ = 0;
+  // The next brick starts with this tick
+  start_ = tick.time();
+  Emit();
+}
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
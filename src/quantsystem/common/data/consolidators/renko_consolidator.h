@@ -0,0 +1,91 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_RENKO_CONSOLIDATOR_H_
+#define QUANTSYSTEM_COMMON_RENKO_CONSOLIDATOR_H_
+
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/data/consolidators/tick_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+/**
+ * A tick consolidator that emits Renko bricks: a brick of the brick size
+ * is emitted every time the price moves a brick size above or below the
+ * close of the previous brick, several bricks for a large move.
+ *
+ * The first tick sets the close of a virtual brick the first real brick
+ * starts from. A brick opens at the previous close and closes a brick
+ * size away, its high and low are its open and close, and its volume
+ * is the traded quantity since the previous brick.
+ *
+ * @ingroup CommonBaseData
+ */
+class RenkoConsolidator : public TickConsolidator {
+ public:
+  /**
+   * Constructs the consolidator.
+   *
+   * @param brick_size The price move of a brick
+   */
+  explicit RenkoConsolidator(double brick_size);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~RenkoConsolidator();
+
+ protected:
+  /**
+   * Emits the bricks completed by the tick.
+   *
+   * @param tick The new tick
+   */
+  virtual void OnTick(const Tick& tick);
+
+  /**
+   * Bricks are emitted from OnTick, the aggregated bar never completes.
+   */
+  virtual bool IsBarComplete(const TradeBar& working_bar) const {
+    return false;
+  }
+
+ private:
+  // The price move of a brick
+  double brick_size_;
+  // Whether the first tick set the reference close
+  bool has_reference_;
+  // Close of the previous brick
+  double reference_;
+  // Quantity traded since the previous brick
+  int64 pending_volume_;
+  // Time of the first tick since the previous brick
+  DateTime start_;
+
+  /**
+   * Emit one brick from the reference close to the close.
+   */
+  void EmitBrick(const Tick& tick, double close);
+};
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_RENKO_CONSOLIDATOR_H_
@@ -32,8 +32,8 @@ SequentialConsolidator::SequentialConsolidator(
                                &DataConsolidator::Update>(second);
   // wire up the second one's events to also fire this
   // consolidator's event so consumers can attach
-  second_->DataConsolidated.Bind<DataConsolidator,
-                                &DataConsolidator::Update>(this);
+  second_->DataConsolidated.Bind<SequentialConsolidator,
+      &SequentialConsolidator::OnDataConsolidated>(this);
 }
 
 SequentialConsolidator::~SequentialConsolidator() {
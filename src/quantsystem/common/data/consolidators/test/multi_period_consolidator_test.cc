@@ -0,0 +1,140 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <time.h>
+#include <algorithm>
+#include <map>
+using std::map;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/consolidators/multi_period_consolidator.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+namespace {
+const time_t kMidnight = 1420070400;  // 2015-01-01 00:00:00 UTC
+const int kOpen = (9 * 60 + 30) * 60;  // 9:30 in seconds
+
+// Collects a copy of the consolidated bars of one period
+class BarCollector {
+ public:
+  vector<TradeBar*> bars;
+  ~BarCollector() {
+    for (int i = 0; i < bars.size(); ++i) {
+      delete bars[i];
+    }
+  }
+  void OnBar(BaseData* data) {
+    bars.push_back(new TradeBar(*static_cast<TradeBar*>(data)));
+  }
+};
+
+double PriceAt(int second) {
+  return 100 + (second % 97) * 0.25 - (second % 13);
+}
+}  // namespace
+
+TEST(MultiPeriodConsolidator, TestBarsMatchAlignedBuckets) {
+  const int kMinutes[] = {15, 1, 60, 5};
+  vector<TimeSpan> periods;
+  for (int i = 0; i < 4; ++i) {
+    periods.push_back(TimeSpan::FromMinutes(kMinutes[i]));
+  }
+  MultiPeriodConsolidator consolidator(periods, TimeSpan::FromSeconds(kOpen));
+  ASSERT_EQ(4, consolidator.period_count());
+  BarCollector collectors[4];
+  for (int i = 0; i < 4; ++i) {
+    consolidator.PeriodConsolidated(i)->Bind<BarCollector,
+                                             &BarCollector::OnBar>(
+        &collectors[i]);
+  }
+  EXPECT_EQ(2, consolidator.GetPeriodIndex(TimeSpan::FromMinutes(15)));
+  // Second bars from 9:29:30 to 11:45:00, with a gap of 7 minutes
+  const int first = kOpen - 30, last = kOpen + 135 * 60;
+  vector<int> seconds;
+  for (int s = first; s <= last; ++s) {
+    if (s < kOpen + 20 * 60 || s >= kOpen + 27 * 60) {
+      seconds.push_back(s);
+    }
+  }
+  for (int i = 0; i < seconds.size(); ++i) {
+    double price = PriceAt(seconds[i]);
+    TradeBar bar(DateTime(kMidnight + seconds[i]), "SPY", price, price + 1,
+                 price - 1, price, 10);
+    consolidator.Update(&bar);
+  }
+  const int kSorted[] = {1, 5, 15, 60};
+  for (int p = 0; p < 4; ++p) {
+    const int period = kSorted[p] * 60;
+    // Expected bars by aligned start, except the bar still in progress
+    map<int, TradeBar*> expected;
+    for (int i = 0; i < seconds.size(); ++i) {
+      const int s = seconds[i];
+      int start = kOpen + ((s - kOpen) / period) * period;
+      if (s < kOpen && (s - kOpen) % period != 0) {
+        start -= period;
+      }
+      double price = PriceAt(s);
+      if (expected.count(start) == 0) {
+        expected[start] = new TradeBar(DateTime(kMidnight + start), "SPY",
+                                       price, price + 1, price - 1, price,
+                                       0);
+      }
+      TradeBar* bar = expected[start];
+      bar->set_high(std::max(bar->high(), price + 1));
+      bar->set_low(std::min(bar->low(), price - 1));
+      bar->set_close(price);
+      bar->set_volume(bar->volume() + 10);
+    }
+    ASSERT_EQ(expected.size() - 1, collectors[p].bars.size()) << period;
+    int i = 0;
+    for (map<int, TradeBar*>::iterator it = expected.begin();
+         it != expected.end(); ++it, ++i) {
+      if (i < collectors[p].bars.size()) {
+        const TradeBar& actual = *collectors[p].bars[i];
+        EXPECT_EQ(it->second->time().ToString(), actual.time().ToString());
+        EXPECT_EQ(it->second->open(), actual.open());
+        EXPECT_EQ(it->second->high(), actual.high());
+        EXPECT_EQ(it->second->low(), actual.low());
+        EXPECT_EQ(it->second->close(), actual.close());
+        EXPECT_EQ(it->second->volume(), actual.volume());
+      }
+      delete it->second;
+    }
+  }
+  EXPECT_EQ(collectors[3].bars.back()->time().ToString(),
+            consolidator.consolidated(3)->time().ToString());
+}
+
+TEST(MultiPeriodConsolidator, TestSkipsPeriodsWhichAreNotMultiples) {
+  vector<TimeSpan> periods;
+  periods.push_back(TimeSpan::FromMinutes(2));
+  periods.push_back(TimeSpan::FromMinutes(3));
+  periods.push_back(TimeSpan::FromMinutes(10));
+  MultiPeriodConsolidator consolidator(periods, TimeSpan::FromSeconds(0));
+  EXPECT_EQ(2, consolidator.period_count());
+  EXPECT_EQ(-1, consolidator.GetPeriodIndex(TimeSpan::FromMinutes(3)));
+  EXPECT_EQ(NULL, consolidator.consolidated(0));
+}
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
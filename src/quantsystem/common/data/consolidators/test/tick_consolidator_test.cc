@@ -0,0 +1,145 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <time.h>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/consolidators/dollar_volume_consolidator.h"
+#include "quantsystem/common/data/consolidators/range_consolidator.h"
+#include "quantsystem/common/data/consolidators/renko_consolidator.h"
+#include "quantsystem/common/data/consolidators/tick_count_consolidator.h"
+#include "quantsystem/common/data/consolidators/volume_consolidator.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+namespace {
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+
+// Collects a copy of every consolidated bar
+class BarCollector {
+ public:
+  vector<TradeBar*> bars;
+  ~BarCollector() {
+    for (int i = 0; i < bars.size(); ++i) {
+      delete bars[i];
+    }
+  }
+  void OnBar(BaseData* data) {
+    bars.push_back(new TradeBar(*static_cast<TradeBar*>(data)));
+  }
+};
+
+// Feed trade ticks of the prices and quantities, one second apart
+void Feed(TickConsolidator* consolidator, const double* prices,
+          const int* quantities, int count, BarCollector* collector) {
+  consolidator->DataConsolidated.Bind<BarCollector, &BarCollector::OnBar>(
+      collector);
+  for (int i = 0; i < count; ++i) {
+    Tick tick;
+    tick.set_time(DateTime(kStart + i));
+    tick.set_symbol("SPY");
+    tick.set_value(prices[i]);
+    tick.set_quantity(quantities[i]);
+    consolidator->Update(&tick);
+  }
+}
+
+void ExpectBar(const TradeBar& bar, int second, double open, double high,
+               double low, double close, int64 volume) {
+  EXPECT_EQ(DateTime(kStart + second).ToString(), bar.time().ToString());
+  EXPECT_EQ("SPY", bar.symbol());
+  EXPECT_EQ(open, bar.open());
+  EXPECT_EQ(high, bar.high());
+  EXPECT_EQ(low, bar.low());
+  EXPECT_EQ(close, bar.close());
+  EXPECT_EQ(volume, bar.volume());
+}
+}  // namespace
+
+TEST(TickConsolidator, TestTickCountVolumeAndDollarBars) {
+  const double prices[] = {10, 12, 9, 11, 10, 13, 12};
+  const int quantities[] = {30, 50, 40, 10, 100, 20, 5};
+  TickCountConsolidator count(3);
+  BarCollector count_bars;
+  Feed(&count, prices, quantities, 7, &count_bars);
+  ASSERT_EQ(2, count_bars.bars.size());
+  ExpectBar(*count_bars.bars[0], 0, 10, 12, 9, 9, 120);
+  ExpectBar(*count_bars.bars[1], 3, 11, 13, 10, 13, 130);
+  ASSERT_TRUE(count.working_bar() != NULL);
+  EXPECT_EQ(1, count.ticks());
+
+  VolumeConsolidator volume(100);
+  BarCollector volume_bars;
+  Feed(&volume, prices, quantities, 7, &volume_bars);
+  ASSERT_EQ(2, volume_bars.bars.size());
+  ExpectBar(*volume_bars.bars[0], 0, 10, 12, 9, 9, 120);
+  ExpectBar(*volume_bars.bars[1], 3, 11, 11, 10, 10, 110);
+
+  // 300 + 600 + 360 = 1260, then 110 + 1000 = 1110
+  DollarVolumeConsolidator dollar(1000);
+  BarCollector dollar_bars;
+  Feed(&dollar, prices, quantities, 7, &dollar_bars);
+  ASSERT_EQ(2, dollar_bars.bars.size());
+  ExpectBar(*dollar_bars.bars[1], 3, 11, 11, 10, 10, 110);
+  EXPECT_EQ(260 + 60, dollar.dollar_volume());
+}
+
+TEST(TickConsolidator, TestRangeBars) {
+  const double prices[] = {10, 10.5, 9.75, 10.75, 11, 11.5, 12, 12.25};
+  const int quantities[] = {1, 1, 1, 1, 1, 1, 1, 1};
+  RangeConsolidator range(1);
+  BarCollector bars;
+  Feed(&range, prices, quantities, 8, &bars);
+  ASSERT_EQ(2, bars.bars.size());
+  ExpectBar(*bars.bars[0], 0, 10, 10.75, 9.75, 10.75, 4);
+  ExpectBar(*bars.bars[1], 4, 11, 12, 11, 12, 3);
+}
+
+TEST(TickConsolidator, TestRenkoBricks) {
+  const double prices[] = {10, 10.5, 11.25, 13.5, 12.5, 11.75, 12};
+  const int quantities[] = {1, 2, 3, 4, 5, 6, 7};
+  RenkoConsolidator renko(1);
+  BarCollector bricks;
+  Feed(&renko, prices, quantities, 7, &bricks);
+  ASSERT_EQ(4, bricks.bars.size());
+  ExpectBar(*bricks.bars[0], 0, 10, 11, 10, 11, 6);
+  // A move of more than two bricks emits two bricks at the same tick
+  ExpectBar(*bricks.bars[1], 2, 11, 12, 11, 12, 4);
+  ExpectBar(*bricks.bars[2], 3, 12, 13, 12, 13, 0);
+  ExpectBar(*bricks.bars[3], 3, 13, 13, 12, 12, 11);
+  EXPECT_EQ(NULL, renko.working_bar());
+}
+
+TEST(TickConsolidator, TestQuoteTickPriceIsTheMid) {
+  Tick quote(DateTime(kStart), "EURUSD", 1.1000, 1.1002);
+  EXPECT_DOUBLE_EQ(1.1001, quote.value());
+  TickCountConsolidator count(1);
+  BarCollector bars;
+  count.DataConsolidated.Bind<BarCollector, &BarCollector::OnBar>(&bars);
+  count.Update(&quote);
+  ASSERT_EQ(1, bars.bars.size());
+  EXPECT_DOUBLE_EQ(1.1001, bars.bars[0]->close());
+  EXPECT_EQ(0, bars.bars[0]->volume());
+}
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
@@ -0,0 +1,138 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <time.h>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/consolidators/tradebar_consolidator.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+namespace {
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+
+// Collects a copy of every consolidated bar and the pointer it came in
+class BarCollector {
+ public:
+  vector<TradeBar*> bars;
+  vector<BaseData*> emitted;
+  ~BarCollector() {
+    for (int i = 0; i < bars.size(); ++i) {
+      delete bars[i];
+    }
+  }
+  void OnBar(BaseData* data) {
+    emitted.push_back(data);
+    bars.push_back(new TradeBar(*static_cast<TradeBar*>(data)));
+  }
+};
+}  // namespace
+
+TEST(TradeBarConsolidator, TestAggregatesSecondsIntoMinutes) {
+  TradeBarConsolidator consolidator(TimeSpan::FromMinutes(1));
+  BarCollector collector;
+  consolidator.DataConsolidated.Bind<BarCollector, &BarCollector::OnBar>(
+      &collector);
+  for (int i = 0; i <= 120; ++i) {
+    double price = 100 + (i % 60) * 0.5 - (i % 7);
+    TradeBar bar(DateTime(kStart + i), "SPY", price, price + 1, price - 1,
+                 price, 10);
+    consolidator.Update(&bar);
+  }
+  ASSERT_EQ(2, collector.bars.size());
+  const TradeBar& first = *collector.bars[0];
+  EXPECT_EQ("SPY", first.symbol());
+  EXPECT_EQ(DateTime(kStart).ToString(), first.time().ToString());
+  EXPECT_EQ(100, first.open());
+  EXPECT_EQ(610, first.volume());
+  double high = 0, low = 1e9;
+  for (int i = 0; i <= 60; ++i) {
+    double price = 100 + (i % 60) * 0.5 - (i % 7);
+    high = price + 1 > high ? price + 1 : high;
+    low = price - 1 < low ? price - 1 : low;
+  }
+  EXPECT_EQ(high, first.high());
+  EXPECT_EQ(low, first.low());
+  EXPECT_EQ(96, first.close());  // Bar 60 closes the first minute
+  // The second minute starts with the bar following the emit
+  EXPECT_EQ(DateTime(kStart + 61).ToString(),
+            collector.bars[1]->time().ToString());
+  EXPECT_EQ(600, collector.bars[1]->volume());
+  EXPECT_EQ(NULL, consolidator.working_bar());
+}
+
+TEST(TradeBarConsolidator, TestEmittedBarStaysValidUntilNextEmit) {
+  TradeBarConsolidator consolidator(2);
+  BarCollector collector;
+  consolidator.DataConsolidated.Bind<BarCollector, &BarCollector::OnBar>(
+      &collector);
+  for (int i = 0; i < 7; ++i) {
+    TradeBar bar(DateTime(kStart + i), "SPY", i, i, i, i, 1);
+    consolidator.Update(&bar);
+    if (!collector.emitted.empty()) {
+      // Aggregating the next bar does not touch the emitted one
+      const TradeBar* last =
+          static_cast<TradeBar*>(consolidator.consolidated());
+      EXPECT_EQ(collector.emitted.back(), consolidator.consolidated());
+      EXPECT_EQ(collector.bars.back()->open(), last->open());
+      EXPECT_EQ(collector.bars.back()->close(), last->close());
+    }
+  }
+  ASSERT_EQ(3, collector.emitted.size());
+  // Two buffers alternate, nothing is allocated per period
+  EXPECT_NE(collector.emitted[0], collector.emitted[1]);
+  EXPECT_EQ(collector.emitted[0], collector.emitted[2]);
+  EXPECT_EQ(4, collector.bars[2]->open());
+  EXPECT_EQ(5, collector.bars[2]->close());
+  ASSERT_TRUE(consolidator.working_bar() != NULL);
+  EXPECT_EQ(6, consolidator.working_bar()->open());
+}
+
+TEST(TradeBarConsolidator, TestCountOrPeriodEmits) {
+  TradeBarConsolidator consolidator(3, TimeSpan::FromSeconds(10));
+  BarCollector collector;
+  consolidator.DataConsolidated.Bind<BarCollector, &BarCollector::OnBar>(
+      &collector);
+  EXPECT_EQ(NULL, consolidator.working_bar());
+  // Three bars fill the count, then a late bar closes the period
+  const int seconds[] = {0, 1, 2, 3, 15};
+  for (int i = 0; i < 5; ++i) {
+    TradeBar bar(DateTime(kStart + seconds[i]), "SPY", i, i + 1, i - 1, i,
+                 1);
+    consolidator.Update(&bar);
+  }
+  ASSERT_EQ(2, collector.bars.size());
+  EXPECT_EQ(DateTime(kStart).ToString(), collector.bars[0]->time().ToString());
+  EXPECT_EQ(0, collector.bars[0]->open());
+  EXPECT_EQ(2, collector.bars[0]->close());
+  EXPECT_EQ(3, collector.bars[0]->volume());
+  EXPECT_EQ(DateTime(kStart + 3).ToString(),
+            collector.bars[1]->time().ToString());
+  EXPECT_EQ(3, collector.bars[1]->open());
+  EXPECT_EQ(5, collector.bars[1]->high());
+  EXPECT_EQ(4, collector.bars[1]->close());
+  EXPECT_EQ(2, collector.bars[1]->volume());
+  EXPECT_EQ(NULL, consolidator.working_bar());
+}
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
@@ -0,0 +1,97 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+
+#include "quantsystem/common/data/consolidators/tick_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+TickConsolidator::TickConsolidator()
+    : working_(0),
+      has_working_bar_(false),
+      ticks_(0),
+      dollar_volume_(0) {
+}
+
+TickConsolidator::~TickConsolidator() {
+}
+
+void TickConsolidator::Update(BaseData* data) {
+  // The tick stays owned by the caller
+  const Tick* tick = dynamic_cast<const Tick*>(data);
+  if (tick == NULL) {
+    LOG(ERROR) << "Input are not Tick instance?";
+    return;
+  }
+  OnTick(*tick);
+}
+
+void TickConsolidator::StartBar(const Tick& tick, TradeBar* bar) {
+  const double price = tick.value();
+  bar->set_time(tick.time());
+  // Same symbol for every bar, skip the string copy
+  if (bar->symbol() != tick.symbol()) {
+    bar->set_symbol(tick.symbol());
+  }
+  bar->set_data_type(MarketDataType::kTradeBar);
+  bar->set_open(price);
+  bar->set_high(price);
+  bar->set_low(price);
+  bar->set_close(price);
+  bar->set_volume(tick.quantity());
+}
+
+void TickConsolidator::OnTick(const Tick& tick) {
+  Aggregate(tick);
+  if (IsBarComplete(bars_[working_])) {
+    Emit();
+  }
+}
+
+void TickConsolidator::Aggregate(const Tick& tick) {
+  TradeBar* bar = &bars_[working_];
+  if (has_working_bar_) {
+    AggregateTick(tick, bar);
+  } else {
+    StartBar(tick, bar);
+    has_working_bar_ = true;
+  }
+  ++ticks_;
+  dollar_volume_ += tick.value() * tick.quantity();
+}
+
+void TickConsolidator::Emit() {
+  TradeBar* finished = &bars_[working_];
+  working_ ^= 1;
+  has_working_bar_ = false;
+  ticks_ = 0;
+  dollar_volume_ = 0;
+  OnDataConsolidated(finished);
+}
+
+void TickConsolidator::OnDataConsolidated(BaseData* consolidated) {
+  DataConsolidated(consolidated);
+  DataConsolidator::OnDataConsolidated(consolidated);
+}
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
@@ -0,0 +1,177 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_TICK_CONSOLIDATOR_H_
+#define QUANTSYSTEM_COMMON_TICK_CONSOLIDATOR_H_
+
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/data/base_data.h"
+#include "quantsystem/common/data/market/tick.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/data/consolidators/data_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+using market::Tick;
+using market::TradeBar;
+namespace consolidators {
+/**
+ * Base class of the consolidators which make bars directly from ticks
+ * on a trigger other than time: tick count, volume, dollar volume,
+ * price range or Renko bricks.
+ *
+ * The aggregation core is shared: a tick is folded into a preallocated
+ * working bar (open, high, low, close, volume) while the tick count and
+ * the traded dollar volume of the bar are tracked, and the derived
+ * consolidator only decides when the bar is complete. Like
+ * TradeBarConsolidator two bars swap roles at every emit, so no update
+ * allocates and an emitted bar is valid until the next emit.
+ *
+ * The price of a tick is its value: the last trade, or the mid price
+ * of a quote tick. Quote ticks have no quantity, so volume and dollar
+ * bars only apply to trade ticks.
+ *
+ * @ingroup CommonBaseData
+ */
+class TickConsolidator : public DataConsolidator {
+ public:
+  /**
+   * Standard destructor.
+   */
+  virtual ~TickConsolidator();
+
+  /**
+   * Updates this consolidator with the specified tick. This method is
+   * responsible for raising the DataConsolidated event.
+   *
+   * @param data The new tick for the consolidator
+   */
+  virtual void Update(BaseData* data);
+
+  /**
+   * Gets the bar being aggregated, NULL if no tick arrived since the
+   * last emit.
+   */
+  const TradeBar* working_bar() const {
+    return has_working_bar_ ? &bars_[working_] : NULL;
+  }
+
+  /**
+   * Gets the number of ticks in the working bar.
+   */
+  int ticks() const { return ticks_; }
+
+  /**
+   * Gets the traded value, price times quantity, of the working bar.
+   */
+  double dollar_volume() const { return dollar_volume_; }
+
+  /**
+   * Overwrite the bar with the first tick of a new bar.
+   *
+   * @param tick The tick
+   * @param[out] bar The bar to start
+   */
+  static void StartBar(const Tick& tick, TradeBar* bar);
+
+  /**
+   * Aggregate a tick into a started bar.
+   *
+   * @param tick The tick
+   * @param[out] bar The bar we're building
+   */
+  static void AggregateTick(const Tick& tick, TradeBar* bar) {
+    const double price = tick.value();
+    bar->set_close(price);
+    bar->set_volume(bar->volume() + tick.quantity());
+    if (price < bar->low()) {
+      bar->set_low(price);
+    }
+    if (price > bar->high()) {
+      bar->set_high(price);
+    }
+  }
+
+ protected:
+  /**
+   * Standard constructor.
+   */
+  TickConsolidator();
+
+  /**
+   * Consolidates a tick: aggregates it into the working bar and emits
+   * the bar once it is complete.
+   *
+   * @param tick The new tick
+   */
+  virtual void OnTick(const Tick& tick);
+
+  /**
+   * Whether the working bar is complete with the ticks aggregated so far.
+   *
+   * @param working_bar The bar we're building
+   */
+  virtual bool IsBarComplete(const TradeBar& working_bar) const = 0;
+
+  /**
+   * Aggregates the tick into the working bar, starting a new bar if
+   * there is none.
+   */
+  void Aggregate(const Tick& tick);
+
+  /**
+   * Gets the working bar to be filled directly, marked as started.
+   */
+  TradeBar* mutable_working_bar() {
+    has_working_bar_ = true;
+    return &bars_[working_];
+  }
+
+  /**
+   * Emits the working bar and makes the other bar the working one.
+   */
+  void Emit();
+
+  /**
+   * Event invocator for the DataConsolidated event.
+   *
+   * @param consolidated The newly consolidated bar
+   */
+  virtual void OnDataConsolidated(BaseData* consolidated);
+
+ private:
+  // The working bar and the last emitted bar, swapped at every emit
+  TradeBar bars_[2];
+  // Index of the working bar in bars_
+  int working_;
+  // Whether the working bar holds ticks
+  bool has_working_bar_;
+  // The number of ticks in the working bar
+  int ticks_;
+  // Price times quantity of the ticks in the working bar
+  double dollar_volume_;
+
+  DISALLOW_COPY_AND_ASSIGN(TickConsolidator);
+};
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_TICK_CONSOLIDATOR_H_
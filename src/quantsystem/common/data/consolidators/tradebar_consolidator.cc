@@ -27,6 +27,8 @@ TradeBarConsolidator::TradeBarConsolidator(
     const TimeSpan& period)
     : max_count_(-1),
       current_count_(0),
+      working_(0),
+      has_working_bar_(false),
       last_emit_(DateTime::DateTimeInvalid()) {
   period_ = period;
 }
@@ -35,6 +37,8 @@ TradeBarConsolidator::TradeBarConsolidator(
     int max_count)
     : period_(TimeSpan::TimeSpanInvalid()),
       current_count_(0),
+      working_(0),
+      has_working_bar_(false),
       last_emit_(DateTime::DateTimeInvalid()) {
   max_count_ = max_count;
 }
@@ -43,6 +47,8 @@ TradeBarConsolidator::TradeBarConsolidator(
     int max_count,
     const TimeSpan& period)
     : current_count_(0),
+      working_(0),
+      has_working_bar_(false),
       last_emit_(DateTime::DateTimeInvalid()) {
   max_count_ = max_count;
   period_ = period;
@@ -52,14 +58,19 @@ TradeBarConsolidator::~TradeBarConsolidator() {
 }
 
 void TradeBarConsolidator::Update(BaseData* data) {
-  scoped_ptr<const TradeBar> trade_data;
-  trade_data.reset(
-      dynamic_cast<const TradeBar*>(data));
-  if (!trade_data.get()) {
+  // The data stays owned by the caller
+  const TradeBar* trade_data = dynamic_cast<const TradeBar*>(data);
+  if (trade_data == NULL) {
     LOG(FATAL) << "Input are not TradeBar instance?";
     return;
   }
-  AggregateBar(*trade_data, working_bar_.get());
+  TradeBar* working_bar = &bars_[working_];
+  if (!has_working_bar_) {
+    StartBar(*trade_data, working_bar);
+    has_working_bar_ = true;
+  } else {
+    AggregateBar(*trade_data, working_bar);
+  }
   bool fire_data_consolidated = false;
   if (max_count_ >= 0) {
     current_count_++;
@@ -80,8 +91,10 @@ void TradeBarConsolidator::Update(BaseData* data) {
     if (period_.is_valid()) {
       last_emit_ = trade_data->time();
     }
-    OnDataConsolidated(working_bar_.get());
-    working_bar_.reset(NULL);
+    // The next period goes to the other bar, the emitted one stays valid
+    working_ ^= 1;
+    has_working_bar_ = false;
+    OnDataConsolidated(working_bar);
   }
 }
 
@@ -107,17 +120,32 @@ TradeBarConsolidator* TradeBarConsolidator::FromResolution(
 
 void TradeBarConsolidator::AggregateBar(const TradeBar& data,
                                         TradeBar* working_bar) {
-  if (working_bar == NULL) {
-    working_bar = new TradeBar(data);
-  } else {
-    working_bar->set_close(data.close());
-    working_bar->set_volume(data.volume());
-    if (data.low() < working_bar->low()) {
-      working_bar->set_low(data.low());
-    }
-    if (data.high() > working_bar->high()) {
-      working_bar->set_high(data.high());
-    }
+  AggregateTradeBar(data, working_bar);
+}
+
+void TradeBarConsolidator::StartBar(const TradeBar& data, TradeBar* bar) {
+  bar->set_time(data.time());
+  // Same symbol for every period, skip the string copy
+  if (bar->symbol() != data.symbol()) {
+    bar->set_symbol(data.symbol());
+  }
+  bar->set_data_type(data.data_type());
+  bar->set_open(data.open());
+  bar->set_high(data.high());
+  bar->set_low(data.low());
+  bar->set_close(data.close());
+  bar->set_volume(data.volume());
+}
+
+void TradeBarConsolidator::AggregateTradeBar(const TradeBar& data,
+                                             TradeBar* bar) {
+  bar->set_close(data.close());
+  bar->set_volume(bar->volume() + data.volume());
+  if (data.low() < bar->low()) {
+    bar->set_low(data.low());
+  }
+  if (data.high() > bar->high()) {
+    bar->set_high(data.high());
   }
 }
 
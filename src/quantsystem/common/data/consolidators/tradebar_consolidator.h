@@ -27,7 +27,6 @@
 #define QUANTSYSTEM_COMMON_TRADEBAR_CONSOLIDATOR_H_
 
 #include "quantsystem/common/global.h"
-#include "quantsystem/common/base/scoped_ptr.h"
 #include "quantsystem/common/time/time_span.h"
 #include "quantsystem/common/time/date_time.h"
 #include "quantsystem/common/data/base_data.h"
@@ -43,6 +42,13 @@ namespace consolidators {
  * a given time span or a count of pieces of data, for example, if you
  * subscribe to minute data but want to have a 15 minute bar.
  *
+ * The consolidator owns two preallocated bars which swap roles at every
+ * emit: the working bar is aggregated in place and, once emitted, stays
+ * untouched while the other bar collects the next period. Updating does
+ * not allocate, and the consolidated bar passed to the event handlers
+ * is valid until the next emit. Handlers which keep the bar longer must
+ * Clone it.
+ *
  * @ingroup CommonBaseData
  */
 class TradeBarConsolidator : public DataConsolidator {
@@ -95,10 +101,34 @@ class TradeBarConsolidator : public DataConsolidator {
    */
   static TradeBarConsolidator* FromResolution(Resolution::Enum resolution);
 
+  /**
+   * Gets the bar being aggregated, NULL if no data arrived since the
+   * last emit.
+   */
+  const TradeBar* working_bar() const {
+    return has_working_bar_ ? &bars_[working_] : NULL;
+  }
+
+  /**
+   * Overwrite the bar with the first data of a new period.
+   *
+   * @param data The first data of the period
+   * @param[out] bar The bar to start
+   */
+  static void StartBar(const TradeBar& data, TradeBar* bar);
+
+  /**
+   * Aggregate a bar into a started bar.
+   *
+   * @param data The new data
+   * @param[out] bar The bar we're building
+   */
+  static void AggregateTradeBar(const TradeBar& data, TradeBar* bar);
+
  protected:
   /**
-   * Aggregates the new data into the 'working_bar', The 'working_bar' will be
-   * null following the event firing.
+   * Aggregates the new data into the 'working_bar', which already holds
+   * the first data of the period.
    *
    * @param data The new data
    * @param[out] working_bar The bar we're building
@@ -122,9 +152,12 @@ class TradeBarConsolidator : public DataConsolidator {
   int max_count_;
   // The number of pieces of data we've acuumulated since our last emit
   int current_count_;
-  // The working bar used for aggregating the data
-  // Can be NULL
-  scoped_ptr<TradeBar> working_bar_;
+  // The working bar and the last emitted bar, swapped at every emit
+  TradeBar bars_[2];
+  // Index of the working bar in bars_
+  int working_;
+  // Whether the working bar holds data of the current period
+  bool has_working_bar_;
   // The last time we emitted a consolidated bar
   // is_valid: false if unknown
   DateTime last_emit_;
@@ -0,0 +1,64 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_VOLUME_CONSOLIDATOR_H_
+#define QUANTSYSTEM_COMMON_VOLUME_CONSOLIDATOR_H_
+
+#include "quantsystem/common/data/consolidators/tick_consolidator.h"
+
+namespace quantsystem {
+namespace data {
+namespace consolidators {
+/**
+ * A tick consolidator that emits a bar once the traded quantity reaches
+ * the bar volume. The tick which reaches it closes the bar.
+ *
+ * @ingroup CommonBaseData
+ */
+class VolumeConsolidator : public TickConsolidator {
+ public:
+  /**
+   * Constructs the consolidator.
+   *
+   * @param bar_volume The traded quantity of a bar
+   */
+  explicit VolumeConsolidator(int64 bar_volume);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~VolumeConsolidator();
+
+ protected:
+  /**
+   * Whether the working bar is complete with the ticks aggregated so far.
+   *
+   * @param working_bar The bar we're building
+   */
+  virtual bool IsBarComplete(const TradeBar& working_bar) const;
+
+ private:
+  // The traded quantity of a bar
+  int64 bar_volume_;
+};
+
+}  // namespace consolidators
+}  // namespace data
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_VOLUME_CONSOLIDATOR_H_
@@ -32,7 +32,7 @@ namespace market {
 Tick::Tick()
     : tick_type_(kTrade),
       quantity_(0),
-      exchange_(0),
+      exchange_(""),
       sale_condition_(""),
       suspicious_(false),
       bid_price_(0.0),
@@ -58,7 +58,7 @@ Tick::Tick(const DateTime& time, const string& symbol, const double& bid,
            const double& ask)
     : tick_type_(kQuote),
       quantity_(0),
-      exchange_(0),
+      exchange_(""),
       sale_condition_(""),
       suspicious_(false),
       bid_price_(bid),
@@ -66,14 +66,14 @@ Tick::Tick(const DateTime& time, const string& symbol, const double& bid,
   set_data_type(MarketDataType::kTick);
   set_time(time);
   set_symbol(symbol);
-  set_value(bid + (ask + bid) / 2);
+  set_value(bid + (ask - bid) / 2);
 }
 
 Tick::Tick(const DateTime& time, const string& symbol, const double& last,
            const double& bid, const double& ask)
     : tick_type_(kQuote),
       quantity_(0),
-      exchange_(0),
+      exchange_(""),
       sale_condition_(""),
       suspicious_(false),
       bid_price_(bid),
@@ -87,26 +87,26 @@ Tick::Tick(const DateTime& time, const string& symbol, const double& last,
 Tick::Tick(const string& symbol, const StringPiece& line)
     : tick_type_(kQuote),
       quantity_(0),
-      exchange_(0),
+      exchange_(""),
       sale_condition_(""),
       suspicious_(false) {
   vector<StringPiece> parts = strings::Split(line, ".");
   set_data_type(MarketDataType::kTick);
   set_symbol(symbol);
   set_time(DateTime(parts[0].as_string()));
-  set_value(bid_price_ + (ask_price_ + bid_price_) / 2);
   if (!safe_strtod(parts[1].as_string(), &bid_price_)) {
     LOG(ERROR) << "invalid input bid_price=" << parts[1].as_string();
   }
   if (!safe_strtod(parts[2].as_string(), &ask_price_)) {
     LOG(ERROR) << "invalid input ask_price=" << parts[2].as_string();
   }
+  set_value(bid_price_ + (ask_price_ - bid_price_) / 2);
 }
 
 Tick::Tick(const SubscriptionDataConfig& config, const StringPiece& line,
           const DateTime& date, DataFeedEndpoint::Enum datafeed)
     : quantity_(0),
-      exchange_(0),
+      exchange_(""),
       sale_condition_(""),
       suspicious_(false) {
   vector<StringPiece>  parts = strings::Split(line, ",");
@@ -144,7 +144,7 @@ Tick::Tick(const SubscriptionDataConfig& config, const StringPiece& line,
       if (!safe_strtod(parts[2].as_string(), &ask_price_)) {
         LOG(ERROR) << "invalid input ask_price=" << parts[2].as_string();
       }
-      set_value(bid_price_ + (ask_price_ + bid_price_) / 2);
+      set_value(bid_price_ + (ask_price_ - bid_price_) / 2);
       break;
     default:
       LOG(FATAL) << "Invalid input security type  = " << config.security;
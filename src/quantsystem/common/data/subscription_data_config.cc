@@ -18,6 +18,8 @@
  */
 
 #include <glog/logging.h>
+#include "quantsystem/common/strings/case.h"
+#include "quantsystem/common/strings/strcat.h"
 #include "quantsystem/common/data/subscription_data_config.h"
 
 namespace quantsystem {
@@ -85,6 +87,19 @@ SubscriptionDataConfig::~SubscriptionDataConfig() {
   }
 }
 
+string SubscriptionDataConfig::GetLocalSource(const DateTime& date,
+                                              TickType tick_type) const {
+  string source = StrCat("./data/", strings::ToLower(
+      SecurityType::SecurityTypeToString(security)));
+  source += StrCat("/", strings::ToLower(
+      Resolution::ResolutionToString(resolution)),
+                   "/", strings::ToLower(symbol));
+  source += StrCat("/", date.ToShortString(),
+                   "_", strings::ToLower(TickTypeToString(tick_type)),
+                   ".zip");
+  return source;
+}
+
 }  // namespace data
 
 }  // namespace quantsystem
@@ -116,6 +116,17 @@ class SubscriptionDataConfig {
   void set_mapped_symbol(const string& new_symbol) {
     mapped_symbol = new_symbol;
   }
+
+  /**
+   * Path of one day of QuantSystem data in the local data store:
+   * ./data/<security type>/<resolution>/<symbol>/<yyyyMMdd>_<tick type>.zip
+   *
+   * @param date Date of the source file
+   * @param tick_type Type of the data in the file
+   * @return Relative path of the zip file
+   */
+  string GetLocalSource(const DateTime& date,
+                        TickType tick_type = kTrade) const;
 };
 
 }  // namespace data
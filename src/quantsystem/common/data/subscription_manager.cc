@@ -57,6 +57,7 @@ void SubscriptionManager::AddConsolidator(const StringPiece& symbol,
        it != subscriptions.end(); ++it) {
     if ((*it)->symbol == symbol_upper) {
       (*it)->consolidators.push_back(consolidator);
+      return;
     }
   }
   LOG(FATAL) << "Please subscribe to this symbol before " <<
@@ -29,22 +29,27 @@ EquityTransactionModel::~EquityTransactionModel() {
 
 OrderEvent* EquityTransactionModel::Fill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::Fill(asset, order);
 }
 
 OrderEvent* EquityTransactionModel::MarketFill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::MarketFill(asset, order);
 }
 
 OrderEvent* EquityTransactionModel::StopFill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::StopFill(asset, order);
 }
 
 OrderEvent* EquityTransactionModel::LimitFill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::LimitFill(asset, order);
 }
 
 double EquityTransactionModel::GetOrderFee(
     const double& quantity, const double& price) {
+  return SecurityTransactionModel::GetOrderFee(quantity, price);
 }
 
 }  // namespace equity
@@ -21,7 +21,7 @@
 #define QUANTSYSTEM_COMMON_SECURITIES_EQUITY_EQUITY_TRANSACTION_MODEL_H_
 
 #include "quantsystem/common/securities/security.h"
-#include "quantsystem/common/securities/interfaces/isecurity_transaction_model.h"
+#include "quantsystem/common/securities/security_transaction_model.h"
 
 namespace quantsystem {
 namespace securities {
@@ -30,7 +30,7 @@ namespace equity {
  * Transaction model for equity security trades. 
  * @ingroup CommonBaseSecurities
  */
-class EquityTransactionModel : public ISecurityTransactionModel {
+class EquityTransactionModel : public SecurityTransactionModel {
  public:
   /**
    * Standard constructor.
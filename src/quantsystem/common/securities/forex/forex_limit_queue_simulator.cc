@@ -0,0 +1,191 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <utility>
+using std::make_pair;
+#include "quantsystem/common/securities/forex/forex_limit_queue_simulator.h"
+namespace quantsystem {
+namespace securities {
+namespace forex {
+namespace {
+// Quotes and limits are parsed decimals: compare them with a tolerance
+const double kPriceEpsilon = 1e-10;
+}  // namespace
+
+ForexLimitQueueSimulator::ForexLimitQueueSimulator(double queue_depth,
+                                                   double depth_per_quote)
+    : queue_depth_(queue_depth),
+      depth_per_quote_(depth_per_quote) {
+}
+
+ForexLimitQueueSimulator::~ForexLimitQueueSimulator() {
+}
+
+void ForexLimitQueueSimulator::AddQuote(const string& symbol,
+                                        const DateTime& time, double bid,
+                                        double ask) {
+  MutexLock lock(&mutex_);
+  int symbol_id = GetSymbolId(symbol);
+  QuoteEvents& events = events_[symbol_id];
+  events.last_time_usec = time.ToEpochMicroseconds();
+  events.last_bid = bid;
+  events.last_ask = ask;
+  if (events.resting == 0) {
+    return;
+  }
+  events.time_usec.push_back(events.last_time_usec);
+  events.bid.push_back(bid);
+  events.ask.push_back(ask);
+  if (events.bid.size() % kCompactThreshold == 0) {
+    Compact(symbol_id);
+  }
+}
+
+bool ForexLimitQueueSimulator::Fill(const Order* order, double* fill_price,
+                                    DateTime* fill_time) {
+  MutexLock lock(&mutex_);
+  map<int, RestingOrder>::iterator it = resting_.find(order->id);
+  if (it == resting_.end()) {
+    // New order: marketable against the last quote, else join the queue
+    int symbol_id = GetSymbolId(order->symbol);
+    QuoteEvents& events = events_[symbol_id];
+    RestingOrder state;
+    state.symbol_id = symbol_id;
+    state.cursor = events.base + static_cast<int64>(events.bid.size());
+    state.limit = order->price;
+    state.buy = order->quantity > 0;
+    state.queue_ahead = queue_depth_ + std::fabs(order->quantity);
+    state.at_touch = false;
+    if (events.last_time_usec != 0) {
+      if (state.buy && events.last_ask <= state.limit + kPriceEpsilon) {
+        *fill_price = events.last_ask;
+        *fill_time = DateTime::FromEpochMicroseconds(events.last_time_usec);
+        return true;
+      }
+      if (!state.buy && events.last_bid >= state.limit - kPriceEpsilon) {
+        *fill_price = events.last_bid;
+        *fill_time = DateTime::FromEpochMicroseconds(events.last_time_usec);
+        return true;
+      }
+      state.at_touch = state.buy
+          ? events.last_bid >= state.limit - kPriceEpsilon
+          : events.last_ask <= state.limit + kPriceEpsilon;
+    }
+    resting_.insert(make_pair(order->id, state));
+    ++events.resting;
+    return false;
+  }
+  RestingOrder& state = it->second;
+  QuoteEvents& events = events_[state.symbol_id];
+  const int64 end = events.base + static_cast<int64>(events.bid.size());
+  const double* same_side = state.buy ? events.bid.data() : events.ask.data();
+  const double* opposite = state.buy ? events.ask.data() : events.bid.data();
+  // +1 for a buy: the book is better for us above the limit
+  const double sign = state.buy ? 1 : -1;
+  for (int64 i = state.cursor; i < end; ++i) {
+    const int64 k = i - events.base;
+    const double touch = sign * (same_side[k] - state.limit);
+    bool filled = false;
+    if (sign * (opposite[k] - state.limit) <= kPriceEpsilon) {
+      // The other side came to our price
+      filled = true;
+    } else if (touch < -kPriceEpsilon) {
+      // Traded through our level once we were in the book
+      filled = state.at_touch;
+    } else {
+      state.at_touch = true;
+      if (touch <= kPriceEpsilon) {
+        state.queue_ahead -= depth_per_quote_;
+        filled = state.queue_ahead <= 0;
+      }
+    }
+    if (filled) {
+      *fill_price = state.limit;
+      *fill_time = DateTime::FromEpochMicroseconds(events.time_usec[k]);
+      Release(it);
+      return true;
+    }
+  }
+  state.cursor = end;
+  return false;
+}
+
+void ForexLimitQueueSimulator::Forget(int order_id) {
+  MutexLock lock(&mutex_);
+  map<int, RestingOrder>::iterator it = resting_.find(order_id);
+  if (it != resting_.end()) {
+    Release(it);
+  }
+}
+
+int ForexLimitQueueSimulator::QuoteCount(const string& symbol) const {
+  MutexLock lock(&mutex_);
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  if (found == symbol_ids_.end()) {
+    return 0;
+  }
+  return static_cast<int>(events_[found->second].bid.size());
+}
+
+int ForexLimitQueueSimulator::GetSymbolId(const string& symbol) {
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  if (found != symbol_ids_.end()) {
+    return found->second;
+  }
+  int id = static_cast<int>(events_.size());
+  symbol_ids_.insert(make_pair(symbol, id));
+  events_.push_back(QuoteEvents());
+  return id;
+}
+
+void ForexLimitQueueSimulator::Release(
+    map<int, RestingOrder>::iterator it) {
+  QuoteEvents& events = events_[it->second.symbol_id];
+  resting_.erase(it);
+  if (--events.resting == 0) {
+    events.base += static_cast<int64>(events.bid.size());
+    events.time_usec.clear();
+    events.bid.clear();
+    events.ask.clear();
+  }
+}
+
+void ForexLimitQueueSimulator::Compact(int symbol_id) {
+  QuoteEvents& events = events_[symbol_id];
+  int64 first = events.base + static_cast<int64>(events.bid.size());
+  for (map<int, RestingOrder>::const_iterator it = resting_.begin();
+       it != resting_.end(); ++it) {
+    if (it->second.symbol_id == symbol_id && it->second.cursor < first) {
+      first = it->second.cursor;
+    }
+  }
+  const int64 count = first - events.base;
+  if (count <= 0) {
+    return;
+  }
+  events.time_usec.erase(events.time_usec.begin(),
+                         events.time_usec.begin() + count);
+  events.bid.erase(events.bid.begin(), events.bid.begin() + count);
+  events.ask.erase(events.ask.begin(), events.ask.begin() + count);
+  events.base = first;
+}
+}  // namespace forex
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,165 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_SECURITIES_FOREX_FOREX_LIMIT_QUEUE_SIMULATOR_H_
+#define QUANTSYSTEM_COMMON_SECURITIES_FOREX_FOREX_LIMIT_QUEUE_SIMULATOR_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/base/mutex.h"
+#include "quantsystem/common/orders/order.h"
+#include "quantsystem/common/time/date_time.h"
+namespace quantsystem {
+using orders::Order;
+namespace securities {
+namespace forex {
+/**
+ * Queue position aware fill simulator for resting forex limit orders.
+ *
+ * The quote ticks of every symbol with a resting limit order are
+ * appended to flat per-symbol arrays of time, bid and ask. Each resting
+ * order keeps a cursor into the arrays of its symbol and replays only
+ * the quotes received since it was last checked, so the cost of a tick
+ * backtest grows with the number of quotes and not with the number of
+ * checks. The quote data carries no sizes: an order joining the touch
+ * is placed behind an assumed queue depth which is consumed by a fixed
+ * amount on every quote that stays at the order price.
+ *
+ * A buy limit at price P (sell is symmetric):
+ * - fills at once at the ask if P >= ask when it is placed;
+ * - fills at P when the ask comes down to P;
+ * - fills at P when the bid was at or above P and then drops below it,
+ *   the queue at P having traded through;
+ * - fills at P when its queue at the touch is consumed.
+ * @ingroup CommonBaseSecurities
+ * @see ForexTransactionModel
+ */
+class ForexLimitQueueSimulator {
+ public:
+  /**
+   * Construct a simulator.
+   * @param queue_depth Units assumed ahead of an order joining the touch
+   * @param depth_per_quote Units of the queue consumed by each quote
+   * update at the order price
+   */
+  ForexLimitQueueSimulator(double queue_depth, double depth_per_quote);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~ForexLimitQueueSimulator();
+
+  /**
+   * Append a quote tick. Quotes of a symbol without resting orders are
+   * dropped.
+   * @param symbol Symbol of the quote
+   * @param time Time of the quote
+   * @param bid Best bid price
+   * @param ask Best ask price
+   */
+  void AddQuote(const string& symbol, const DateTime& time, double bid,
+                double ask);
+
+  /**
+   * Check a resting limit order against the quotes since its last
+   * check. The first check places the order at the back of the queue.
+   * @param order Limit order to check
+   * @param fill_price[out] Fill price when filled
+   * @param fill_time[out] Time of the quote which filled the order
+   * @return True if the order is filled, it is then no longer tracked.
+   */
+  bool Fill(const Order* order, double* fill_price, DateTime* fill_time);
+
+  /**
+   * Stop tracking an order, e.g. when it is canceled.
+   * @param order_id Id of the order
+   */
+  void Forget(int order_id);
+
+  /**
+   * Number of quotes kept for the symbol.
+   */
+  int QuoteCount(const string& symbol) const;
+
+ private:
+  // Flat quote arrays of one symbol
+  class QuoteEvents {
+   public:
+    vector<int64> time_usec;  // Quote time, microseconds from the epoch
+    vector<double> bid;
+    vector<double> ask;
+    int64 base;  // Absolute index of the first kept quote
+    int resting;  // Number of tracked orders on the symbol
+    // Last quote, kept even without resting orders
+    int64 last_time_usec;
+    double last_bid;
+    double last_ask;
+    QuoteEvents()
+        : base(0),
+          resting(0),
+          last_time_usec(0),
+          last_bid(0),
+          last_ask(0) {
+    }
+  };
+
+  // State of one resting order
+  class RestingOrder {
+   public:
+    int symbol_id;
+    int64 cursor;  // Absolute index of the next quote to replay
+    double limit;
+    bool buy;
+    double queue_ahead;  // Units to trade at the limit before the fill
+    bool at_touch;  // The touch has been at or through the limit
+  };
+
+  static const int kCompactThreshold = 1 << 16;
+  double queue_depth_;
+  double depth_per_quote_;
+  map<string, int> symbol_ids_ GUARDED_BY(mutex_);
+  vector<QuoteEvents> events_ GUARDED_BY(mutex_);
+  map<int, RestingOrder> resting_ GUARDED_BY(mutex_);
+  mutable Mutex mutex_;
+
+  int GetSymbolId(const string& symbol);
+
+  /**
+   * Stop tracking a resting order, the quotes of its symbol are
+   * released when no order rests on it any more.
+   */
+  void Release(map<int, RestingOrder>::iterator it);
+
+  /**
+   * Drop the quotes which every resting order of the symbol has
+   * already replayed.
+   */
+  void Compact(int symbol_id);
+
+  DISALLOW_COPY_AND_ASSIGN(ForexLimitQueueSimulator);
+};
+}  // namespace forex
+}  // namespace securities
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_SECURITIES_FOREX_FOREX_LIMIT_QUEUE_SIMULATOR_H_
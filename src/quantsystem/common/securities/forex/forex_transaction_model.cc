@@ -17,8 +17,10 @@
  * @}
  */
 
+#include "quantsystem/common/data/market/tick.h"
 #include "quantsystem/common/securities/forex/forex_transaction_model.h"
 namespace quantsystem {
+using data::market::Tick;
 namespace securities {
 namespace forex {
 ForexTransactionModel::ForexTransactionModel() {
@@ -29,23 +31,65 @@ ForexTransactionModel::~ForexTransactionModel() {
 
 OrderEvent* ForexTransactionModel::Fill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::Fill(asset, order);
 }
 
 double ForexTransactionModel::GetSlippageApproximation(
     const Security* asset,
     const Order* order) {
+  return SecurityTransactionModel::GetSlippageApproximation(asset, order);
 }
 
 OrderEvent* ForexTransactionModel::MarketFill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::MarketFill(asset, order);
 }
 
 OrderEvent* ForexTransactionModel::StopFill(
     const Security* asset, Order* order) {
+  return SecurityTransactionModel::StopFill(asset, order);
 }
 
 OrderEvent* ForexTransactionModel::LimitFill(
     const Security* asset, Order* order) {
+  if (queue_simulator_.get() == NULL) {
+    return SecurityTransactionModel::LimitFill(asset, order);
+  }
+  OrderEvent* fill = new OrderEvent(*order);
+  if (order->status == orders::kCanceled) {
+    queue_simulator_->Forget(order->id);
+    return fill;
+  }
+  double fill_price;
+  DateTime fill_time;
+  if (queue_simulator_->Fill(order, &fill_price, &fill_time)) {
+    order->status = orders::kFilled;
+    order->price = fill_price;
+    fill->status = order->status;
+    fill->fill_price = order->price;
+    fill->fill_quantity = order->quantity;
+    fill->message = "Queue fill at " + fill_time.ToString();
+  }
+  return fill;
+}
+
+void ForexTransactionModel::EnableQueueSimulation(double queue_depth,
+                                                  double depth_per_quote) {
+  queue_simulator_.reset(
+      new ForexLimitQueueSimulator(queue_depth, depth_per_quote));
+}
+
+void ForexTransactionModel::OnData(const BaseData* data) {
+  if (queue_simulator_.get() == NULL ||
+      data->data_type() != MarketDataType::kTick) {
+    return;
+  }
+  const Tick* tick = static_cast<const Tick*>(data);
+  if (tick->tick_type() != kQuote) {
+    return;
+  }
+  queue_simulator_->AddQuote(tick->symbol(), tick->time(), tick->bid_price(),
+                             tick->ask_price());
 }
 
 }  // namespace forex
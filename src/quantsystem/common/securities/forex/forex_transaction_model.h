@@ -20,8 +20,11 @@
 #ifndef QUANTSYSTEM_COMMON_SECURITIES_FOREX_FOREX_TRANSACTION_MODEL_H_
 #define QUANTSYSTEM_COMMON_SECURITIES_FOREX_FOREX_TRANSACTION_MODEL_H_
 
+#include "quantsystem/common/base/scoped_ptr.h"
+#include "quantsystem/common/data/base_data.h"
 #include "quantsystem/common/securities/security.h"
-#include "quantsystem/common/securities/interfaces/isecurity_transaction_model.h"
+#include "quantsystem/common/securities/security_transaction_model.h"
+#include "quantsystem/common/securities/forex/forex_limit_queue_simulator.h"
 namespace quantsystem {
 namespace securities {
 namespace forex {
@@ -30,7 +33,7 @@ namespace forex {
  * for FOREX orders.
  * @ingroup CommonBaseSecurities
  */
-class ForexTransactionModel : public ISecurityTransactionModel {
+class ForexTransactionModel : public SecurityTransactionModel {
  public:
   /**
    * Standard constructor.
@@ -78,7 +81,8 @@ class ForexTransactionModel : public ISecurityTransactionModel {
   virtual OrderEvent* StopFill(const Security* asset,  Order* order);
 
   /**
-   * Model for a limit fill.
+   * Model for a limit fill. With queue simulation enabled the order
+   * fills from its position in the quote queue, otherwise on price only.
    * @param asset Asset we're trading this order
    * @param order Order class to check if filled
    * @return OrderEvent packet with the full or partial fill information
@@ -98,6 +102,31 @@ class ForexTransactionModel : public ISecurityTransactionModel {
     // Modelled order fee to 0; Assume spread is the fee for most FX brokerages.
     return 0;
   }
+
+  /**
+   * Fill the limit orders from a queue position aware simulation of
+   * the tick quotes instead of the price alone.
+   * @param queue_depth Units assumed ahead of an order joining the touch
+   * @param depth_per_quote Units of the queue consumed by each quote
+   * update at the order price
+   */
+  void EnableQueueSimulation(double queue_depth, double depth_per_quote);
+
+  /**
+   * Queue simulator, NULL when the queue simulation is disabled.
+   */
+  ForexLimitQueueSimulator* queue_simulator() const {
+    return queue_simulator_.get();
+  }
+
+  /**
+   * Feed the market data of the security to the queue simulator.
+   * @param data New market data, only quote ticks are used
+   */
+  void OnData(const BaseData* data);
+
+ private:
+  scoped_ptr<ForexLimitQueueSimulator> queue_simulator_;
 };
 
 }  // namespace forex
@@ -112,7 +112,17 @@ class Security {
    */
   SecurityHolding* holdings() const { return holdings_.get(); }
   void set_holdings(SecurityHolding* holdings) {
+    SecurityHoldingsStore* store = NULL;
+    int store_id = -1;
+    if (holdings_.get() != NULL) {
+      store = holdings_->store();
+      store_id = holdings_->store_id();
+    }
     holdings_.reset(holdings);
+    if (store != NULL && holdings != NULL) {
+      store->Register(symbol_, leverage_, model_.get());
+      holdings->AttachStore(store, store_id);
+    }
   }
 
   /**
@@ -160,7 +170,7 @@ class Security {
   /**
    * Local time for this market.
    */
-  virtual DateTime Time() const { exchange_->Time(); }
+  virtual DateTime Time() const { return exchange_->Time(); }
 
   /**
    * Get the current value of the security.
@@ -168,7 +178,7 @@ class Security {
   virtual double Price() const {
     BaseData* data = GetLastData();
     if (data) {
-      data->value();
+      return data->value();
     }
     return 0;
   }
@@ -180,7 +190,12 @@ class Security {
     return leverage_;
   }
 
-  void set_leverage(const double& leverage) { leverage_ = leverage; }
+  void set_leverage(const double& leverage) {
+    leverage_ = leverage;
+    if (holdings_.get() != NULL && holdings_->store() != NULL) {
+      holdings_->store()->set_leverage(holdings_->store_id(), leverage);
+    }
+  }
 
   /**
    * Use QuantSystem data a source flag, or is the security a user
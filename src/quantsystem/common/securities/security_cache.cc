@@ -20,7 +20,8 @@
 #include "quantsystem/common/securities/security_cache.h"
 namespace quantsystem {
 namespace securities {
-SecurityCache::SecurityCache() {
+SecurityCache::SecurityCache()
+    : last_data_(NULL) {
 }
 
 SecurityCache::~SecurityCache() {
@@ -22,26 +22,47 @@ namespace quantsystem {
 namespace securities {
 SecurityHolding::SecurityHolding(const string& symbol,
                                   ISecurityTransactionModel* model)
-    : symbol_(symbol),
+    : average_price_(0),
+      quantity_(0),
+      price_(0),
+      symbol_(symbol),
       total_sale_volume_(0),
-      last_trade_profit_(0) {
+      profit_(0),
+      last_trade_profit_(0),
+      total_fees_(0),
+      store_(NULL),
+      store_id_(-1) {
   model_ = model;
 }
 
 SecurityHolding::~SecurityHolding() {
 }
 
+void SecurityHolding::AttachStore(SecurityHoldingsStore* store, int id) {
+  store_ = store;
+  store_id_ = id;
+  if (store_ == NULL) {
+    return;
+  }
+  store_->set_holdings(id, average_price_, quantity_);
+  store_->set_price(id, price_);
+  store_->add_fee(id, total_fees_);
+  store_->add_sale(id, total_sale_volume_);
+  store_->add_profit(id, profit_);
+}
+
 double SecurityHolding::TotalCloseProfit() {
   double gross = 0, net = 0, order_fee = 0;
+  double price = current_price();
   if (AbsoluteQuantity() > 0) {
-    order_fee = model_->GetOrderFee(AbsoluteQuantity(), price_);
+    order_fee = model_->GetOrderFee(AbsoluteQuantity(), price);
   }
   if (IsLong()) {
     // if we're long on a position, profit from selling off $10,000 stock
-    gross = (price_ - average_price()) * AbsoluteQuantity();
+    gross = (price - average_price()) * AbsoluteQuantity();
   } else if (IsShort()) {
     // if we're short on a position, profit from buying $10,000 stock
-    gross = (average_price() - price_) * AbsoluteQuantity();
+    gross = (average_price() - price) * AbsoluteQuantity();
   } else {
     // no holdings
     return 0;
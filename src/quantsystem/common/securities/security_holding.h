@@ -24,6 +24,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
+#include "quantsystem/common/securities/security_holdings_store.h"
 #include "quantsystem/common/securities/interfaces/isecurity_transaction_model.h"
 
 namespace quantsystem {
@@ -76,7 +77,7 @@ class SecurityHolding {
   /**
    * Current market price of the security.
    */
-  virtual double price() const { return price_; }
+  virtual double price() const { return current_price(); }
 
   /**
    * Absolute holdings cost for current holding.
@@ -89,7 +90,7 @@ class SecurityHolding {
    * Market value of our holdings.
    */
   virtual double HoldingsValue() const {
-    return price_ * quantity_;
+    return current_price() * quantity_;
   }
 
   /**
@@ -175,6 +176,7 @@ class SecurityHolding {
    */
   void AddNewFee(const double& new_fee) {
     total_fees_ += new_fee;
+    if (store_ != NULL) store_->add_fee(store_id_, new_fee);
   }
 
   /**
@@ -183,6 +185,7 @@ class SecurityHolding {
    */
   void AddNewProfit(const double& profit_loss) {
     profit_ += profit_loss;
+    if (store_ != NULL) store_->add_profit(store_id_, profit_loss);
   }
 
   /**
@@ -190,6 +193,7 @@ class SecurityHolding {
    */
   void AddNewSale(const double& sale_value) {
     total_sale_volume_ += sale_value;
+    if (store_ != NULL) store_->add_sale(store_id_, sale_value);
   }
 
   /**
@@ -208,6 +212,9 @@ class SecurityHolding {
   virtual void SetHoldings(const double& average_price, int quantity) {
     average_price_ = average_price;
     quantity_ = quantity;
+    if (store_ != NULL) {
+      store_->set_holdings(store_id_, average_price, quantity);
+    }
   }
 
   /**
@@ -217,6 +224,7 @@ class SecurityHolding {
    */
   virtual void UpdatePrice(const double& closing_price) {
     price_ = closing_price;
+    if (store_ != NULL) store_->set_price(store_id_, closing_price);
   }
 
   /**
@@ -224,6 +232,27 @@ class SecurityHolding {
    */
   virtual double TotalCloseProfit();
 
+  /**
+   * Mirror this holding into a row of the portfolio holdings store.
+   *
+   * Once attached the store row is the authority for the market price,
+   * so a whole time slice can be priced with
+   * SecurityHoldingsStore::UpdatePrices without touching this object.
+   * @param store Holdings store owned by the SecurityManager
+   * @param id Row id of this symbol in the store
+   */
+  void AttachStore(SecurityHoldingsStore* store, int id);
+
+  /**
+   * Holdings store this holding is attached to, or NULL.
+   */
+  SecurityHoldingsStore* store() const { return store_; }
+
+  /**
+   * Row id of this holding in the attached store, or -1.
+   */
+  int store_id() const { return store_id_; }
+
  private:
   double average_price_;
   int quantity_;
@@ -234,6 +263,12 @@ class SecurityHolding {
   double last_trade_profit_;
   double total_fees_;
   ISecurityTransactionModel* model_;
+  SecurityHoldingsStore* store_;
+  int store_id_;
+
+  double current_price() const {
+    return store_ != NULL ? store_->price(store_id_) : price_;
+  }
 
   SecurityHolding();
 };
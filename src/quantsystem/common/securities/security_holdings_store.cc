@@ -0,0 +1,190 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <cmath>
+#include <utility>
+using std::make_pair;
+#include "quantsystem/common/securities/security_holdings_store.h"
+namespace quantsystem {
+namespace securities {
+const int SecurityHoldingsStore::kResumInterval;
+
+SecurityHoldingsStore::SecurityHoldingsStore()
+    : total_unrealized_profit_(0),
+      total_unlevered_cost_(0),
+      updates_since_resum_(0) {
+}
+
+SecurityHoldingsStore::~SecurityHoldingsStore() {
+}
+
+int SecurityHoldingsStore::Register(const string& symbol, double leverage,
+                                    ISecurityTransactionModel* model) {
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  int id;
+  if (found != symbol_ids_.end()) {
+    id = found->second;
+  } else {
+    id = size();
+    symbol_ids_.insert(make_pair(symbol, id));
+    symbols_.push_back(symbol);
+    models_.push_back(NULL);
+    quantity_.push_back(0);
+    average_price_.push_back(0);
+    price_.push_back(0);
+    leverage_.push_back(1);
+    total_fees_.push_back(0);
+    total_sale_volume_.push_back(0);
+    profit_.push_back(0);
+    unrealized_profit_.push_back(0);
+    unlevered_cost_.push_back(0);
+  }
+  models_[id] = model;
+  quantity_[id] = 0;
+  average_price_[id] = 0;
+  price_[id] = 0;
+  leverage_[id] = leverage > 0 ? leverage : 1;
+  total_fees_[id] = 0;
+  total_sale_volume_[id] = 0;
+  profit_[id] = 0;
+  margin_.Register(id, leverage_[id]);
+  UpdateTotals(id);
+  return id;
+}
+
+void SecurityHoldingsStore::Unregister(const string& symbol) {
+  int id = GetId(symbol);
+  if (id < 0) {
+    return;
+  }
+  models_[id] = NULL;
+  quantity_[id] = 0;
+  average_price_[id] = 0;
+  price_[id] = 0;
+  total_fees_[id] = 0;
+  total_sale_volume_[id] = 0;
+  profit_[id] = 0;
+  UpdateTotals(id);
+}
+
+int SecurityHoldingsStore::GetId(const string& symbol) const {
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  if (found == symbol_ids_.end()) {
+    return -1;
+  }
+  return found->second;
+}
+
+void SecurityHoldingsStore::UpdatePrices(const vector<int>& ids,
+                                         const vector<double>& prices) {
+  DCHECK_EQ(ids.size(), prices.size());
+  double* price = price_.data();
+  const int* id = ids.data();
+  const double* value = prices.data();
+  const int count = static_cast<int>(ids.size());
+  for (int i = 0; i < count; ++i) {
+    price[id[i]] = value[i];
+    UpdateTotals(id[i]);
+  }
+}
+
+void SecurityHoldingsStore::UpdatePrices(const double* prices) {
+  double* price = price_.data();
+  const int count = size();
+  for (int i = 0; i < count; ++i) {
+    price[i] = prices[i];
+    UpdateTotals(i);
+  }
+}
+
+double SecurityHoldingsStore::TotalAbsoluteHoldingsValue() const {
+  const double* quantity = quantity_.data();
+  const double* price = price_.data();
+  const int count = size();
+  double total = 0;
+  for (int i = 0; i < count; ++i) {
+    total += std::fabs(price[i] * quantity[i]);
+  }
+  return total;
+}
+
+double SecurityHoldingsStore::TotalGrossUnrealizedProfit() const {
+  const double* quantity = quantity_.data();
+  const double* average_price = average_price_.data();
+  const double* price = price_.data();
+  const int count = size();
+  double total = 0;
+  for (int i = 0; i < count; ++i) {
+    // (price - average) * quantity covers both sides: a short holding has
+    // a negative quantity and profits when the price falls.
+    total += (price[i] - average_price[i]) * quantity[i];
+  }
+  return total;
+}
+
+void SecurityHoldingsStore::UpdateTotals(int id) {
+  const double quantity = quantity_[id];
+  const double price = price_[id];
+  double unrealized_profit = (price - average_price_[id]) * quantity;
+  // Fee models are per security, only the invested rows need a call.
+  if (quantity != 0 && models_[id] != NULL) {
+    unrealized_profit -= models_[id]->GetOrderFee(std::fabs(quantity), price);
+  }
+  double unlevered_cost = std::fabs(average_price_[id] * quantity) /
+      leverage_[id];
+  total_unrealized_profit_ += unrealized_profit - unrealized_profit_[id];
+  total_unlevered_cost_ += unlevered_cost - unlevered_cost_[id];
+  unrealized_profit_[id] = unrealized_profit;
+  unlevered_cost_[id] = unlevered_cost;
+  margin_.Update(id, std::fabs(quantity * price));
+  if (++updates_since_resum_ >= kResumInterval) {
+    Resum();
+  }
+}
+
+void SecurityHoldingsStore::Resum() {
+  total_unrealized_profit_ = Sum(unrealized_profit_);
+  total_unlevered_cost_ = Sum(unlevered_cost_);
+  updates_since_resum_ = 0;
+}
+
+double SecurityHoldingsStore::TotalFees() const {
+  return Sum(total_fees_);
+}
+
+double SecurityHoldingsStore::TotalSaleVolume() const {
+  return Sum(total_sale_volume_);
+}
+
+double SecurityHoldingsStore::TotalProfit() const {
+  return Sum(profit_);
+}
+
+double SecurityHoldingsStore::Sum(const vector<double>& values) {
+  const double* value = values.data();
+  const int count = static_cast<int>(values.size());
+  double total = 0;
+  for (int i = 0; i < count; ++i) {
+    total += value[i];
+  }
+  return total;
+}
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,223 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_SECURITIES_SECURITY_HOLDINGS_STORE_H_
+#define QUANTSYSTEM_COMMON_SECURITIES_SECURITY_HOLDINGS_STORE_H_
+
+#include <cmath>
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/securities/security_margin_engine.h"
+#include "quantsystem/common/securities/interfaces/isecurity_transaction_model.h"
+namespace quantsystem {
+namespace securities {
+/**
+ * Structure-of-arrays storage for the holdings of every security
+ * in the algorithm.
+ *
+ * Each registered symbol gets a dense integer id which indexes a row in
+ * parallel arrays of quantity, average price, last price, leverage,
+ * fees, sale volume and profit. A time slice of prices is applied in
+ * one pass over the arrays and the portfolio totals are plain
+ * reductions over contiguous memory, which the compiler vectorizes,
+ * instead of a walk over the security map with virtual calls.
+ * The unrealized profit and the unlevered cost, read by every buying
+ * power and margin call check, are kept as running totals like the
+ * margin: a price or quantity change applies the difference of its row.
+ * @ingroup CommonBaseSecurities
+ * @see SecurityHolding
+ * @see SecurityPortfolioManager
+ */
+class SecurityHoldingsStore {
+ public:
+  /**
+   * Standard constructor.
+   */
+  SecurityHoldingsStore();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~SecurityHoldingsStore();
+
+  /**
+   * Register a symbol and get its row id. Registering an existing
+   * symbol resets its row and returns the same id.
+   * @param symbol Symbol of the security
+   * @param leverage Leverage of the security
+   * @param model Transaction model used for the closing fee estimate
+   * @return Row id of the symbol
+   */
+  int Register(const string& symbol, double leverage,
+               ISecurityTransactionModel* model);
+
+  /**
+   * Clear the row of a removed symbol. The id stays reserved so handles
+   * held by other components do not alias a new security.
+   * @param symbol Symbol of the security
+   */
+  void Unregister(const string& symbol);
+
+  /**
+   * Get the row id of the symbol.
+   * @return Row id, or -1 if the symbol is not registered.
+   */
+  int GetId(const string& symbol) const;
+
+  /**
+   * Number of rows in the store.
+   */
+  int size() const { return static_cast<int>(symbols_.size()); }
+
+  const string& symbol(int id) const { return symbols_[id]; }
+  double quantity(int id) const { return quantity_[id]; }
+  double average_price(int id) const { return average_price_[id]; }
+  double price(int id) const { return price_[id]; }
+  double leverage(int id) const { return leverage_[id]; }
+  double total_fees(int id) const { return total_fees_[id]; }
+  double total_sale_volume(int id) const { return total_sale_volume_[id]; }
+  double profit(int id) const { return profit_[id]; }
+
+  void set_price(int id, double price) {
+    price_[id] = price;
+    UpdateTotals(id);
+  }
+  void set_leverage(int id, double leverage) {
+    if (leverage <= 0) {
+      return;
+    }
+    leverage_[id] = leverage;
+    margin_.SetRequirements(id, 1 / leverage, 1 / leverage);
+    UpdateTotals(id);
+  }
+  void set_holdings(int id, double average_price, double quantity) {
+    average_price_[id] = average_price;
+    quantity_[id] = quantity;
+    UpdateTotals(id);
+  }
+  void add_fee(int id, double fee) { total_fees_[id] += fee; }
+  void add_sale(int id, double sale_value) {
+    total_sale_volume_[id] += sale_value;
+  }
+  void add_profit(int id, double profit) { profit_[id] += profit; }
+
+  /**
+   * Apply the prices of one time slice in a single pass.
+   * @param ids Row ids of the securities with new data
+   * @param prices New prices, parallel to ids
+   */
+  void UpdatePrices(const vector<int>& ids, const vector<double>& prices);
+
+  /**
+   * Overwrite the price of every row in a single pass.
+   * @param prices Dense price array of size() elements
+   */
+  void UpdatePrices(const double* prices);
+
+  /**
+   * Sum of the absolute market value of every holding.
+   */
+  double TotalAbsoluteHoldingsValue() const;
+
+  /**
+   * Sum of the absolute acquisition cost of every holding
+   * divided by its leverage. Running total, O(1).
+   */
+  double TotalUnleveredAbsoluteHoldingsCost() const {
+    return total_unlevered_cost_;
+  }
+
+  /**
+   * Unrealized profit of every holding before the closing fees.
+   */
+  double TotalGrossUnrealizedProfit() const;
+
+  /**
+   * Unrealized profit of every holding less the estimated fee to
+   * close it, the same value as summing SecurityHolding::TotalCloseProfit.
+   * Running total, O(1).
+   */
+  double TotalUnrealizedProfit() const { return total_unrealized_profit_; }
+
+  /**
+   * Sum of the fees paid across all securities.
+   */
+  double TotalFees() const;
+
+  /**
+   * Sum of the sale volume across all securities.
+   */
+  double TotalSaleVolume() const;
+
+  /**
+   * Sum of the closed trade profit across all securities.
+   */
+  double TotalProfit() const;
+
+  /**
+   * Margin used by the rows of this store, kept in step with every
+   * price and quantity change.
+   */
+  const SecurityMarginEngine& margin() const { return margin_; }
+  SecurityMarginEngine* mutable_margin() { return &margin_; }
+
+  /**
+   * Recompute the running totals from the rows.
+   */
+  void Resum();
+
+ private:
+  static const int kResumInterval = 1024;
+  map<string, int> symbol_ids_;
+  vector<string> symbols_;
+  vector<ISecurityTransactionModel*> models_;
+  vector<double> quantity_;
+  vector<double> average_price_;
+  vector<double> price_;
+  vector<double> leverage_;
+  vector<double> total_fees_;
+  vector<double> total_sale_volume_;
+  vector<double> profit_;
+  // Unrealized profit net of the closing fee and unlevered cost of each
+  // row, as included in the running totals
+  vector<double> unrealized_profit_;
+  vector<double> unlevered_cost_;
+  double total_unrealized_profit_;
+  double total_unlevered_cost_;
+  int updates_since_resum_;
+  SecurityMarginEngine margin_;
+
+  /**
+   * Apply the current price, quantity and leverage of a row to the
+   * running totals and to the margin.
+   */
+  void UpdateTotals(int id);
+
+  static double Sum(const vector<double>& values);
+
+  DISALLOW_COPY_AND_ASSIGN(SecurityHoldingsStore);
+};
+}  // namespace securities
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_SECURITIES_SECURITY_HOLDINGS_STORE_H_
@@ -44,7 +44,8 @@ void SecurityManager::Add(const string& symbol, Security* security) {
     delete found->second;
     security_manager_.erase(found);
   }
-  security_manager_.insert(make_pair(symbol, security));;
+  security_manager_.insert(make_pair(symbol, security));
+  AttachHoldings(security);
 }
 void SecurityManager::Add(const string& symbol,
                            SecurityType::Enum type,
@@ -116,6 +117,7 @@ void SecurityManager::Add(const string& symbol,
                          extended_market_hours, use_quant_system_data);
         break;
     }
+    AttachHoldings(security_manager_[symbol_]);
   }
 }
 
@@ -123,12 +125,15 @@ void SecurityManager::Add(const ManagerMap::value_type& pair) {
   security_manager_.insert(pair);
   security_holdings_.insert(HoldingMap::value_type(
       pair.first, pair.second->holdings()));
+  AttachHoldings(pair.second);
 }
 
 void SecurityManager::Remove(const string& key) {
   ManagerMap::iterator it = security_manager_.find(key);
   if (it != security_manager_.end()) {
     security_manager_.erase(it);
+    holdings_store_.Unregister(key);
+    subscription_securities_.clear();
   }
 }
 
@@ -141,6 +146,7 @@ bool SecurityManager::ContainsKey(const string& key) const {
 }
 
 void SecurityManager::Clear() {
+  subscription_securities_.clear();
   STLDeleteContainerPairSecondPointers(
       security_manager_.begin(),
       security_manager_.end());
@@ -190,6 +196,99 @@ int SecurityManager::GetResolutionCount(Resolution::Enum resolution) const {
   return count;
 }
 
+void SecurityManager::Update(const DateTime& time,
+                             const vector<BaseData*>& slice) {
+  for (ManagerMap::iterator it = security_manager_.begin();
+       it != security_manager_.end(); ++it) {
+    it->second->Update(time, NULL);
+  }
+  slice_ids_.clear();
+  slice_prices_.clear();
+  for (int i = 0; i < slice.size(); ++i) {
+    BaseData* data = slice[i];
+    if (data == NULL) {
+      continue;
+    }
+    Security* security = Get(data->symbol());
+    if (security != NULL) {
+      AddSliceData(security, data);
+    }
+  }
+  holdings_store_.UpdatePrices(slice_ids_, slice_prices_);
+}
+
+void SecurityManager::Update(const DateTime& time,
+                             const SubscriptionSlice& slice) {
+  for (ManagerMap::iterator it = security_manager_.begin();
+       it != security_manager_.end(); ++it) {
+    it->second->Update(time, NULL);
+  }
+  slice_ids_.clear();
+  slice_prices_.clear();
+  for (SubscriptionSlice::const_iterator it = slice.begin();
+       it != slice.end(); ++it) {
+    const vector<BaseData*>& data = it->second;
+    if (data.empty()) {
+      continue;
+    }
+    Security* security = GetSubscriptionSecurity(it->first, data[0]);
+    if (security == NULL) {
+      continue;
+    }
+    for (int i = 0; i < data.size(); ++i) {
+      if (data[i] != NULL) {
+        AddSliceData(security, data[i]);
+      }
+    }
+  }
+  holdings_store_.UpdatePrices(slice_ids_, slice_prices_);
+}
+
+void SecurityManager::AddSliceData(Security* security, BaseData* data) {
+  security->cache()->AddData(data);
+  if (security->type() == SecurityType::kForex &&
+      data->data_type() == MarketDataType::kTick) {
+    forex::ForexTransactionModel* model =
+        dynamic_cast<forex::ForexTransactionModel*>(security->model());
+    if (model != NULL) {
+      model->OnData(data);
+    }
+  }
+  int id = security->holdings()->store_id();
+  if (id < 0) {
+    security->holdings()->UpdatePrice(data->value());
+    return;
+  }
+  slice_ids_.push_back(id);
+  slice_prices_.push_back(data->value());
+}
+
+Security* SecurityManager::GetSubscriptionSecurity(int subscription,
+                                                   const BaseData* data) {
+  if (subscription < 0) {
+    return Get(data->symbol());
+  }
+  if (subscription >= subscription_securities_.size()) {
+    subscription_securities_.resize(subscription + 1, NULL);
+  }
+  Security*& security = subscription_securities_[subscription];
+  if (security == NULL) {
+    security = Get(data->symbol());
+  }
+  return security;
+}
+
+void SecurityManager::AttachHoldings(Security* security) {
+  // A replaced security invalidates the resolved subscriptions
+  subscription_securities_.clear();
+  if (security == NULL || security->holdings() == NULL) {
+    return;
+  }
+  int id = holdings_store_.Register(security->symbol(), security->leverage(),
+                                    security->model());
+  security->holdings()->AttachStore(&holdings_store_, id);
+}
+
 void SecurityManager::Update(const DateTime& time, BaseData* data) {
   for (ManagerMap::iterator it = security_manager_.begin();
        it != security_manager_.end(); ++it) {
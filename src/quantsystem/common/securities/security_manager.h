@@ -32,6 +32,7 @@ using std::vector;
 #include "quantsystem/common/time/date_time.h"
 #include "quantsystem/common/data/base_data.h"
 #include "quantsystem/common/securities/security.h"
+#include "quantsystem/common/securities/security_holdings_store.h"
 
 namespace quantsystem {
 namespace securities {
@@ -44,6 +45,8 @@ class SecurityManager {
  public:
   typedef map<const string, Security*> ManagerMap;
   typedef map<const string, SecurityHolding*> HoldingMap;
+  // Data packets of one time slice keyed by their subscription index
+  typedef map<int, vector<BaseData*> > SubscriptionSlice;
   /**
    * Standard constructor.
    */
@@ -142,9 +145,61 @@ class SecurityManager {
    */
   void Update(const DateTime& time, BaseData* data);
 
+  /**
+   * Update the securities with every data packet of one time slice.
+   *
+   * The exchange frontier is moved once per security and the slice
+   * prices are applied to the holdings store in a single pass.
+   * @param time Time frontier
+   * @param slice Data packets sharing this time stamp
+   */
+  void Update(const DateTime& time, const vector<BaseData*>& slice);
+
+  /**
+   * Update the securities with the data of one time slice grouped by
+   * subscription.
+   *
+   * The security and holdings row of each subscription are resolved
+   * once, on its first data, instead of looking the symbol up for
+   * every data packet.
+   * @param time Time frontier
+   * @param slice Data packets sharing this time stamp by subscription
+   */
+  void Update(const DateTime& time, const SubscriptionSlice& slice);
+
+  /**
+   * Structure-of-arrays mirror of every security holding,
+   * used for the portfolio totals.
+   */
+  const SecurityHoldingsStore& holdings_store() const {
+    return holdings_store_;
+  }
+  SecurityHoldingsStore* mutable_holdings_store() { return &holdings_store_; }
+
  private:
   ManagerMap security_manager_;
   HoldingMap security_holdings_;
+  SecurityHoldingsStore holdings_store_;
+  // Scratch buffers for the batch update, kept to avoid reallocating
+  // on every time slice.
+  vector<int> slice_ids_;
+  vector<double> slice_prices_;
+  // Security of each subscription index, NULL until resolved. Cleared
+  // whenever a security is added or removed.
+  vector<Security*> subscription_securities_;
+  void AttachHoldings(Security* security);
+
+  /**
+   * Apply one data packet to its security and queue its price for
+   * the holdings store.
+   */
+  void AddSliceData(Security* security, BaseData* data);
+
+  /**
+   * Security receiving the data of a subscription.
+   * @return The security, or NULL if the symbol is not in the manager.
+   */
+  Security* GetSubscriptionSecurity(int subscription, const BaseData* data);
 };
 
 }  // namespace securities
@@ -0,0 +1,98 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <utility>
+using std::make_pair;
+using std::pair;
+#include "quantsystem/common/securities/security_margin_engine.h"
+namespace quantsystem {
+namespace securities {
+SecurityMarginEngine::SecurityMarginEngine()
+    : total_initial_margin_(0),
+      total_maintenance_margin_(0),
+      updates_since_resum_(0) {
+}
+
+SecurityMarginEngine::~SecurityMarginEngine() {
+}
+
+void SecurityMarginEngine::Register(int id, double leverage) {
+  DCHECK_LE(id, static_cast<int>(holdings_value_.size()));
+  if (id == holdings_value_.size()) {
+    holdings_value_.push_back(0);
+    initial_requirement_.push_back(1);
+    maintenance_requirement_.push_back(1);
+  }
+  double requirement = leverage > 0 ? 1 / leverage : 1;
+  holdings_value_[id] = 0;
+  initial_requirement_[id] = requirement;
+  maintenance_requirement_[id] = requirement;
+  Resum();
+}
+
+void SecurityMarginEngine::SetRequirements(int id, double initial,
+                                           double maintenance) {
+  if (initial <= 0 || maintenance <= 0 || maintenance > initial) {
+    LOG(ERROR) << "Invalid margin requirements: initial=" << initial <<
+        " maintenance=" << maintenance;
+    return;
+  }
+  initial_requirement_[id] = initial;
+  maintenance_requirement_[id] = maintenance;
+  Resum();
+}
+
+void SecurityMarginEngine::Resum() {
+  double initial = 0, maintenance = 0;
+  const int count = static_cast<int>(holdings_value_.size());
+  for (int i = 0; i < count; ++i) {
+    initial += holdings_value_[i] * initial_requirement_[i];
+    maintenance += holdings_value_[i] * maintenance_requirement_[i];
+  }
+  total_initial_margin_ = initial;
+  total_maintenance_margin_ = maintenance;
+  updates_since_resum_ = 0;
+}
+
+double SecurityMarginEngine::GetMarginCallRows(double portfolio_value,
+                                               vector<int>* ids) const {
+  if (!IsMarginCall(portfolio_value)) {
+    return 0;
+  }
+  double deficit = total_maintenance_margin_ - portfolio_value;
+  vector<pair<double, int> > rows;
+  const int count = static_cast<int>(holdings_value_.size());
+  for (int i = 0; i < count; ++i) {
+    if (holdings_value_[i] > 0) {
+      rows.push_back(make_pair(MaintenanceMargin(i), i));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  double freed = 0;
+  for (int i = static_cast<int>(rows.size()) - 1; i >= 0 && freed < deficit;
+       --i) {
+    ids->push_back(rows[i].second);
+    freed += rows[i].first;
+  }
+  return deficit;
+}
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,158 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_SECURITIES_SECURITY_MARGIN_ENGINE_H_
+#define QUANTSYSTEM_COMMON_SECURITIES_SECURITY_MARGIN_ENGINE_H_
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+namespace quantsystem {
+namespace securities {
+/**
+ * Incremental margin accounting for the rows of the holdings store.
+ *
+ * Every row caches its absolute holdings value and its initial and
+ * maintenance margin requirements (fractions of the holdings value).
+ * When a price or a quantity changes only the difference of that row
+ * is applied to the portfolio totals, so the margin used by the whole
+ * portfolio is always available in O(1). The totals are recomputed
+ * from the rows every kResumInterval updates to stop rounding drift.
+ * @ingroup CommonBaseSecurities
+ * @see SecurityHoldingsStore
+ */
+class SecurityMarginEngine {
+ public:
+  /**
+   * Standard constructor.
+   */
+  SecurityMarginEngine();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~SecurityMarginEngine();
+
+  /**
+   * Reset a row with the default requirements for this leverage:
+   * both initial and maintenance margin are 1 / leverage.
+   * The row is appended when id equals the number of rows.
+   * @param id Row id in the holdings store
+   * @param leverage Leverage of the security
+   */
+  void Register(int id, double leverage);
+
+  /**
+   * Override the margin requirements of a row.
+   * @param id Row id in the holdings store
+   * @param initial Initial margin as a fraction of the holdings value
+   * @param maintenance Maintenance margin as a fraction of the
+   * holdings value
+   */
+  void SetRequirements(int id, double initial, double maintenance);
+
+  /**
+   * Apply the new absolute holdings value of a row.
+   * @param id Row id in the holdings store
+   * @param absolute_holdings_value |quantity * price| of the row
+   */
+  void Update(int id, double absolute_holdings_value) {
+    double delta = absolute_holdings_value - holdings_value_[id];
+    if (delta == 0) {
+      return;
+    }
+    holdings_value_[id] = absolute_holdings_value;
+    total_initial_margin_ += delta * initial_requirement_[id];
+    total_maintenance_margin_ += delta * maintenance_requirement_[id];
+    if (++updates_since_resum_ >= kResumInterval) {
+      Resum();
+    }
+  }
+
+  /**
+   * Recompute the portfolio totals from the rows.
+   */
+  void Resum();
+
+  double initial_requirement(int id) const {
+    return initial_requirement_[id];
+  }
+  double maintenance_requirement(int id) const {
+    return maintenance_requirement_[id];
+  }
+
+  /**
+   * Initial margin used by the holdings of one row.
+   */
+  double InitialMargin(int id) const {
+    return holdings_value_[id] * initial_requirement_[id];
+  }
+
+  /**
+   * Maintenance margin used by the holdings of one row.
+   */
+  double MaintenanceMargin(int id) const {
+    return holdings_value_[id] * maintenance_requirement_[id];
+  }
+
+  /**
+   * Initial margin used by the whole portfolio.
+   */
+  double total_initial_margin() const { return total_initial_margin_; }
+
+  /**
+   * Maintenance margin used by the whole portfolio.
+   */
+  double total_maintenance_margin() const {
+    return total_maintenance_margin_;
+  }
+
+  /**
+   * Check the portfolio equity against the maintenance margin.
+   * @param portfolio_value Total portfolio value (equity)
+   * @return True if the equity no longer covers the maintenance margin.
+   */
+  bool IsMarginCall(double portfolio_value) const {
+    return total_maintenance_margin_ > 0 &&
+        portfolio_value < total_maintenance_margin_;
+  }
+
+  /**
+   * Rows that must be reduced to restore the maintenance margin,
+   * largest margin first, until the freed margin covers the deficit.
+   * @param portfolio_value Total portfolio value (equity)
+   * @param ids[out] Row ids to liquidate
+   * @return Margin deficit, 0 if there is no margin call.
+   */
+  double GetMarginCallRows(double portfolio_value, vector<int>* ids) const;
+
+ private:
+  static const int kResumInterval = 1024;
+  vector<double> holdings_value_;
+  vector<double> initial_requirement_;
+  vector<double> maintenance_requirement_;
+  double total_initial_margin_;
+  double total_maintenance_margin_;
+  int updates_since_resum_;
+
+  DISALLOW_COPY_AND_ASSIGN(SecurityMarginEngine);
+};
+}  // namespace securities
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_SECURITIES_SECURITY_MARGIN_ENGINE_H_
@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 using std::make_pair;
@@ -32,7 +33,8 @@ SecurityPortfolioManager::SecurityPortfolioManager(
       last_trade_profit_(0),
       profit_(0),
       securities_(security_manager),
-      transactions_(transactions) {
+      transactions_(transactions),
+      statistics_(NULL) {
 }
 
 SecurityPortfolioManager::~SecurityPortfolioManager() {
@@ -56,70 +58,27 @@ void SecurityPortfolioManager::Keys(vector<string>* keys) const {
 }
 
 double SecurityPortfolioManager::TotalUnleveredAbsoluteHoldingsCost() const {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double holdings_cost = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    holdings_cost += security->holdings()->AbsoluteHoldingsCost() /
-                    security->leverage();
-  }
-  return holdings_cost;
+  return securities_->holdings_store().TotalUnleveredAbsoluteHoldingsCost();
 }
 
 double SecurityPortfolioManager::TotalHoldingsValue() const {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double holdings_value = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    holdings_value += security->holdings()->AbsoluteHoldingsValue();
-  }
-  return holdings_value;
+  return securities_->holdings_store().TotalAbsoluteHoldingsValue();
 }
 
 double SecurityPortfolioManager::TotalUnrealisedProfit() const {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double profit = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    profit += security->holdings()->UnrealizedProfit();
-  }
-  return profit;
+  return securities_->holdings_store().TotalUnrealizedProfit();
 }
 
 double SecurityPortfolioManager::TotalFees() const {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double fees = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    fees += security->holdings()->total_fees();
-  }
-  return fees;
+  return securities_->holdings_store().TotalFees();
 }
 
 double SecurityPortfolioManager::TotalProfit()const  {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double profit = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    profit += security->holdings()->profit();
-  }
-  return profit;
+  return securities_->holdings_store().TotalProfit();
 }
 
 double SecurityPortfolioManager::TotalSaleVolume() const {
-  vector<const Security*> values;
-  securities_->Values(&values);
-  double volume = 0;
-  for (int i = 0; i < values.size(); ++i) {
-    const Security* security = values[i];
-    volume += security->holdings()->total_sale_volume();
-  }
-  return volume;
+  return securities_->holdings_store().TotalSaleVolume();
 }
 
 SecurityHolding* SecurityPortfolioManager::operator[] (
@@ -136,34 +95,69 @@ SecurityHolding* SecurityPortfolioManager::operator[] (
 double SecurityPortfolioManager::GetBuyingPower(
     const string& symbol,
     orders::OrderDirection direction) const {
-  Security* security = (*securities_)[symbol];
-  if (security == NULL) {
+  int id = securities_->holdings_store().GetId(symbol);
+  if (id < 0) {
     LOG(INFO) << "The security(" << symbol <<
         ") is not in the security manager";
     return 0;
   }
-  double holdings = security->holdings()->AbsoluteQuantity() *
-      security->Close();
-  double remaining_buying_power = cash_ * security->leverage();
-  if (direction == orders::kHold) {
-    return remaining_buying_power;
+  return GetBuyingPower(id, direction);
+}
+
+double SecurityPortfolioManager::GetBuyingPower(
+    int id,
+    orders::OrderDirection direction) const {
+  const SecurityHoldingsStore& store = securities_->holdings_store();
+  double quantity = store.quantity(id);
+  double remaining = MarginRemaining();
+  // Reversing a position frees the initial margin of the current
+  // holdings before the same size is taken on the other side.
+  if ((quantity > 0 && direction == orders::kSell) ||
+      (quantity < 0 && direction == orders::kBuy)) {
+    remaining += store.margin().InitialMargin(id) * 2;
   }
-  if (security->holdings()->IsLong()) {
-    switch (direction) {
-      case orders::kBuy:
-        return remaining_buying_power;
-      case orders::kSell:
-        return holdings * 2 + remaining_buying_power;
-    }
-  } else if (security->holdings()->IsShort()) {
-    switch (direction) {
-      case orders::kBuy:
-        return holdings * 2 + remaining_buying_power;
-      case orders::kSell:
-        return remaining_buying_power;
+  return remaining > 0 ? remaining : 0;
+}
+
+bool SecurityPortfolioManager::HasOpenMarginCallOrder(int id) {
+  map<int, int>::iterator found = margin_call_orders_.find(id);
+  if (found == margin_call_orders_.end()) {
+    return false;
+  }
+  switch (transactions_->GetOrderStatus(found->second)) {
+    case orders::kNew:
+    case orders::kUpdate:
+    case orders::kSubmitted:
+    case orders::kPartiallyFilled:
+      return true;
+    default:
+      margin_call_orders_.erase(found);
+      return false;
+  }
+}
+
+bool SecurityPortfolioManager::ScanForMarginCall(vector<int>* order_ids) {
+  const SecurityHoldingsStore& store = securities_->holdings_store();
+  vector<int> ids;
+  if (store.margin().GetMarginCallRows(TotalPortfolioValue(), &ids) <= 0) {
+    return false;
+  }
+  for (int i = 0; i < ids.size(); ++i) {
+    const string& symbol = store.symbol(ids[i]);
+    const Security* security = securities_->Get(symbol);
+    int quantity = -static_cast<int>(store.quantity(ids[i]));
+    if (security == NULL || quantity == 0 ||
+        HasOpenMarginCallOrder(ids[i])) {
+      continue;
     }
+    LOG(INFO) << "Margin call: liquidating " << symbol;
+    int order_id = transactions_->AddOrder(
+        new Order(symbol, quantity, orders::kMarket, security->Time(),
+                  store.price(ids[i]), "Margin Call"));
+    margin_call_orders_[ids[i]] = order_id;
+    order_ids->push_back(order_id);
   }
-  return remaining_buying_power;
+  return true;
 }
 
 void SecurityPortfolioManager::ProcessFill(const OrderEvent& fill) {
@@ -292,6 +286,9 @@ void SecurityPortfolioManager::AddTransactionRecord(
   }
   transactions_->transaction_record().insert(
       make_pair(done, transaction_profit_loss));
+  if (statistics_ != NULL) {
+    statistics_->AddTrade(transaction_profit_loss);
+  }
 }
 
 }  // namespace securities
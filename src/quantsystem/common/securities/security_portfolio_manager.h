@@ -20,6 +20,8 @@
 #ifndef QUANTSYSTEM_COMMON_SECURITIES_SECURITY_PORTFOLIO_MANAGER_H_
 #define QUANTSYSTEM_COMMON_SECURITIES_SECURITY_PORTFOLIO_MANAGER_H_
 
+#include <map>
+using std::map;
 #include <string>
 using std::string;
 #include "quantsystem/common/orders/order.h"
@@ -27,6 +29,7 @@ using std::string;
 #include "quantsystem/common/securities/security_manager.h"
 #include "quantsystem/common/securities/security_transaction_manager.h"
 #include "quantsystem/common/securities/security_holding.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
 
 namespace quantsystem {
 namespace securities {
@@ -76,6 +79,14 @@ class SecurityPortfolioManager {
    */
   void set_cash(const double& cash) { cash_ = cash; }
 
+  /**
+   * Set the online statistics fed with every closed trade.
+   * @param statistics Accumulator, NULL to stop feeding it.
+   */
+  void set_statistics(statistics::StatisticsAccumulator* statistics) {
+    statistics_ = statistics;
+  }
+
   /**
    * Absolute value of cash discounted from our total cash
    * by the holdings we own.
@@ -149,17 +160,51 @@ class SecurityPortfolioManager {
   SecurityHolding* operator[] (const string& symbol);
 
   /**
-   * The total buying power remaining after factoring in leverage.
+   * The margin available to a new order of this security.
    *
-   * Because each security has its own leverage the buying power
-   * is a function of security.
-   * Similarly the desired trade direction can impact the buying
-   * power available
+   * This is the portfolio value not yet committed as initial margin.
+   * Reversing a position first frees the initial margin of the current
+   * holdings and then needs the same margin again on the other side,
+   * so the desired trade direction can impact the buying power.
+   * Compare it with the order value times the initial margin
+   * requirement of the security.
    * @return Total buying power for this symbol
    */
   double GetBuyingPower(const string& symbol,
                         orders::OrderDirection direction = orders::kHold) const;
 
+  /**
+   * The margin available to a new order of the security in this row
+   * of the holdings store. Only reads the running totals of the store
+   * and of its margin, no symbol lookup and no walk over the holdings.
+   * @param id Row id in the holdings store
+   * @param direction Desired trade direction
+   * @return Total buying power for this security
+   * @see SecurityHoldingsStore::GetId
+   */
+  double GetBuyingPower(int id,
+                        orders::OrderDirection direction = orders::kHold) const;
+
+  /**
+   * True while the last margin call order of this row is open.
+   * @param id Row id in the holdings store
+   */
+  bool HasOpenMarginCallOrder(int id);
+
+  /**
+   * Initial margin used by all the holdings.
+   */
+  double TotalMarginUsed() const {
+    return securities_->holdings_store().margin().total_initial_margin();
+  }
+
+  /**
+   * Portfolio value not yet committed as initial margin.
+   */
+  double MarginRemaining() const {
+    return TotalPortfolioValue() - TotalMarginUsed();
+  }
+
   /**
    * Calculate the new average price after processing a
    * partial/complete order fill event. 
@@ -180,11 +225,23 @@ class SecurityPortfolioManager {
    * liquidate the portfolio immediately before the portfolio gets sub zero.
    * @return True for a margin call on the holdings.
    */
-  bool ScanForMarginCall() {
-    // TODO(shishougang)
-    return false;
+  bool ScanForMarginCall() const {
+    return securities_->holdings_store().margin().IsMarginCall(
+        TotalPortfolioValue());
   }
 
+  /**
+   * Scan for a margin call and submit the market orders that close the
+   * largest margin users until the maintenance margin is covered again.
+   *
+   * A row whose previous liquidation order is still open, queued or in
+   * flight under simulated latency, is skipped: the pending order
+   * already closes the whole position.
+   * @param order_ids[out] Ids of the submitted liquidation orders
+   * @return True for a margin call on the holdings.
+   */
+  bool ScanForMarginCall(vector<int>* order_ids);
+
   /**
    * Record the transaction value and time in a list to later be
    * processed for statistics creation.
@@ -206,6 +263,10 @@ class SecurityPortfolioManager {
   // Local access to the transactions collection for the portfolio
   // summation and updates.
   SecurityTransactionManager* transactions_;
+  // Online statistics of the run, not owned.
+  statistics::StatisticsAccumulator* statistics_;
+  // Last margin call order of each holdings store row
+  map<int, int> margin_call_orders_;
   double cash_;
   double last_trade_profit_;
   double profit_;
@@ -17,8 +17,8 @@
  * @}
  */
 
+#include <cmath>
 #include <cstdlib>
-#include <limits>
 #include "quantsystem/common/util/stl_util.h"
 #include "quantsystem/common/securities/security_transaction_manager.h"
 namespace quantsystem {
@@ -28,6 +28,7 @@ SecurityTransactionManager::SecurityTransactionManager(
     : order_id_(1),
       minimum_order_size_(0),
       minimum_order_quantity_(0),
+      simulated_latency_(false),
       securities_(security) {
 }
 
@@ -42,12 +43,35 @@ SecurityTransactionManager::~SecurityTransactionManager() {
 }
 
 int SecurityTransactionManager::AddOrder(Order* order) {
+  MutexLock lock(&mutex_);
   order->id = order_id_++;
   order->status = orders::kNew;
   order_queue_.push(order);
   return order->id;
 }
 
+void SecurityTransactionManager::AddOrders(const vector<Order*>& new_orders,
+                                           vector<int>* order_ids) {
+  MutexLock lock(&mutex_);
+  for (int i = 0; i < new_orders.size(); ++i) {
+    Order* order = new_orders[i];
+    order->id = order_id_++;
+    order->status = orders::kNew;
+    order_queue_.push(order);
+    order_ids->push_back(order->id);
+  }
+}
+
+bool SecurityTransactionManager::PopOrder(Order** order) {
+  MutexLock lock(&mutex_);
+  if (order_queue_.empty()) {
+    return false;
+  }
+  *order = order_queue_.front();
+  order_queue_.pop();
+  return true;
+}
+
 int SecurityTransactionManager::UpdateOrder(Order* order) {
   int id = order->id;
   if (securities_->Get(order->symbol) == NULL) {
@@ -92,26 +116,38 @@ void SecurityTransactionManager::RemoveOrder(int order_id) {
 bool SecurityTransactionManager::GetSufficientCapitalForOrder(
     const SecurityPortfolioManager* portfolio,
     const Order* order) {
-  if (abs(GetOrderRequiredBuyingPower(order)) >
-      portfolio->GetBuyingPower(order->symbol, order->Direction())) {
+  // One symbol lookup per check, the buying power is read from the
+  // running totals of the store.
+  int id = securities_->holdings_store().GetId(order->symbol);
+  if (id < 0) {
+    LOG(ERROR) << "Security manager donot have this symbol";
+    return false;
+  }
+  if (std::fabs(GetOrderRequiredBuyingPower(id, order)) >
+      portfolio->GetBuyingPower(id, order->Direction())) {
     return false;
   }
   return true;
 }
 
-double SecurityTransactionManager::GetOrderRequiredBuyingPower(const Order* order) const {
-  if (securities_->Get(order->symbol) == NULL) {
-    LOG(ERROR) << "Security manager donot have this symbol";
-    // Prevent all orders if finding error
-    return std::numeric_limits<double>::max();
+orders::OrderStatus SecurityTransactionManager::GetOrderStatus(
+    int order_id) {
+  MutexLock lock(&mutex_);
+  OrderMap::const_iterator found = orders_.find(order_id);
+  if (found != orders_.end()) {
+    return found->second->status;
   }
-  const double leverage = securities_->Get(order->symbol)->leverage();
-  if (leverage == 0) {
-    LOG(ERROR) << "symbol(" << order->symbol << ")'s leverage is 0";
-    // Prevent all orders if leverage is 0
-    return std::numeric_limits<double>::max();
+  // Issued but not yet taken by the transaction handler
+  if (order_id >= 0 && order_id < order_id_) {
+    return orders::kNew;
   }
-  return abs(order->value()) / leverage;
+  return orders::kNone;
+}
+
+double SecurityTransactionManager::GetOrderRequiredBuyingPower(
+    int id, const Order* order) const {
+  const SecurityMarginEngine& margin = securities_->holdings_store().margin();
+  return std::fabs(order->value()) * margin.initial_requirement(id);
 }
 }  // namespace securities
 }  // namespace quantsystem
@@ -116,6 +116,22 @@ class SecurityTransactionManager {
    */
   virtual int AddOrder(Order* order);
 
+  /**
+   * Add a batch of orders under a single lock acquisition.
+   * @param new_orders New order objects to add to processing list
+   * @param order_ids[out] New unique, increasing order ids, in the
+   * same order as the input
+   */
+  virtual void AddOrders(const vector<Order*>& new_orders,
+                         vector<int>* order_ids);
+
+  /**
+   * Pop the next order waiting for the transaction handler.
+   * @param order[out] Next order, ownership moves to the caller
+   * @return False if the queue is empty.
+   */
+  bool PopOrder(Order** order);
+
   /**
    * Update an order yet to be filled such as stop or limit orders.
    * Does not apply if the order is already fully filled.
@@ -142,6 +158,24 @@ class SecurityTransactionManager {
   bool GetSufficientCapitalForOrder(const SecurityPortfolioManager* portfolio,
                                     const Order* order);
 
+  /**
+   * Get the status of an order.
+   * @param order_id Id of the order
+   * @return Status of the order, kNew while it waits for the transaction
+   * handler, kNone if the id was never issued.
+   */
+  orders::OrderStatus GetOrderStatus(int order_id);
+
+  /**
+   * True when the transaction handler delays orders with simulated
+   * latency: fills then wait for the algorithm time to move on, so
+   * the algorithm must not block on them.
+   */
+  bool simulated_latency() const { return simulated_latency_; }
+  void set_simulated_latency(bool simulated_latency) {
+    simulated_latency_ = simulated_latency;
+  }
+
   /**
    * Get a new order id, and increment the internal counter.
    * @return New unique int order id.
@@ -159,14 +193,17 @@ class SecurityTransactionManager {
   int order_id_;
   double minimum_order_size_;
   int minimum_order_quantity_;
+  bool simulated_latency_;
   Mutex mutex_;
 
   /**
-   * Using leverage property of security find the required cash for this order.
+   * Using the initial margin requirement of the security find the
+   * required cash for this order.
+   * @param id Row id of the order symbol in the holdings store
    * @param order Order to check
    * @return Cash requred to purchase order
    */
-  double GetOrderRequiredBuyingPower(const Order* order) const;
+  double GetOrderRequiredBuyingPower(int id, const Order* order) const;
 };
 
 }  // namespace securities
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <glog/logging.h>
+#include <algorithm>
 #include "quantsystem/common/securities/security_transaction_model.h"
 namespace quantsystem {
 namespace securities {
@@ -28,23 +30,92 @@ SecurityTransactionModel::~SecurityTransactionModel() {
 
 OrderEvent* SecurityTransactionModel::Fill(
     const Security* asset, Order* order) {
+  switch (order->type) {
+    case orders::kLimit:
+      return LimitFill(asset, order);
+    case orders::kStopMarket:
+      return StopFill(asset, order);
+    case orders::kMarket:
+      return MarketFill(asset, order);
+    default:
+      LOG(ERROR) << "Unknown order type:" << order->type;
+      return new OrderEvent(*order);
+  }
 }
 
 double SecurityTransactionModel::GetSlippageApproximation(
     const Security* asset,
     const Order* order) {
+  return 0;
 }
 
 OrderEvent* SecurityTransactionModel::MarketFill(
     const Security* asset, Order* order) {
+  OrderEvent* fill = new OrderEvent(*order);
+  if (order->status == orders::kCanceled) {
+    return fill;
+  }
+  // Market orders fill at the current price plus the slippage
+  double slippage = GetSlippageApproximation(asset, order);
+  order->price = asset->Price();
+  order->status = orders::kFilled;
+  if (order->Direction() == orders::kBuy) {
+    order->price += slippage;
+  } else {
+    order->price -= slippage;
+  }
+  fill->status = order->status;
+  fill->fill_price = order->price;
+  fill->fill_quantity = order->quantity;
+  return fill;
 }
 
 OrderEvent* SecurityTransactionModel::StopFill(
     const Security* asset, Order* order) {
+  OrderEvent* fill = new OrderEvent(*order);
+  if (order->status == orders::kCanceled) {
+    return fill;
+  }
+  double slippage = GetSlippageApproximation(asset, order);
+  double price = asset->Price();
+  // Buy stops trigger above the stop price, sell stops below it
+  if (order->Direction() == orders::kBuy && price >= order->price) {
+    order->status = orders::kFilled;
+    order->price = price + slippage;
+  } else if (order->Direction() == orders::kSell && price <= order->price) {
+    order->status = orders::kFilled;
+    order->price = price - slippage;
+  }
+  if (order->status == orders::kFilled) {
+    fill->status = order->status;
+    fill->fill_price = order->price;
+    fill->fill_quantity = order->quantity;
+  }
+  return fill;
 }
 
 OrderEvent* SecurityTransactionModel::LimitFill(
     const Security* asset, Order* order) {
+  OrderEvent* fill = new OrderEvent(*order);
+  if (order->status == orders::kCanceled) {
+    return fill;
+  }
+  // The limit is crossed when the bar traded through it; the fill is at
+  // the limit price or better.
+  if (order->Direction() == orders::kBuy && asset->Low() < order->price) {
+    order->status = orders::kFilled;
+    order->price = std::min(asset->High(), order->price);
+  } else if (order->Direction() == orders::kSell &&
+             asset->High() > order->price) {
+    order->status = orders::kFilled;
+    order->price = std::max(asset->Low(), order->price);
+  }
+  if (order->status == orders::kFilled) {
+    fill->status = order->status;
+    fill->fill_price = order->price;
+    fill->fill_quantity = order->quantity;
+  }
+  return fill;
 }
 
 }  // namespace securities
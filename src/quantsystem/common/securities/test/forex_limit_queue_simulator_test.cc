@@ -0,0 +1,103 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include "quantsystem/common/securities/forex/forex_limit_queue_simulator.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace securities {
+namespace forex {
+namespace {
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+
+DateTime At(int second) {
+  return DateTime(kStart) + TimeSpan::FromSeconds(second);
+}
+
+Order MakeLimit(int id, int quantity, double limit) {
+  Order order("EURUSD", quantity, orders::kLimit, At(0), limit);
+  order.id = id;
+  return order;
+}
+}  // namespace
+
+TEST(ForexLimitQueueSimulator, TestQueueDepletionCountsOwnSize) {
+  // 300 units ahead of a new order, 100 traded per quote at its price
+  ForexLimitQueueSimulator simulator(300, 100);
+  simulator.AddQuote("EURUSD", At(0), 1.1000, 1.1002);
+  Order small = MakeLimit(1, 100, 1.1000);
+  Order large = MakeLimit(2, 200, 1.1000);
+  double fill_price = 0;
+  DateTime fill_time;
+  // Both join the queue at the bid
+  EXPECT_FALSE(simulator.Fill(&small, &fill_price, &fill_time));
+  EXPECT_FALSE(simulator.Fill(&large, &fill_price, &fill_time));
+  // A better bid does not trade the queue at the order price
+  simulator.AddQuote("EURUSD", At(1), 1.1001, 1.1003);
+  EXPECT_FALSE(simulator.Fill(&small, &fill_price, &fill_time));
+  EXPECT_FALSE(simulator.Fill(&large, &fill_price, &fill_time));
+  // The small order waits for 300 + 100 units, the large one 300 + 200
+  for (int i = 0; i < 3; ++i) {
+    simulator.AddQuote("EURUSD", At(2 + i), 1.1000, 1.1002);
+    EXPECT_FALSE(simulator.Fill(&small, &fill_price, &fill_time));
+    EXPECT_FALSE(simulator.Fill(&large, &fill_price, &fill_time));
+  }
+  simulator.AddQuote("EURUSD", At(5), 1.1000, 1.1002);
+  EXPECT_TRUE(simulator.Fill(&small, &fill_price, &fill_time));
+  EXPECT_DOUBLE_EQ(1.1000, fill_price);
+  EXPECT_FALSE(simulator.Fill(&large, &fill_price, &fill_time));
+  simulator.AddQuote("EURUSD", At(6), 1.1000, 1.1002);
+  EXPECT_TRUE(simulator.Fill(&large, &fill_price, &fill_time));
+  EXPECT_TRUE(At(6) == fill_time);
+  // No order rests on the symbol: its quotes are released
+  EXPECT_EQ(0, simulator.QuoteCount("EURUSD"));
+}
+
+TEST(ForexLimitQueueSimulator, TestFillTimeIsTheFillingQuote) {
+  ForexLimitQueueSimulator simulator(1000000, 1);
+  simulator.AddQuote("EURUSD", At(0), 1.1000, 1.1002);
+  double fill_price = 0;
+  DateTime fill_time;
+  // Marketable at once: filled at the last quote
+  Order marketable = MakeLimit(1, -100, 1.0999);
+  EXPECT_TRUE(simulator.Fill(&marketable, &fill_price, &fill_time));
+  EXPECT_DOUBLE_EQ(1.1000, fill_price);
+  EXPECT_TRUE(At(0) == fill_time);
+  // Below the bid: filled when the ask comes down to the limit
+  Order below = MakeLimit(2, 100, 1.0995);
+  // At the bid: filled when the bid trades through it
+  Order at_bid = MakeLimit(3, 100, 1.1000);
+  EXPECT_FALSE(simulator.Fill(&below, &fill_price, &fill_time));
+  EXPECT_FALSE(simulator.Fill(&at_bid, &fill_price, &fill_time));
+  simulator.AddQuote("EURUSD", At(1), 1.0998, 1.1000);
+  simulator.AddQuote("EURUSD", At(2), 1.0993, 1.0995);
+  simulator.AddQuote("EURUSD", At(3), 1.0990, 1.0992);
+  EXPECT_EQ(3, simulator.QuoteCount("EURUSD"));
+  // Checked after the fact, the fills keep the time of their quote
+  EXPECT_TRUE(simulator.Fill(&below, &fill_price, &fill_time));
+  EXPECT_DOUBLE_EQ(1.0995, fill_price);
+  EXPECT_TRUE(At(2) == fill_time);
+  EXPECT_TRUE(simulator.Fill(&at_bid, &fill_price, &fill_time));
+  EXPECT_DOUBLE_EQ(1.1000, fill_price);
+  EXPECT_TRUE(At(1) == fill_time);
+}
+}  // namespace forex
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,164 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/securities/security_manager.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace securities {
+namespace {
+using data::market::TradeBar;
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+const char* kSymbols[] = {"AAPL", "IBM", "MSFT", "SPY"};
+const int kSymbolCount = 4;
+
+// Portfolio totals computed the way the portfolio manager did before
+// the holdings store: a walk over every security holding.
+class Walk {
+ public:
+  double holdings_value;
+  double unlevered_cost;
+  double unrealized_profit;
+  double fees;
+  double profit;
+  double sale_volume;
+
+  explicit Walk(SecurityManager* securities)
+      : holdings_value(0),
+        unlevered_cost(0),
+        unrealized_profit(0),
+        fees(0),
+        profit(0),
+        sale_volume(0) {
+    vector<string> keys;
+    securities->Keys(&keys);
+    for (int i = 0; i < keys.size(); ++i) {
+      Security* security = securities->Get(keys[i]);
+      SecurityHolding* holding = security->holdings();
+      holdings_value += holding->AbsoluteHoldingsValue();
+      unlevered_cost += holding->AbsoluteHoldingsCost() /
+          security->leverage();
+      unrealized_profit += holding->UnrealizedProfit();
+      fees += holding->total_fees();
+      profit += holding->profit();
+      sale_volume += holding->total_sale_volume();
+    }
+  }
+};
+
+void AddSecurities(SecurityManager* securities) {
+  for (int i = 0; i < kSymbolCount; ++i) {
+    securities->Add(kSymbols[i], SecurityType::kEquity, Resolution::kMinute,
+                    true, 1 + i);
+  }
+}
+}  // namespace
+
+TEST(SecurityHoldingsStore, TestTotalsMatchHoldingWalk) {
+  SecurityManager securities;
+  AddSecurities(&securities);
+  for (int i = 0; i < kSymbolCount; ++i) {
+    SecurityHolding* holding = securities.Get(kSymbols[i])->holdings();
+    holding->SetHoldings(50 + 10 * i, i % 2 == 0 ? 100 * (i + 1) : -70 * i);
+    holding->AddNewFee(1.5 * i);
+    holding->AddNewProfit(20 - 15 * i);
+    holding->AddNewSale(1000 * i);
+  }
+  vector<TradeBar*> bars;
+  for (int step = 0; step < 5; ++step) {
+    SecurityManager::SubscriptionSlice slice;
+    for (int i = 0; i < kSymbolCount; ++i) {
+      double price = 55 + 10 * i + step * (i % 2 == 0 ? 1.25 : -0.75);
+      TradeBar* bar = new TradeBar(DateTime(kStart + 60 * step), kSymbols[i],
+                                   price, price, price, price, 100);
+      bars.push_back(bar);
+      slice[i].push_back(bar);
+    }
+    securities.Update(DateTime(kStart + 60 * step), slice);
+    const SecurityHoldingsStore& store = securities.holdings_store();
+    Walk walk(&securities);
+    EXPECT_DOUBLE_EQ(walk.holdings_value, store.TotalAbsoluteHoldingsValue());
+    EXPECT_DOUBLE_EQ(walk.unlevered_cost,
+                     store.TotalUnleveredAbsoluteHoldingsCost());
+    EXPECT_DOUBLE_EQ(walk.unrealized_profit, store.TotalUnrealizedProfit());
+    EXPECT_DOUBLE_EQ(walk.fees, store.TotalFees());
+    EXPECT_DOUBLE_EQ(walk.profit, store.TotalProfit());
+    EXPECT_DOUBLE_EQ(walk.sale_volume, store.TotalSaleVolume());
+  }
+  for (int i = 0; i < bars.size(); ++i) {
+    delete bars[i];
+  }
+}
+
+TEST(SecurityHoldingsStore, TestRunningTotalsFollowRowChanges) {
+  SecurityHoldingsStore store;
+  int aapl = store.Register("AAPL", 2, NULL);
+  int ibm = store.Register("IBM", 1, NULL);
+  store.set_holdings(aapl, 100, 10);
+  store.set_holdings(ibm, 50, -20);
+  vector<int> ids(1, ibm);
+  vector<double> prices(1);
+  double aapl_price = 0;
+  // Enough updates to go through several resums
+  for (int step = 0; step < 3000; ++step) {
+    aapl_price = 100 + (step % 17) * 0.1;
+    prices[0] = 50 - (step % 13) * 0.05;
+    store.set_price(aapl, aapl_price);
+    store.UpdatePrices(ids, prices);
+    ASSERT_NEAR((aapl_price - 100) * 10 + (prices[0] - 50) * -20,
+                store.TotalUnrealizedProfit(), 1e-9);
+    ASSERT_NEAR(1500, store.TotalUnleveredAbsoluteHoldingsCost(), 1e-9);
+  }
+  store.set_leverage(aapl, 4);
+  EXPECT_NEAR(1250, store.TotalUnleveredAbsoluteHoldingsCost(), 1e-9);
+  store.Unregister("IBM");
+  EXPECT_NEAR(250, store.TotalUnleveredAbsoluteHoldingsCost(), 1e-9);
+  EXPECT_NEAR((aapl_price - 100) * 10, store.TotalUnrealizedProfit(), 1e-9);
+  EXPECT_EQ(ibm, store.Register("IBM", 1, NULL));
+  EXPECT_NEAR(250, store.TotalUnleveredAbsoluteHoldingsCost(), 1e-9);
+  EXPECT_NEAR(store.TotalGrossUnrealizedProfit(),
+              store.TotalUnrealizedProfit(), 1e-9);
+}
+
+TEST(SecurityHoldingsStore, TestSubscriptionSliceFollowsReplacedSecurity) {
+  SecurityManager securities;
+  AddSecurities(&securities);
+  TradeBar first(DateTime(kStart), "IBM", 10, 10, 10, 10, 100);
+  SecurityManager::SubscriptionSlice slice;
+  slice[1].push_back(&first);
+  securities.Update(DateTime(kStart), slice);
+  EXPECT_EQ(10, securities.Get("IBM")->Price());
+  // Replacing the security must not leave the subscription on the
+  // deleted instance
+  securities.Add("IBM", SecurityType::kEquity, Resolution::kMinute, true, 2);
+  TradeBar second(DateTime(kStart + 60), "IBM", 12, 12, 12, 12, 100);
+  slice[1][0] = &second;
+  securities.Update(DateTime(kStart + 60), slice);
+  EXPECT_EQ(12, securities.Get("IBM")->Price());
+  int id = securities.holdings_store().GetId("IBM");
+  EXPECT_EQ(12, securities.holdings_store().price(id));
+}
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,87 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/securities/security_margin_engine.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace securities {
+TEST(SecurityMarginEngine, TestIncrementalMatchesRecomputation) {
+  const int kRows = 7;
+  SecurityMarginEngine margin;
+  vector<double> value(kRows, 0), initial(kRows), maintenance(kRows);
+  for (int i = 0; i < kRows; ++i) {
+    margin.Register(i, 1 + i % 4);
+    initial[i] = 1.0 / (1 + i % 4);
+    maintenance[i] = initial[i];
+  }
+  margin.SetRequirements(2, 0.5, 0.25);
+  initial[2] = 0.5;
+  maintenance[2] = 0.25;
+  // Enough updates to cross the periodic resum more than once
+  for (int step = 0; step < 5000; ++step) {
+    int id = (step * 3) % kRows;
+    value[id] = std::fabs(1000 * std::sin(step * 0.7) + 37.5 * id);
+    margin.Update(id, value[id]);
+    if (step % 97 == 0) {
+      double total_initial = 0, total_maintenance = 0;
+      for (int i = 0; i < kRows; ++i) {
+        total_initial += value[i] * initial[i];
+        total_maintenance += value[i] * maintenance[i];
+      }
+      EXPECT_NEAR(total_initial, margin.total_initial_margin(), 1e-6);
+      EXPECT_NEAR(total_maintenance, margin.total_maintenance_margin(),
+                  1e-6);
+    }
+  }
+  EXPECT_DOUBLE_EQ(value[2] * 0.5, margin.InitialMargin(2));
+  EXPECT_DOUBLE_EQ(value[2] * 0.25, margin.MaintenanceMargin(2));
+}
+
+TEST(SecurityMarginEngine, TestMarginCallRowsLargestFirst) {
+  SecurityMarginEngine margin;
+  for (int i = 0; i < 4; ++i) {
+    margin.Register(i, 2);
+  }
+  margin.Update(0, 1000);  // Maintenance margin 500
+  margin.Update(1, 4000);  // 2000
+  margin.Update(2, 2000);  // 1000
+  margin.Update(3, 0);
+  EXPECT_DOUBLE_EQ(3500, margin.total_maintenance_margin());
+  vector<int> ids;
+  EXPECT_EQ(0, margin.GetMarginCallRows(3500, &ids));
+  EXPECT_TRUE(ids.empty());
+  // A deficit of 1500 is covered by the largest row alone
+  EXPECT_DOUBLE_EQ(1500, margin.GetMarginCallRows(2000, &ids));
+  ASSERT_EQ(1, ids.size());
+  EXPECT_EQ(1, ids[0]);
+  // A deficit of 2500 needs the two largest rows, the empty row is never
+  // selected
+  ids.clear();
+  EXPECT_DOUBLE_EQ(2500, margin.GetMarginCallRows(1000, &ids));
+  ASSERT_EQ(2, ids.size());
+  EXPECT_EQ(1, ids[0]);
+  EXPECT_EQ(2, ids[1]);
+}
+}  // namespace securities
+}  // namespace quantsystem
@@ -0,0 +1,100 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/securities/security_manager.h"
+#include "quantsystem/common/securities/security_portfolio_manager.h"
+#include "quantsystem/common/securities/security_transaction_manager.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace securities {
+namespace {
+using data::market::TradeBar;
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+
+void SetPrice(SecurityManager* securities, const string& symbol,
+              double price) {
+  TradeBar bar(DateTime(kStart), symbol, price, price, price, price, 100);
+  vector<BaseData*> slice(1, &bar);
+  securities->Update(DateTime(kStart), slice);
+}
+}  // namespace
+
+TEST(SecurityPortfolioManager, TestBuyingPowerFromMarginRemaining) {
+  SecurityManager securities;
+  securities.Add("EURUSD", SecurityType::kForex, Resolution::kMinute, true,
+                 2);
+  SecurityTransactionManager transactions(&securities);
+  SecurityPortfolioManager portfolio(&securities, &transactions);
+  portfolio.set_cash(10000);
+  SetPrice(&securities, "EURUSD", 1.25);
+  int id = securities.holdings_store().GetId("EURUSD");
+  EXPECT_DOUBLE_EQ(10000, portfolio.GetBuyingPower(id, orders::kBuy));
+  // 8000 units bought at 2x leverage: 5000 of cash committed, 5000 of
+  // initial margin used
+  portfolio.set_cash(5000);
+  securities.Get("EURUSD")->holdings()->SetHoldings(1.25, 8000);
+  EXPECT_DOUBLE_EQ(5000, portfolio.TotalMarginUsed());
+  EXPECT_DOUBLE_EQ(5000, portfolio.MarginRemaining());
+  EXPECT_DOUBLE_EQ(5000, portfolio.GetBuyingPower(id, orders::kBuy));
+  // Reversing frees the margin of the long before taking the short
+  EXPECT_DOUBLE_EQ(15000, portfolio.GetBuyingPower("EURUSD", orders::kSell));
+  // An order of 10000 needs 5000 of initial margin at 2x leverage
+  Order order("EURUSD", 8000, orders::kMarket, DateTime(kStart), 1.25);
+  EXPECT_TRUE(transactions.GetSufficientCapitalForOrder(&portfolio, &order));
+  order.quantity = 8001;
+  EXPECT_FALSE(transactions.GetSufficientCapitalForOrder(&portfolio, &order));
+}
+
+TEST(SecurityPortfolioManager, TestMarginCallOrderNotRepeatedWhileOpen) {
+  SecurityManager securities;
+  securities.Add("EURUSD", SecurityType::kForex, Resolution::kMinute, true,
+                 2);
+  SecurityTransactionManager transactions(&securities);
+  SecurityPortfolioManager portfolio(&securities, &transactions);
+  portfolio.set_cash(-9000);
+  SetPrice(&securities, "EURUSD", 1.25);
+  securities.Get("EURUSD")->holdings()->SetHoldings(1.25, 8000);
+  // Equity of 1000 against a maintenance margin of 5000
+  vector<int> order_ids;
+  EXPECT_TRUE(portfolio.ScanForMarginCall(&order_ids));
+  ASSERT_EQ(1, order_ids.size());
+  // Still queued for the transaction handler: no second liquidation
+  order_ids.clear();
+  EXPECT_TRUE(portfolio.ScanForMarginCall(&order_ids));
+  EXPECT_TRUE(order_ids.empty());
+  // Submitted but not filled yet, e.g. under simulated latency
+  Order* order = NULL;
+  ASSERT_TRUE(transactions.PopOrder(&order));
+  EXPECT_EQ(-8000, order->quantity);
+  order->status = orders::kSubmitted;
+  transactions.orders()[order->id] = order;
+  EXPECT_TRUE(portfolio.ScanForMarginCall(&order_ids));
+  EXPECT_TRUE(order_ids.empty());
+  // Once the order is canceled the row can be liquidated again
+  order->status = orders::kCanceled;
+  EXPECT_TRUE(portfolio.ScanForMarginCall(&order_ids));
+  EXPECT_EQ(1, order_ids.size());
+}
+}  // namespace securities
+}  // namespace quantsystem
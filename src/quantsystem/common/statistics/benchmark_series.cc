@@ -0,0 +1,135 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <cmath>
+#include <utility>
+using std::make_pair;
+#include "quantsystem/common/statistics/benchmark_series.h"
+namespace quantsystem {
+namespace statistics {
+namespace {
+const time_t kSecondsPerDay = 24 * 60 * 60;
+}  // namespace
+
+BenchmarkSeries::BenchmarkSeries() {
+}
+
+BenchmarkSeries::~BenchmarkSeries() {
+}
+
+void BenchmarkSeries::Clear() {
+  closes_.clear();
+  has_bar_.clear();
+}
+
+bool BenchmarkSeries::AddClose(const DateTime& date, double close) {
+  if (closes_.empty()) {
+    start_ = date.Date();
+    closes_.push_back(close);
+    has_bar_.push_back(true);
+    return true;
+  }
+  int index = DayIndex(date);
+  if (index < size()) {
+    LOG(ERROR) << "Benchmark close of " << date.ToShortString() <<
+        " is not after the last close";
+    return false;
+  }
+  // Carry the last close over the days without a bar
+  closes_.resize(index, closes_.back());
+  has_bar_.resize(index, false);
+  closes_.push_back(close);
+  has_bar_.push_back(true);
+  return true;
+}
+
+bool BenchmarkSeries::GetClose(const DateTime& date, double* close) const {
+  if (closes_.empty()) {
+    return false;
+  }
+  int index = DayIndex(date);
+  if (index < 0) {
+    return false;
+  }
+  *close = closes_[index < size() ? index : size() - 1];
+  return true;
+}
+
+bool BenchmarkSeries::GetPerformance(const DateTime& from, const DateTime& to,
+                                     double* performance) const {
+  double previous, current;
+  if (!GetClose(from, &previous) || !GetClose(to, &current) ||
+      previous == 0) {
+    return false;
+  }
+  *performance = current / previous - 1;
+  return true;
+}
+
+int BenchmarkSeries::Align(const vector<DateTime>& dates,
+                           vector<double>* performance) const {
+  performance->resize(dates.size());
+  double* value = performance->data();
+  int aligned = 0;
+  double previous = 0;
+  for (size_t i = 0; i < dates.size(); ++i) {
+    double close;
+    if (!GetClose(dates[i], &close)) {
+      value[i] = 0;
+      continue;
+    }
+    value[i] = previous == 0 ? 0 : close / previous - 1;
+    previous = close;
+    ++aligned;
+  }
+  return aligned;
+}
+
+void BenchmarkSeries::Align(const vector<ChartPoint>& points,
+                            vector<double>* algorithm,
+                            vector<double>* benchmark) const {
+  vector<DateTime> dates;
+  dates.reserve(points.size());
+  algorithm->resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    dates.push_back(DateTime(static_cast<time_t>(points[i].x)));
+    (*algorithm)[i] = points[i].y / 100;
+  }
+  Align(dates, benchmark);
+}
+
+map<DateTime, double> BenchmarkSeries::ToMap() const {
+  map<DateTime, double> values;
+  for (int i = 0; i < size(); ++i) {
+    if (has_bar_[i]) {
+      values.insert(make_pair(
+          DateTime(start_.ToEpochTime() + i * kSecondsPerDay), closes_[i]));
+    }
+  }
+  return values;
+}
+
+int BenchmarkSeries::DayIndex(const DateTime& date) const {
+  time_t seconds = date.ToEpochTime() - start_.ToEpochTime();
+  return static_cast<int>(std::floor(static_cast<double>(seconds) /
+                                     kSecondsPerDay));
+}
+}  // namespace statistics
+}  // namespace quantsystem
@@ -0,0 +1,135 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_STATISTICS_BENCHMARK_SERIES_H_
+#define QUANTSYSTEM_COMMON_STATISTICS_BENCHMARK_SERIES_H_
+
+#include <map>
+using std::map;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/util/charting.h"
+namespace quantsystem {
+namespace statistics {
+/**
+ * Daily closes of the benchmark in a date indexed array.
+ *
+ * Index i of the array holds the close of the day start() + i days,
+ * days without a bar (weekends, holidays) hold the previous close, so
+ * the close on or before any date is a single array access. Aligning
+ * the benchmark to a performance series in date order is then one pass
+ * over the series.
+ * @ingroup CommonBaseStatistics
+ * @see StatisticsAccumulator
+ */
+class BenchmarkSeries {
+ public:
+  /**
+   * Standard constructor: empty series.
+   */
+  BenchmarkSeries();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~BenchmarkSeries();
+
+  /**
+   * Remove every close.
+   */
+  void Clear();
+
+  /**
+   * Append the close of a day. Days must be added in ascending order,
+   * the days skipped since the previous close take the previous close.
+   * @param date Day of the close, the time of day is ignored
+   * @param close Close price of the day
+   * @return False if the day is not after the last day of the series.
+   */
+  bool AddClose(const DateTime& date, double close);
+
+  /**
+   * Get the last close on or before a date.
+   * @param date Day of the close
+   * @param close[out] Close price
+   * @return False if the date is before the first close.
+   */
+  bool GetClose(const DateTime& date, double* close) const;
+
+  /**
+   * Benchmark return between the closes of two dates.
+   * @param from Day of the previous close
+   * @param to Day of the current close
+   * @param performance[out] Return as a fraction
+   * @return False if either date has no close.
+   */
+  bool GetPerformance(const DateTime& from, const DateTime& to,
+                      double* performance) const;
+
+  /**
+   * Daily benchmark returns aligned to the dates of a daily
+   * performance series, in one pass over the dates.
+   * @param dates Days of the performance series in ascending order
+   * @param performance[out] Return of the benchmark since the previous
+   * date, 0 for the first date and for dates without a close
+   * @return Number of dates with a benchmark close.
+   */
+  int Align(const vector<DateTime>& dates, vector<double>* performance) const;
+
+  /**
+   * Split a daily performance chart series, in percent, into the
+   * algorithm returns and the aligned benchmark returns as fractions,
+   * ready for Statistics::Beta, Alpha and the other benchmark ratios.
+   * @param points Daily performance points in ascending time order
+   * @param algorithm[out] Algorithm returns
+   * @param benchmark[out] Benchmark returns
+   */
+  void Align(const vector<ChartPoint>& points, vector<double>* algorithm,
+             vector<double>* benchmark) const;
+
+  /**
+   * Closes of the days with a bar as a date sorted map.
+   */
+  map<DateTime, double> ToMap() const;
+
+  bool empty() const { return closes_.empty(); }
+
+  /**
+   * Number of days covered, including the days without a bar.
+   */
+  int size() const { return static_cast<int>(closes_.size()); }
+
+  const DateTime& start() const { return start_; }
+
+ private:
+  DateTime start_;
+  // Close of every day since start_, carried forward on days without bar
+  vector<double> closes_;
+  // True for the days with their own bar
+  vector<bool> has_bar_;
+
+  /**
+   * Array index of a day, negative if before start_.
+   */
+  int DayIndex(const DateTime& date) const;
+};
+}  // namespace statistics
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_STATISTICS_BENCHMARK_SERIES_H_
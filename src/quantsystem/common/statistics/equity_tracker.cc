@@ -0,0 +1,107 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include "quantsystem/common/statistics/equity_tracker.h"
+namespace quantsystem {
+namespace statistics {
+EquityTracker::Day::Day()
+    : date(0),
+      open(0),
+      high(0),
+      low(0),
+      close(0),
+      max_drawdown(0) {
+}
+
+EquityTracker::EquityTracker() {
+  Reset();
+}
+
+EquityTracker::~EquityTracker() {
+}
+
+void EquityTracker::Reset() {
+  updates_ = 0;
+  time_ = 0;
+  equity_ = 0;
+  peak_ = 0;
+  peak_time_ = 0;
+  max_drawdown_ = 0;
+  max_drawdown_peak_time_ = 0;
+  max_drawdown_trough_time_ = 0;
+  max_drawdown_duration_ = 0;
+  day_ = Day();
+  last_day_ = Day();
+}
+
+bool EquityTracker::Update(int64 time, double equity) {
+  // Midnight of the day, rounded down for times before the epoch too
+  int64 date = time - time % kSecondsPerDay;
+  if (time % kSecondsPerDay < 0) {
+    date -= kSecondsPerDay;
+  }
+  bool new_day = false;
+  if (updates_ == 0) {
+    peak_ = equity;
+    peak_time_ = time;
+    StartDay(date, equity);
+  } else if (date != day_.date) {
+    last_day_ = day_;
+    StartDay(date, equity);
+    new_day = true;
+  }
+  ++updates_;
+  time_ = time;
+  equity_ = equity;
+  if (equity >= peak_) {
+    peak_ = equity;
+    peak_time_ = time;
+  } else {
+    double drawdown = peak_ > 0 ? (peak_ - equity) / peak_ : 0;
+    if (drawdown > max_drawdown_) {
+      max_drawdown_ = drawdown;
+      max_drawdown_peak_time_ = peak_time_;
+      max_drawdown_trough_time_ = time;
+    }
+    if (drawdown > day_.max_drawdown) {
+      day_.max_drawdown = drawdown;
+    }
+    if (time - peak_time_ > max_drawdown_duration_) {
+      max_drawdown_duration_ = time - peak_time_;
+    }
+  }
+  if (equity > day_.high) {
+    day_.high = equity;
+  } else if (equity < day_.low) {
+    day_.low = equity;
+  }
+  day_.close = equity;
+  return new_day;
+}
+
+void EquityTracker::StartDay(int64 date, double equity) {
+  day_.date = date;
+  day_.open = equity;
+  day_.high = equity;
+  day_.low = equity;
+  day_.close = equity;
+  day_.max_drawdown = 0;
+}
+}  // namespace statistics
+}  // namespace quantsystem
@@ -0,0 +1,152 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_STATISTICS_EQUITY_TRACKER_H_
+#define QUANTSYSTEM_COMMON_STATISTICS_EQUITY_TRACKER_H_
+
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/time/date_time.h"
+namespace quantsystem {
+namespace statistics {
+/**
+ * Running peak, drawdown and daily range of the equity curve.
+ *
+ * The tracker is meant to see the portfolio value of every time slice.
+ * Each update is a handful of comparisons and keeps no history: the
+ * running peak and its time, the maximum drawdown with its peak and
+ * trough times, the longest time spent below a peak and the open, high,
+ * low and close of the current day. When an update starts a new day
+ * the summary of the previous day is kept in last_day(), so callers
+ * can chart one point per day and still get drawdowns at the full data
+ * resolution.
+ * @ingroup CommonBaseStatistics
+ * @see StatisticsAccumulator
+ */
+class EquityTracker {
+ public:
+  /**
+   * Summary of the equity over one day.
+   */
+  class Day {
+   public:
+    int64 date;  // Epoch seconds of the midnight starting the day
+    double open;  // First equity of the day
+    double high;  // Highest equity of the day
+    double low;  // Lowest equity of the day
+    double close;  // Last equity of the day
+    double max_drawdown;  // Deepest drawdown of the day from the peak
+    Day();
+  };
+
+  /**
+   * Standard constructor: no equity yet.
+   */
+  EquityTracker();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~EquityTracker();
+
+  /**
+   * Forget every update.
+   */
+  void Reset();
+
+  /**
+   * Add the equity at a time. Times must not decrease.
+   * @param time Epoch seconds of the slice
+   * @param equity Total portfolio value
+   * @return True if the update started a new day, the previous day
+   * is then in last_day().
+   */
+  bool Update(int64 time, double equity);
+
+  bool Update(const DateTime& time, double equity) {
+    return Update(static_cast<int64>(time.ToEpochTime()), equity);
+  }
+
+  bool has_equity() const { return updates_ > 0; }
+  int64 updates() const { return updates_; }
+  double equity() const { return equity_; }
+  int64 time() const { return time_; }
+
+  /**
+   * Highest equity so far and the time it was reached.
+   */
+  double peak() const { return peak_; }
+  int64 peak_time() const { return peak_time_; }
+
+  /**
+   * Current drop from the peak as a fraction of the peak.
+   */
+  double drawdown() const {
+    return peak_ > 0 ? (peak_ - equity_) / peak_ : 0;
+  }
+
+  /**
+   * Largest drop from a running peak as a fraction of the peak, and
+   * the times of that peak and of the lowest equity after it.
+   */
+  double max_drawdown() const { return max_drawdown_; }
+  int64 max_drawdown_peak_time() const { return max_drawdown_peak_time_; }
+  int64 max_drawdown_trough_time() const {
+    return max_drawdown_trough_time_;
+  }
+
+  /**
+   * Seconds since the equity was last at its peak, 0 at a peak.
+   */
+  int64 drawdown_duration() const { return time_ - peak_time_; }
+
+  /**
+   * Longest time in seconds from a peak to the recovery of that peak,
+   * including the current drawdown.
+   */
+  int64 max_drawdown_duration() const { return max_drawdown_duration_; }
+
+  /**
+   * Summary of the current, unfinished, day.
+   */
+  const Day& day() const { return day_; }
+
+  /**
+   * Summary of the last finished day.
+   */
+  const Day& last_day() const { return last_day_; }
+
+ private:
+  static const int64 kSecondsPerDay = 24 * 60 * 60;
+  int64 updates_;
+  int64 time_;
+  double equity_;
+  double peak_;
+  int64 peak_time_;
+  double max_drawdown_;
+  int64 max_drawdown_peak_time_;
+  int64 max_drawdown_trough_time_;
+  int64 max_drawdown_duration_;
+  Day day_;
+  Day last_day_;
+
+  void StartDay(int64 date, double equity);
+};
+}  // namespace statistics
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_STATISTICS_EQUITY_TRACKER_H_
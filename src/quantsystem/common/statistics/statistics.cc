@@ -17,9 +17,35 @@
  * @}
  */
 
+#include <cmath>
+#include <algorithm>
+#include <utility>
+using std::make_pair;
 #include "quantsystem/common/statistics/statistics.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
 namespace quantsystem {
 namespace statistics {
+namespace {
+/**
+ * Feed the algorithm performance into the accumulator, paired with the
+ * benchmark performance of the same index when there is one.
+ */
+void AddPerformances(const vector<double>& algo_performance,
+                     const vector<double>& benchmark_performance,
+                     StatisticsAccumulator* accumulator) {
+  size_t paired = std::min(algo_performance.size(),
+                           benchmark_performance.size());
+  for (size_t i = 0; i < algo_performance.size(); ++i) {
+    if (i < paired) {
+      accumulator->AddPerformance(algo_performance[i],
+                                  benchmark_performance[i]);
+    } else {
+      accumulator->AddPerformance(algo_performance[i]);
+    }
+  }
+}
+}  // namespace
+
 Statistics::Statistics() {
 }
 
@@ -27,6 +53,9 @@ Statistics::~Statistics() {
 }
 
 Statistics::SortBenchmarkMap Statistics::Benchmark() {
+  // The engine loads the benchmark closes into a BenchmarkSeries paired
+  // with the StatisticsAccumulator, there is no static benchmark source.
+  return SortBenchmarkMap();
 }
 
 void Statistics::Generate(
@@ -35,66 +64,134 @@ void Statistics::Generate(
       const ChartPointVector& points_performance, double starting_cash,
       map<string, string>* statistics,
       double trading_days_per_year) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(starting_cash, trading_days_per_year);
+  for (const ChartPoint& point : points_equity) {
+    accumulator.AddEquity(DateTime(static_cast<time_t>(point.x)), point.y);
+  }
+  for (const ChartPoint& point : points_performance) {
+    accumulator.AddPerformance(point.y / 100);
+  }
+  for (SortBenchmarkMap::const_iterator it = profit_loss.begin();
+       it != profit_loss.end(); ++it) {
+    accumulator.AddTrade(it->second);
+  }
+  accumulator.GetStatistics(statistics);
 }
-  
+
 double Statistics::ProfitLossRatio(
     double average_win, double average_loss) {
+  if (average_loss == 0) {
+    return -1;
+  }
+  return average_win / std::fabs(average_loss);
 }
 
 double Statistics::DrawDown(
     SortBenchmarkMap equity_over_time, int rounding) {
+  StatisticsAccumulator accumulator;
+  for (SortBenchmarkMap::const_iterator it = equity_over_time.begin();
+       it != equity_over_time.end(); ++it) {
+    accumulator.AddEquity(it->first, it->second);
+  }
+  double scale = std::pow(10.0, rounding);
+  return std::round(accumulator.drawdown() * scale) / scale;
 }
 
 double Statistics::CompoundingAnnualPerformance(double starting_capital,
                                                 double final_capital,
                                                 double years) {
+  if (starting_capital <= 0 || years <= 0) {
+    return 0;
+  }
+  double growth = final_capital / starting_capital;
+  if (growth <= 0) {
+    return -1;
+  }
+  return std::pow(growth, 1 / years) - 1;
 }
 
 double Statistics::AnnualPerformance(const vector<double> performance,
                                      double trading_days_per_year) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(0, trading_days_per_year);
+  AddPerformances(performance, vector<double>(), &accumulator);
+  return accumulator.AnnualPerformance();
 }
 
 double Statistics::AnnualVariance(const vector<double>& performance,
                                   double trading_days_per_year) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(0, trading_days_per_year);
+  AddPerformances(performance, vector<double>(), &accumulator);
+  return accumulator.AnnualVariance();
 }
 
 double Statistics::AnnualStandardDeviation(
     const vector<double>& performance,
     double trading_days_per_year) {
+  return std::sqrt(AnnualVariance(performance, trading_days_per_year));
 }
 
 double Statistics::Beta(const vector<double>& algo_performance,
                         const vector<double>& benchmark_performance) {
+  StatisticsAccumulator accumulator;
+  AddPerformances(algo_performance, benchmark_performance, &accumulator);
+  return accumulator.Beta();
 }
 
 double Statistics::Alpha(const vector<double>& algo_performance,
                          const vector<double>& benchmark_performance,
                          double risk_free_rate) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(0, 252, risk_free_rate);
+  AddPerformances(algo_performance, benchmark_performance, &accumulator);
+  return accumulator.Alpha();
 }
 
 double Statistics::TrackingError(
     const vector<double>& algo_performance,
     const vector<double>& benchmark_performance) {
+  StatisticsAccumulator accumulator;
+  AddPerformances(algo_performance, benchmark_performance, &accumulator);
+  return accumulator.TrackingError();
 }
 
 double Statistics::InformationRatio(
     const vector<double>& algo_performance,
     const vector<double>& benchmark_performance) {
+  StatisticsAccumulator accumulator;
+  AddPerformances(algo_performance, benchmark_performance, &accumulator);
+  return accumulator.InformationRatio();
 }
 
 double Statistics::SharpeRatio(
     const vector<double>& algo_performance,
     double risk_free_rate) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(0, 252, risk_free_rate);
+  AddPerformances(algo_performance, vector<double>(), &accumulator);
+  return accumulator.SharpeRatio();
 }
 
 double Statistics::TreynorRatio(
     const vector<double>& algo_performance,
     const vector<double>& benchmark_performance,
     double risk_free_rate) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(0, 252, risk_free_rate);
+  AddPerformances(algo_performance, benchmark_performance, &accumulator);
+  return accumulator.TreynorRatio();
 }
 
 Statistics::SortBenchmarkMap Statistics::ChartPointToMap(
     vector<ChartPoint> points) {
+  SortBenchmarkMap values;
+  for (const ChartPoint& point : points) {
+    values.insert(make_pair(DateTime(static_cast<time_t>(point.x)),
+                            point.y));
+  }
+  return values;
 }
 
 }  // namespace statistics
@@ -0,0 +1,307 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include "quantsystem/common/base/stringprintf.h"
+#include "quantsystem/common/statistics/statistics.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
+namespace quantsystem {
+namespace statistics {
+namespace {
+string FormatPercent(double value) {
+  return StringPrintf("%.3f%%", value * 100);
+}
+
+string FormatRatio(double value) {
+  return StringPrintf("%.3f", value);
+}
+}  // namespace
+
+StatisticsAccumulator::StatisticsAccumulator()
+    : benchmark_(NULL) {
+  Initialize(0);
+}
+
+StatisticsAccumulator::~StatisticsAccumulator() {
+}
+
+void StatisticsAccumulator::Initialize(double starting_capital,
+                                       double trading_days_per_year,
+                                       double risk_free_rate) {
+  starting_capital_ = starting_capital;
+  trading_days_per_year_ = trading_days_per_year;
+  risk_free_rate_ = risk_free_rate;
+  has_performance_date_ = false;
+  first_time_ = DateTime();
+  last_time_ = DateTime();
+  last_equity_ = starting_capital;
+  equity_tracker_.Reset();
+  has_equity_ = false;
+  trading_days_ = 0;
+  mean_ = 0;
+  m2_ = 0;
+  downside_sum_squares_ = 0;
+  benchmark_days_ = 0;
+  benchmark_mean_ = 0;
+  benchmark_m2_ = 0;
+  comoment_ = 0;
+  excess_mean_ = 0;
+  excess_m2_ = 0;
+  algorithm_benchmark_mean_ = 0;
+  MutexLock lock(&trade_mutex_);
+  trades_ = TradeCounts();
+}
+
+bool StatisticsAccumulator::AddEquity(const DateTime& time, double equity) {
+  if (!has_equity_) {
+    first_time_ = time;
+    has_equity_ = true;
+  }
+  last_time_ = time;
+  last_equity_ = equity;
+  return equity_tracker_.Update(time, equity);
+}
+
+void StatisticsAccumulator::AddPerformance(double performance) {
+  ++trading_days_;
+  double delta = performance - mean_;
+  mean_ += delta / trading_days_;
+  m2_ += delta * (performance - mean_);
+  if (performance < 0) {
+    downside_sum_squares_ += performance * performance;
+  }
+}
+
+void StatisticsAccumulator::AddPerformance(const DateTime& date,
+                                           double performance) {
+  double benchmark_performance;
+  bool paired = benchmark_ != NULL && has_performance_date_ &&
+      benchmark_->GetPerformance(last_performance_date_, date,
+                                 &benchmark_performance);
+  last_performance_date_ = date;
+  has_performance_date_ = true;
+  if (paired) {
+    AddPerformance(performance, benchmark_performance);
+  } else {
+    AddPerformance(performance);
+  }
+}
+
+void StatisticsAccumulator::AddPerformance(double performance,
+                                           double benchmark_performance) {
+  AddPerformance(performance);
+  ++benchmark_days_;
+  double delta = performance - algorithm_benchmark_mean_;
+  algorithm_benchmark_mean_ += delta / benchmark_days_;
+  double benchmark_delta = benchmark_performance - benchmark_mean_;
+  benchmark_mean_ += benchmark_delta / benchmark_days_;
+  double benchmark_residual = benchmark_performance - benchmark_mean_;
+  benchmark_m2_ += benchmark_delta * benchmark_residual;
+  comoment_ += delta * benchmark_residual;
+  double excess = performance - benchmark_performance;
+  double excess_delta = excess - excess_mean_;
+  excess_mean_ += excess_delta / benchmark_days_;
+  excess_m2_ += excess_delta * (excess - excess_mean_);
+}
+
+void StatisticsAccumulator::AddTrade(double profit_loss) {
+  MutexLock lock(&trade_mutex_);
+  if (profit_loss > 0) {
+    ++trades_.wins;
+    trades_.total_win += profit_loss;
+  } else {
+    ++trades_.losses;
+    trades_.total_loss += profit_loss;
+  }
+}
+
+StatisticsAccumulator::TradeCounts
+StatisticsAccumulator::TradeSnapshot() const {
+  MutexLock lock(&trade_mutex_);
+  return trades_;
+}
+
+int StatisticsAccumulator::total_trades() const {
+  const TradeCounts trades = TradeSnapshot();
+  return trades.wins + trades.losses;
+}
+
+double StatisticsAccumulator::AnnualPerformance() const {
+  return mean_ * trading_days_per_year_;
+}
+
+double StatisticsAccumulator::AnnualVariance() const {
+  if (trading_days_ < 2) {
+    return 0;
+  }
+  return m2_ / (trading_days_ - 1) * trading_days_per_year_;
+}
+
+double StatisticsAccumulator::AnnualStandardDeviation() const {
+  return std::sqrt(AnnualVariance());
+}
+
+double StatisticsAccumulator::CompoundingAnnualPerformance() const {
+  if (!has_equity_) {
+    return 0;
+  }
+  double years = (last_time_ - first_time_).TotalDays() / 365.25;
+  return Statistics::CompoundingAnnualPerformance(starting_capital_,
+                                                  last_equity_, years);
+}
+
+double StatisticsAccumulator::NetProfit() const {
+  if (starting_capital_ == 0) {
+    return 0;
+  }
+  return last_equity_ / starting_capital_ - 1;
+}
+
+double StatisticsAccumulator::SharpeRatio() const {
+  double deviation = AnnualStandardDeviation();
+  if (deviation == 0) {
+    return 0;
+  }
+  return (AnnualPerformance() - risk_free_rate_) / deviation;
+}
+
+double StatisticsAccumulator::SortinoRatio() const {
+  if (trading_days_ == 0 || downside_sum_squares_ == 0) {
+    return 0;
+  }
+  double downside_deviation = std::sqrt(
+      downside_sum_squares_ / trading_days_ * trading_days_per_year_);
+  return (AnnualPerformance() - risk_free_rate_) / downside_deviation;
+}
+
+double StatisticsAccumulator::Beta() const {
+  if (benchmark_m2_ == 0) {
+    return 0;
+  }
+  return comoment_ / benchmark_m2_;
+}
+
+double StatisticsAccumulator::Alpha() const {
+  if (benchmark_days_ == 0) {
+    return 0;
+  }
+  double algorithm_annual = algorithm_benchmark_mean_ * trading_days_per_year_;
+  double benchmark_annual = benchmark_mean_ * trading_days_per_year_;
+  return algorithm_annual - (risk_free_rate_ + Beta() *
+                             (benchmark_annual - risk_free_rate_));
+}
+
+double StatisticsAccumulator::TrackingError() const {
+  if (benchmark_days_ < 2) {
+    return 0;
+  }
+  return std::sqrt(excess_m2_ / (benchmark_days_ - 1) *
+                   trading_days_per_year_);
+}
+
+double StatisticsAccumulator::InformationRatio() const {
+  double tracking_error = TrackingError();
+  if (tracking_error == 0) {
+    return 0;
+  }
+  return excess_mean_ * trading_days_per_year_ / tracking_error;
+}
+
+double StatisticsAccumulator::TreynorRatio() const {
+  double beta = Beta();
+  if (beta == 0) {
+    return 0;
+  }
+  return (AnnualPerformance() - risk_free_rate_) / beta;
+}
+
+double StatisticsAccumulator::WinRate() const {
+  return TradeSnapshot().WinRate();
+}
+
+double StatisticsAccumulator::LossRate() const {
+  return TradeSnapshot().LossRate();
+}
+
+double StatisticsAccumulator::AverageWin() const {
+  return TradeSnapshot().AverageWin();
+}
+
+double StatisticsAccumulator::AverageLoss() const {
+  return TradeSnapshot().AverageLoss();
+}
+
+double StatisticsAccumulator::Expectancy() const {
+  return TradeSnapshot().Expectancy();
+}
+
+double StatisticsAccumulator::TradeCounts::WinRate() const {
+  int total = wins + losses;
+  return total == 0 ? 0 : static_cast<double>(wins) / total;
+}
+
+double StatisticsAccumulator::TradeCounts::LossRate() const {
+  int total = wins + losses;
+  return total == 0 ? 0 : static_cast<double>(losses) / total;
+}
+
+double StatisticsAccumulator::TradeCounts::AverageWin() const {
+  return wins == 0 ? 0 : total_win / wins;
+}
+
+double StatisticsAccumulator::TradeCounts::AverageLoss() const {
+  return losses == 0 ? 0 : total_loss / losses;
+}
+
+double StatisticsAccumulator::TradeCounts::Expectancy() const {
+  return WinRate() * Statistics::ProfitLossRatio(AverageWin(), AverageLoss()) -
+      LossRate();
+}
+
+void StatisticsAccumulator::GetStatistics(
+    map<string, string>* statistics) const {
+  double capital = starting_capital_ == 0 ? 1 : starting_capital_;
+  // One copy so the trade statistics agree while trades keep closing
+  const TradeCounts trades = TradeSnapshot();
+  (*statistics)["Total Trades"] = std::to_string(trades.wins + trades.losses);
+  (*statistics)["Average Win"] = FormatPercent(trades.AverageWin() / capital);
+  (*statistics)["Average Loss"] =
+      FormatPercent(trades.AverageLoss() / capital);
+  (*statistics)["Compounding Annual Return"] =
+      FormatPercent(CompoundingAnnualPerformance());
+  (*statistics)["Drawdown"] = FormatPercent(drawdown());
+  (*statistics)["Expectancy"] = FormatRatio(trades.Expectancy());
+  (*statistics)["Net Profit"] = FormatPercent(NetProfit());
+  (*statistics)["Sharpe Ratio"] = FormatRatio(SharpeRatio());
+  (*statistics)["Sortino Ratio"] = FormatRatio(SortinoRatio());
+  (*statistics)["Loss Rate"] = FormatPercent(trades.LossRate());
+  (*statistics)["Win Rate"] = FormatPercent(trades.WinRate());
+  (*statistics)["Profit-Loss Ratio"] = FormatRatio(
+      Statistics::ProfitLossRatio(trades.AverageWin(), trades.AverageLoss()));
+  (*statistics)["Alpha"] = FormatRatio(Alpha());
+  (*statistics)["Beta"] = FormatRatio(Beta());
+  (*statistics)["Annual Standard Deviation"] =
+      FormatRatio(AnnualStandardDeviation());
+  (*statistics)["Annual Variance"] = FormatRatio(AnnualVariance());
+  (*statistics)["Information Ratio"] = FormatRatio(InformationRatio());
+  (*statistics)["Tracking Error"] = FormatRatio(TrackingError());
+  (*statistics)["Treynor Ratio"] = FormatRatio(TreynorRatio());
+}
+}  // namespace statistics
+}  // namespace quantsystem
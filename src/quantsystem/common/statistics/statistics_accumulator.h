@@ -0,0 +1,285 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_STATISTICS_STATISTICS_ACCUMULATOR_H_
+#define QUANTSYSTEM_COMMON_STATISTICS_STATISTICS_ACCUMULATOR_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/base/mutex.h"
+#include "quantsystem/common/statistics/benchmark_series.h"
+#include "quantsystem/common/statistics/equity_tracker.h"
+#include "quantsystem/common/time/date_time.h"
+namespace quantsystem {
+namespace statistics {
+/**
+ * Online accumulator of the backtest statistics.
+ *
+ * The accumulator is fed while the algorithm runs: every equity sample
+ * updates the running peak, drawdowns and daily range of the
+ * EquityTracker, every daily performance updates the Welford moments
+ * of the algorithm returns, of the benchmark returns and of their
+ * difference, and every closed trade updates the win and loss
+ * counters. Each update is O(1) and no history is kept, so the
+ * statistics are available at any time of the run, e.g. as live
+ * runtime statistics, and instantly at the end.
+ *
+ * The trades are closed by the transaction thread while the other
+ * samples and the reads come from the algorithm thread: the trade
+ * counters are guarded by their own mutex.
+ * @ingroup CommonBaseStatistics
+ * @see Statistics
+ */
+class StatisticsAccumulator {
+ public:
+  /**
+   * Standard constructor: no samples, starting capital set by
+   * Initialize.
+   */
+  StatisticsAccumulator();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~StatisticsAccumulator();
+
+  /**
+   * Clear every sample and set the parameters of the run.
+   * @param starting_capital Amount of starting cash in USD
+   * @param trading_days_per_year Number of trading days per year
+   * @param risk_free_rate Annual risk free rate of return
+   */
+  void Initialize(double starting_capital,
+                  double trading_days_per_year = 252,
+                  double risk_free_rate = 0);
+
+  /**
+   * Set the benchmark paired with the dated daily performances.
+   * @param benchmark Daily benchmark closes, not owned, NULL for none
+   */
+  void set_benchmark(const BenchmarkSeries* benchmark) {
+    benchmark_ = benchmark;
+  }
+
+  /**
+   * Add a sample of the portfolio value.
+   * @param time Time of the sample
+   * @param equity Total portfolio value
+   * @return True if the sample started a new day, the summary of the
+   * previous day is then in equity_tracker().last_day().
+   */
+  bool AddEquity(const DateTime& time, double equity);
+
+  /**
+   * Add the performance of one day without a benchmark.
+   * @param performance Daily return as a fraction, 0.01 is 1%
+   */
+  void AddPerformance(double performance);
+
+  /**
+   * Add the performance of one day, paired with the benchmark return
+   * since the previous dated performance when the benchmark has a close
+   * for both days.
+   * @param date Day of the performance
+   * @param performance Daily return as a fraction
+   */
+  void AddPerformance(const DateTime& date, double performance);
+
+  /**
+   * Add the performance of one day together with the benchmark
+   * performance of the same day.
+   * @param performance Daily return as a fraction
+   * @param benchmark_performance Benchmark daily return as a fraction
+   */
+  void AddPerformance(double performance, double benchmark_performance);
+
+  /**
+   * Add the profit or loss of a closed trade, from any thread.
+   * @param profit_loss Profit of the trade net of fees
+   */
+  void AddTrade(double profit_loss);
+
+  int trading_days() const { return trading_days_; }
+  int benchmark_days() const { return benchmark_days_; }
+  int total_trades() const;
+  double starting_capital() const { return starting_capital_; }
+  double final_capital() const { return last_equity_; }
+
+  /**
+   * Largest drop from a running peak as a fraction of the peak.
+   */
+  double drawdown() const { return equity_tracker_.max_drawdown(); }
+
+  /**
+   * Peak, drawdown and daily range of the equity samples.
+   */
+  const EquityTracker& equity_tracker() const { return equity_tracker_; }
+
+  /**
+   * Average daily return multiplied by the trading days per year.
+   */
+  double AnnualPerformance() const;
+
+  /**
+   * Sample variance of the daily returns multiplied by the trading
+   * days per year.
+   */
+  double AnnualVariance() const;
+
+  /**
+   * Square root of the annual variance.
+   */
+  double AnnualStandardDeviation() const;
+
+  /**
+   * Annual compounded return from the starting capital to the last
+   * equity sample over the time between the first and last sample.
+   */
+  double CompoundingAnnualPerformance() const;
+
+  /**
+   * Final capital over starting capital less one.
+   */
+  double NetProfit() const;
+
+  /**
+   * Excess annual return per unit of annual standard deviation.
+   */
+  double SharpeRatio() const;
+
+  /**
+   * Excess annual return per unit of annual downside deviation,
+   * the deviation of the negative daily returns from zero.
+   */
+  double SortinoRatio() const;
+
+  /**
+   * Covariance of the algorithm and benchmark returns divided by the
+   * benchmark variance.
+   */
+  double Beta() const;
+
+  /**
+   * Annual return in excess of the return explained by beta.
+   */
+  double Alpha() const;
+
+  /**
+   * Annualized standard deviation of the algorithm returns less
+   * the benchmark returns.
+   */
+  double TrackingError() const;
+
+  /**
+   * Annual return in excess of the benchmark per unit of tracking error.
+   */
+  double InformationRatio() const;
+
+  /**
+   * Excess annual return per unit of beta.
+   */
+  double TreynorRatio() const;
+
+  /**
+   * Fraction of the closed trades with a profit.
+   */
+  double WinRate() const;
+
+  /**
+   * Fraction of the closed trades with a loss.
+   */
+  double LossRate() const;
+
+  /**
+   * Average profit of the winning trades.
+   */
+  double AverageWin() const;
+
+  /**
+   * Average loss of the losing trades, a negative value.
+   */
+  double AverageLoss() const;
+
+  /**
+   * Win rate times the profit loss ratio less the loss rate.
+   */
+  double Expectancy() const;
+
+  /**
+   * Fill the map with the formatted statistics of the run so far.
+   * @param statistics[out] Statistic name to formatted value
+   */
+  void GetStatistics(map<string, string>* statistics) const;
+
+ private:
+  double starting_capital_;
+  double trading_days_per_year_;
+  double risk_free_rate_;
+  const BenchmarkSeries* benchmark_;
+  DateTime last_performance_date_;
+  bool has_performance_date_;
+  // Equity curve
+  DateTime first_time_;
+  DateTime last_time_;
+  double last_equity_;
+  EquityTracker equity_tracker_;
+  bool has_equity_;
+  // Welford moments of the daily returns
+  int trading_days_;
+  double mean_;
+  double m2_;
+  double downside_sum_squares_;
+  // Welford comoments of the days with a benchmark
+  int benchmark_days_;
+  double benchmark_mean_;
+  double benchmark_m2_;
+  double comoment_;
+  double excess_mean_;
+  double excess_m2_;
+  double algorithm_benchmark_mean_;
+  // Counters of the closed trades
+  struct TradeCounts {
+    int wins;
+    int losses;
+    double total_win;
+    double total_loss;
+
+    TradeCounts() : wins(0), losses(0), total_win(0), total_loss(0) {}
+    double WinRate() const;
+    double LossRate() const;
+    double AverageWin() const;
+    double AverageLoss() const;
+    double Expectancy() const;
+  };
+  mutable Mutex trade_mutex_;
+  TradeCounts trades_ GUARDED_BY(trade_mutex_);
+
+  /**
+   * Consistent copy of the trade counters.
+   */
+  TradeCounts TradeSnapshot() const;
+
+  DISALLOW_COPY_AND_ASSIGN(StatisticsAccumulator);
+};
+}  // namespace statistics
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_STATISTICS_STATISTICS_ACCUMULATOR_H_
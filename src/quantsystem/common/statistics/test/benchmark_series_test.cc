@@ -0,0 +1,86 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/statistics/benchmark_series.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/time/time_span.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace statistics {
+TEST(BenchmarkSeries, TestCarriesClosesOverMissingDays) {
+  BenchmarkSeries series;
+  DateTime friday(2014, 1, 3);
+  DateTime monday = friday + TimeSpan::FromDays(3);
+  EXPECT_TRUE(series.AddClose(friday, 100));
+  EXPECT_TRUE(series.AddClose(monday + TimeSpan::FromHours(16), 110));
+  EXPECT_FALSE(series.AddClose(friday, 90));
+  EXPECT_EQ(4, series.size());
+
+  double close;
+  EXPECT_FALSE(series.GetClose(friday - TimeSpan::FromDays(1), &close));
+  EXPECT_TRUE(series.GetClose(friday + TimeSpan::FromDays(1), &close));
+  EXPECT_EQ(100, close);
+  EXPECT_TRUE(series.GetClose(monday + TimeSpan::FromDays(10), &close));
+  EXPECT_EQ(110, close);
+  EXPECT_EQ(2, series.ToMap().size());
+
+  // Saturday has no bar: its return is 0 and Monday's is from Friday
+  vector<DateTime> dates;
+  dates.push_back(friday - TimeSpan::FromDays(1));
+  dates.push_back(friday);
+  dates.push_back(friday + TimeSpan::FromDays(1));
+  dates.push_back(monday);
+  vector<double> performance;
+  EXPECT_EQ(3, series.Align(dates, &performance));
+  ASSERT_EQ(4, performance.size());
+  EXPECT_EQ(0, performance[0]);
+  EXPECT_EQ(0, performance[1]);
+  EXPECT_EQ(0, performance[2]);
+  EXPECT_NEAR(0.1, performance[3], 1e-12);
+}
+
+TEST(BenchmarkSeries, TestPairsDatedPerformance) {
+  BenchmarkSeries series;
+  DateTime date(2014, 1, 1);
+  double closes[] = {100, 102, 99.96, 101.9592};
+  for (double close : closes) {
+    series.AddClose(date, close);
+    date += TimeSpan::FromDays(1);
+  }
+  StatisticsAccumulator accumulator;
+  accumulator.set_benchmark(&series);
+  date = DateTime(2014, 1, 1);
+  // The algorithm returns are twice the benchmark returns
+  double performance[] = {0, 0.04, -0.04, 0.04};
+  for (double value : performance) {
+    accumulator.AddPerformance(date, value);
+    date += TimeSpan::FromDays(1);
+  }
+  EXPECT_EQ(4, accumulator.trading_days());
+  EXPECT_EQ(3, accumulator.benchmark_days());
+  EXPECT_NEAR(2, accumulator.Beta(), 1e-9);
+}
+}  // namespace statistics
+}  // namespace quantsystem
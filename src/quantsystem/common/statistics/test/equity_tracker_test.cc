@@ -0,0 +1,91 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/statistics/equity_tracker.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace statistics {
+TEST(EquityTracker, TestMatchesFullCurve) {
+  const int64 kStart = 1420070400;  // 2015-01-01 00:00:00 UTC
+  vector<double> curve;
+  EquityTracker tracker;
+  int days = 0;
+  for (int i = 0; i < 5000; ++i) {
+    double equity = 100000 * (1 + 0.001 * i / 100 +
+                              0.05 * std::sin(i * 0.013) +
+                              0.01 * std::cos(i * 0.7));
+    curve.push_back(equity);
+    if (tracker.Update(kStart + i * 60, equity)) {
+      ++days;
+    }
+  }
+  // Drawdown of the whole curve computed with its history
+  double peak = curve[0], max_drawdown = 0;
+  for (double equity : curve) {
+    peak = std::max(peak, equity);
+    max_drawdown = std::max(max_drawdown, (peak - equity) / peak);
+  }
+  EXPECT_EQ(5000, tracker.updates());
+  EXPECT_EQ(3, days);
+  EXPECT_DOUBLE_EQ(peak, tracker.peak());
+  EXPECT_DOUBLE_EQ(max_drawdown, tracker.max_drawdown());
+  EXPECT_DOUBLE_EQ(curve.back(), tracker.equity());
+  EXPECT_LE(tracker.max_drawdown_peak_time(),
+            tracker.max_drawdown_trough_time());
+  // Range of the last finished day, the third one
+  double high = curve[2880], low = curve[2880];
+  for (int i = 2880; i < 4320; ++i) {
+    high = std::max(high, curve[i]);
+    low = std::min(low, curve[i]);
+  }
+  EXPECT_EQ(kStart + 2 * 86400, tracker.last_day().date);
+  EXPECT_DOUBLE_EQ(curve[2880], tracker.last_day().open);
+  EXPECT_DOUBLE_EQ(high, tracker.last_day().high);
+  EXPECT_DOUBLE_EQ(low, tracker.last_day().low);
+  EXPECT_DOUBLE_EQ(curve[4319], tracker.last_day().close);
+}
+
+TEST(EquityTracker, TestDrawdownDuration) {
+  EquityTracker tracker;
+  EXPECT_FALSE(tracker.has_equity());
+  tracker.Update(1000, 100);
+  tracker.Update(1060, 90);
+  tracker.Update(1120, 80);
+  tracker.Update(1180, 101);
+  tracker.Update(1240, 99);
+  EXPECT_DOUBLE_EQ(0.2, tracker.max_drawdown());
+  EXPECT_EQ(1000, tracker.max_drawdown_peak_time());
+  EXPECT_EQ(1120, tracker.max_drawdown_trough_time());
+  EXPECT_EQ(120, tracker.max_drawdown_duration());
+  EXPECT_EQ(60, tracker.drawdown_duration());
+  EXPECT_DOUBLE_EQ(2.0 / 101, tracker.drawdown());
+  EXPECT_DOUBLE_EQ(0.2, tracker.day().max_drawdown);
+  tracker.Reset();
+  EXPECT_FALSE(tracker.has_equity());
+  EXPECT_EQ(0, tracker.max_drawdown());
+}
+}  // namespace statistics
+}  // namespace quantsystem
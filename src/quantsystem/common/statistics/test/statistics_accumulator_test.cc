@@ -0,0 +1,145 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/statistics/statistics.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/time/time_span.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace statistics {
+namespace {
+double Mean(const vector<double>& values) {
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  return sum / values.size();
+}
+
+// Two pass sample covariance.
+double Covariance(const vector<double>& x, const vector<double>& y) {
+  double mean_x = Mean(x), mean_y = Mean(y);
+  double sum = 0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    sum += (x[i] - mean_x) * (y[i] - mean_y);
+  }
+  return sum / (x.size() - 1);
+}
+}  // namespace
+
+TEST(StatisticsAccumulator, TestMatchesTwoPassStatistics) {
+  vector<double> algo, benchmark, excess;
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(100000, 252, 0.01);
+  double downside = 0;
+  for (int i = 0; i < 500; ++i) {
+    double b = 0.01 * std::sin(i * 0.37);
+    double a = 1.5 * b + 0.002 * std::cos(i * 1.3) + 0.0004;
+    algo.push_back(a);
+    benchmark.push_back(b);
+    excess.push_back(a - b);
+    if (a < 0) {
+      downside += a * a;
+    }
+    accumulator.AddPerformance(a, b);
+  }
+  double annual = Mean(algo) * 252;
+  double deviation = std::sqrt(Covariance(algo, algo) * 252);
+  double beta = Covariance(algo, benchmark) / Covariance(benchmark, benchmark);
+  double tracking = std::sqrt(Covariance(excess, excess) * 252);
+  EXPECT_NEAR(annual, accumulator.AnnualPerformance(), 1e-12);
+  EXPECT_NEAR(deviation, accumulator.AnnualStandardDeviation(), 1e-12);
+  EXPECT_NEAR((annual - 0.01) / deviation, accumulator.SharpeRatio(), 1e-9);
+  EXPECT_NEAR((annual - 0.01) / std::sqrt(downside / 500 * 252),
+              accumulator.SortinoRatio(), 1e-9);
+  EXPECT_NEAR(beta, accumulator.Beta(), 1e-9);
+  EXPECT_NEAR(annual - (0.01 + beta * (Mean(benchmark) * 252 - 0.01)),
+              accumulator.Alpha(), 1e-9);
+  EXPECT_NEAR(tracking, accumulator.TrackingError(), 1e-12);
+  EXPECT_NEAR(Mean(excess) * 252 / tracking, accumulator.InformationRatio(),
+              1e-9);
+  EXPECT_NEAR(beta, Statistics::Beta(algo, benchmark), 1e-9);
+  EXPECT_NEAR(tracking, Statistics::TrackingError(algo, benchmark), 1e-12);
+}
+
+TEST(StatisticsAccumulator, TestDrawdownAndTrades) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(100);
+  DateTime time(2014, 1, 1);
+  double equity[] = {100, 120, 90, 110, 130, 104, 140};
+  for (double value : equity) {
+    accumulator.AddEquity(time, value);
+    time += TimeSpan::FromDays(1);
+  }
+  // 120 to 90 is deeper than 130 to 104.
+  EXPECT_DOUBLE_EQ(0.25, accumulator.drawdown());
+  EXPECT_DOUBLE_EQ(0.4, accumulator.NetProfit());
+
+  accumulator.AddTrade(30);
+  accumulator.AddTrade(-10);
+  accumulator.AddTrade(10);
+  accumulator.AddTrade(-20);
+  EXPECT_EQ(4, accumulator.total_trades());
+  EXPECT_DOUBLE_EQ(0.5, accumulator.WinRate());
+  EXPECT_DOUBLE_EQ(20, accumulator.AverageWin());
+  EXPECT_DOUBLE_EQ(-15, accumulator.AverageLoss());
+  EXPECT_DOUBLE_EQ(0.5 * 20 / 15 - 0.5, accumulator.Expectancy());
+
+  map<string, string> statistics;
+  accumulator.GetStatistics(&statistics);
+  EXPECT_EQ("25.000%", statistics["Drawdown"]);
+  EXPECT_EQ("4", statistics["Total Trades"]);
+  EXPECT_EQ("50.000%", statistics["Win Rate"]);
+}
+
+TEST(StatisticsAccumulator, TestTradesFromAnotherThread) {
+  StatisticsAccumulator accumulator;
+  accumulator.Initialize(100);
+  const int kTrades = 20000;
+  // Trades close on the transaction thread while the algorithm reads
+  std::thread trades([&accumulator, kTrades]() {
+    for (int i = 0; i < kTrades; ++i) {
+      accumulator.AddTrade(i % 2 == 0 ? 1 : -1);
+    }
+  });
+  int last_total = 0;
+  for (int i = 0; i < 200; ++i) {
+    accumulator.AddPerformance(0.001);
+    map<string, string> statistics;
+    accumulator.GetStatistics(&statistics);
+    int total = std::atoi(statistics["Total Trades"].c_str());
+    EXPECT_LE(last_total, total);
+    last_total = total;
+  }
+  trades.join();
+  EXPECT_EQ(kTrades, accumulator.total_trades());
+  EXPECT_DOUBLE_EQ(0.5, accumulator.WinRate());
+  EXPECT_EQ(200, accumulator.trading_days());
+}
+}  // namespace statistics
+}  // namespace quantsystem
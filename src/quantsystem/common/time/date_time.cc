@@ -159,6 +159,17 @@ DateTime DateTime::ParseDate(const string& date, bool long_format) {
   return DateTime(utc);
 }
 
+DateTime DateTime::FromEpochMicroseconds(int64 microseconds) {
+  struct timeval tv;
+  tv.tv_sec = microseconds / 1000000;
+  tv.tv_usec = microseconds % 1000000;
+  if (tv.tv_usec < 0) {
+    tv.tv_sec -= 1;
+    tv.tv_usec += 1000000;
+  }
+  return DateTime(tv);
+}
+
 DateTime DateTime::DateTimeInvalid() {
   DateTime d = DateTime();
   d.MarkInvalid();
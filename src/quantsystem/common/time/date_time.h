@@ -156,6 +156,18 @@ class DateTime {
    */
   time_t ToEpochTime() const { return t_.tv_sec; }
 
+  /**
+   * Convert the date to microseconds since the epoch.
+   */
+  int64 ToEpochMicroseconds() const {
+    return static_cast<int64>(t_.tv_sec) * 1000000 + t_.tv_usec;
+  }
+
+  /**
+   * Get the date of microseconds since the epoch.
+   */
+  static DateTime FromEpochMicroseconds(int64 microseconds);
+
   /**
    * Determine if we have a valid date or not.
    */
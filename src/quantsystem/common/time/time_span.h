@@ -211,6 +211,13 @@ class TimeSpan {
    */
   double TotalSeconds() const;
 
+  /**
+   * Get total microseconds.
+   */
+  int64 TotalMicroseconds() const {
+    return static_cast<int64>(span_.tv_sec) * 1000000 + span_.tv_usec;
+  }
+
   /**
    * Get total minutes.
    */
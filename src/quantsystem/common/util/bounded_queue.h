@@ -0,0 +1,175 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_BOUNDED_QUEUE_H_
+#define QUANTSYSTEM_COMMON_BOUNDED_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <glog/logging.h>
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/base/scoped_ptr.h"
+
+namespace quantsystem {
+/**
+ * Fixed capacity lock-free queue for many producers and many consumers.
+ *
+ * The slots are a power-of-two ring allocated once at construction.
+ * Each slot carries a sequence number telling whether it is free for
+ * the producer of a given position or holds the item for the consumer
+ * of that position, so a push or a pop is a single compare-and-swap on
+ * the position counter and never blocks: a full queue makes TryPush
+ * fail instead of waiting. Popping swaps the item with the slot, so
+ * items owning heap storage (strings, vectors) hand their buffers back
+ * to the ring and a steady stream of pushes stops allocating.
+ * @ingroup CommonBaseUtil
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+   * Create the queue.
+   * @param capacity Minimum number of items held, rounded up to a
+   * power of two
+   */
+  explicit BoundedQueue(int capacity) {
+    if (capacity < 2) {
+      LOG(ERROR) << "BoundedQueue capacity must be at least 2: " << capacity;
+      capacity = 2;
+    }
+    uint64 size = 1;
+    while (size < static_cast<uint64>(capacity)) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (uint64 i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_position_.store(0, std::memory_order_relaxed);
+    dequeue_position_.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * Number of items the queue can hold.
+   */
+  int capacity() const { return static_cast<int>(mask_ + 1); }
+
+  /**
+   * Number of items in the queue. Exact only when no other thread is
+   * pushing or popping.
+   */
+  int size() const {
+    uint64 tail = dequeue_position_.load(std::memory_order_acquire);
+    uint64 head = enqueue_position_.load(std::memory_order_acquire);
+    return head > tail ? static_cast<int>(head - tail) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Number of items pushed or being pushed since the queue was created:
+   * the position of the next item pushed, which is popped after every
+   * item before it.
+   */
+  uint64 push_position() const {
+    return enqueue_position_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Copy an item to the back of the queue.
+   * @param item Item to add
+   * @return False if the queue is full, the item is not added.
+   */
+  bool TryPush(const T& item) {
+    Cell* cell;
+    uint64 position = enqueue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[position & mask_];
+      uint64 sequence = cell->sequence.load(std::memory_order_acquire);
+      int64 diff = static_cast<int64>(sequence - position);
+      if (diff == 0) {
+        if (enqueue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->item = item;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Take the item at the front of the queue.
+   * @param item[out] Receives the item; its previous contents are left
+   * in the slot for a later push to reuse
+   * @return False if the queue is empty.
+   */
+  bool TryPop(T* item) {
+    Cell* cell;
+    uint64 position = dequeue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[position & mask_];
+      uint64 sequence = cell->sequence.load(std::memory_order_acquire);
+      int64 diff = static_cast<int64>(sequence - (position + 1));
+      if (diff == 0) {
+        if (dequeue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    using std::swap;
+    swap(*item, cell->item);
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  class Cell {
+   public:
+    std::atomic<uint64> sequence;
+    T item;
+  };
+  // Positions on separate cache lines so producers and consumers do not
+  // invalidate each other's line.
+  static const int kCacheLine = 64;
+
+  scoped_array<Cell> cells_;
+  uint64 mask_;
+  char pad0_[kCacheLine];
+  std::atomic<uint64> enqueue_position_;
+  char pad1_[kCacheLine];
+  std::atomic<uint64> dequeue_position_;
+  char pad2_[kCacheLine];
+
+  DISALLOW_COPY_AND_ASSIGN(BoundedQueue);
+};
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_BOUNDED_QUEUE_H_
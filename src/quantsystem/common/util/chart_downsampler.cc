@@ -0,0 +1,147 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "quantsystem/common/util/chart_downsampler.h"
+namespace quantsystem {
+bool ChartDownsampler::KeepAll(int count, int threshold,
+                               vector<int>* indices) {
+  indices->clear();
+  if (count > threshold) {
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    indices->push_back(i);
+  }
+  return true;
+}
+
+int ChartDownsampler::LargestTriangle(const int64* times,
+                                      const double* values, int count,
+                                      int threshold, vector<int>* indices) {
+  if (threshold < 3) {
+    threshold = 3;
+  }
+  if (KeepAll(count, threshold, indices)) {
+    return count;
+  }
+  indices->reserve(threshold);
+  // Times relative to the first point keep the precision of the areas
+  const int64 origin = times[0];
+  const double every = static_cast<double>(count - 2) / (threshold - 2);
+  int selected = 0;
+  indices->push_back(selected);
+  for (int bucket = 0; bucket < threshold - 2; ++bucket) {
+    // Average point of the next bucket, the last point for the last one
+    int average_begin = static_cast<int>((bucket + 1) * every) + 1;
+    int average_end = std::min(static_cast<int>((bucket + 2) * every) + 1,
+                               count);
+    double average_time = 0, average_value = 0;
+    for (int i = average_begin; i < average_end; ++i) {
+      average_time += times[i] - origin;
+      average_value += values[i];
+    }
+    average_time /= average_end - average_begin;
+    average_value /= average_end - average_begin;
+    // Point of this bucket with the largest triangle to the selected
+    // point of the previous bucket and the average of the next one
+    int begin = static_cast<int>(bucket * every) + 1;
+    int end = static_cast<int>((bucket + 1) * every) + 1;
+    double selected_time = times[selected] - origin;
+    double selected_value = values[selected];
+    double max_area = -1;
+    int next = begin;
+    for (int i = begin; i < end; ++i) {
+      double area = std::fabs(
+          (selected_time - average_time) * (values[i] - selected_value) -
+          (selected_time - (times[i] - origin)) *
+          (average_value - selected_value));
+      if (area > max_area) {
+        max_area = area;
+        next = i;
+      }
+    }
+    selected = next;
+    indices->push_back(selected);
+  }
+  indices->push_back(count - 1);
+  return static_cast<int>(indices->size());
+}
+
+int ChartDownsampler::MinMax(const int64* times, const double* values,
+                             int count, int threshold, vector<int>* indices) {
+  if (threshold < 4) {
+    threshold = 4;
+  }
+  if (KeepAll(count, threshold, indices)) {
+    return count;
+  }
+  indices->reserve(threshold);
+  const int buckets = (threshold - 2) / 2;
+  const double every = static_cast<double>(count - 2) / buckets;
+  indices->push_back(0);
+  for (int bucket = 0; bucket < buckets; ++bucket) {
+    int begin = static_cast<int>(bucket * every) + 1;
+    int end = std::min(static_cast<int>((bucket + 1) * every) + 1,
+                       count - 1);
+    if (begin >= end) {
+      continue;
+    }
+    int low = begin, high = begin;
+    for (int i = begin + 1; i < end; ++i) {
+      if (values[i] < values[low]) {
+        low = i;
+      }
+      if (values[i] > values[high]) {
+        high = i;
+      }
+    }
+    indices->push_back(std::min(low, high));
+    if (low != high) {
+      indices->push_back(std::max(low, high));
+    }
+  }
+  indices->push_back(count - 1);
+  return static_cast<int>(indices->size());
+}
+
+void ChartDownsampler::Downsample(const Series& series, int threshold,
+                                  DownsampleMethod::Enum method,
+                                  Series* sampled) {
+  vector<int> indices;
+  const int64* times = series.times().data();
+  const double* values = series.values().data();
+  switch (method) {
+    case DownsampleMethod::kLargestTriangle:
+      LargestTriangle(times, values, series.size(), threshold, &indices);
+      break;
+    case DownsampleMethod::kMinMax:
+      MinMax(times, values, series.size(), threshold, &indices);
+      break;
+  }
+  sampled->name = series.name;
+  sampled->series_type = series.series_type;
+  sampled->Clear();
+  // Added as live points: the result is not compacted again
+  for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+    sampled->AddPoint(times[indices[i]], values[indices[i]], true);
+  }
+}
+}  // namespace quantsystem
@@ -0,0 +1,97 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_UTIL_CHART_DOWNSAMPLER_H_
+#define QUANTSYSTEM_COMMON_UTIL_CHART_DOWNSAMPLER_H_
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/util/charting.h"
+namespace quantsystem {
+/**
+ * Available downsampling methods.
+ */
+namespace DownsampleMethod {
+enum Enum {
+  // Largest triangle three buckets: keeps the visual shape of the series
+  kLargestTriangle,
+  // Minimum and maximum of each bucket: keeps every extreme, e.g. the
+  // bottom of a drawdown
+  kMinMax
+};
+};  // namespace DownsampleMethod
+
+/**
+ * Reduce the points of a chart series to a maximum count.
+ *
+ * Both methods keep the first and the last point and split the points
+ * in between in buckets of equal count, then select the points to keep
+ * in each bucket in one pass over the time and value columns. They
+ * return the indices of the selected points in ascending order, so the
+ * series can be compacted in place.
+ * @ingroup CommonBaseUtil
+ * @see Series
+ */
+class ChartDownsampler {
+ public:
+  /**
+   * Select the points with the largest triangle three buckets method.
+   * @param times Time column
+   * @param values Value column
+   * @param count Number of points
+   * @param threshold Maximum number of points to keep, at least 3
+   * @param indices[out] Indices of the kept points in ascending order
+   * @return Number of kept points.
+   */
+  static int LargestTriangle(const int64* times, const double* values,
+                             int count, int threshold, vector<int>* indices);
+
+  /**
+   * Select the minimum and the maximum of each bucket.
+   * @param times Time column
+   * @param values Value column
+   * @param count Number of points
+   * @param threshold Maximum number of points to keep, at least 4
+   * @param indices[out] Indices of the kept points in ascending order
+   * @return Number of kept points.
+   */
+  static int MinMax(const int64* times, const double* values, int count,
+                    int threshold, vector<int>* indices);
+
+  /**
+   * Downsample a series.
+   * @param series Series to downsample
+   * @param threshold Maximum number of points of the result
+   * @param method Selection of the points
+   * @param sampled[out] Series with the kept points, its name and type
+   * are the ones of the input series
+   */
+  static void Downsample(const Series& series, int threshold,
+                         DownsampleMethod::Enum method, Series* sampled);
+
+ private:
+  /**
+   * Keep every point when there are no more points than the threshold.
+   * @return True if every point was kept.
+   */
+  static bool KeepAll(int count, int threshold, vector<int>* indices);
+};
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_UTIL_CHART_DOWNSAMPLER_H_
@@ -17,17 +17,22 @@
  * @}
  */
 
+#include <algorithm>
 #include <utility>
 using std::make_pair;
 #include "quantsystem/common/util/charting.h"
 
 namespace quantsystem {
 Series::Series() : series_type(SeriesType::kLine),
+                   max_points_(kDefaultMaxPoints),
+                   bucket_seconds_(0),
                    update_position_(0) {
 }
 
 Series::Series(const string& in_name, SeriesType::Enum type)
-    : update_position_(0) {
+    : max_points_(kDefaultMaxPoints),
+      bucket_seconds_(0),
+      update_position_(0) {
   name = in_name;
   series_type = type;
 }
@@ -35,20 +40,158 @@ Series::Series(const string& in_name, SeriesType::Enum type)
 Series::~Series() {
 }
 
-void Series::AddPoint(const DateTime& time, double value, bool live_mode) {
-  if (values.size() < 4000 || live_mode) {
-    values.push_back(ChartPoint(time, value));
+void Series::Append(const Series& other, bool live_mode) {
+  for (int i = 0; i < other.size(); ++i) {
+    AddPoint(other.times_[i], other.values_[i], live_mode);
   }
 }
 
+void Series::Clear() {
+  times_.clear();
+  values_.clear();
+  bucket_seconds_ = 0;
+  update_position_ = 0;
+}
+
+void Series::GetPoints(vector<ChartPoint>* points) const {
+  points->reserve(points->size() + times_.size());
+  for (int i = 0; i < size(); ++i) {
+    points->push_back(point(i));
+  }
+}
+
+void Series::EncodeTimes(vector<int64>* deltas) const {
+  deltas->resize(times_.size());
+  int64 previous = 0;
+  for (int i = 0; i < size(); ++i) {
+    (*deltas)[i] = times_[i] - previous;
+    previous = times_[i];
+  }
+}
+
+void Series::DecodeTimes(const vector<int64>& deltas,
+                         const vector<double>& values) {
+  times_.resize(deltas.size());
+  int64 previous = 0;
+  for (int i = 0; i < static_cast<int>(deltas.size()); ++i) {
+    previous += deltas[i];
+    times_[i] = previous;
+  }
+  values_ = values;
+  bucket_seconds_ = 0;
+  update_position_ = 0;
+}
+
+void Series::set_max_points(int max_points) {
+  // Compaction keeps the first and last point and one min/max pair
+  max_points_ = max_points < 8 ? 8 : max_points;
+  while (size() > max_points_) {
+    Compact();
+  }
+}
+
+void Series::AddCompactedPoint(int64 time, double value) {
+  while (size() >= max_points_) {
+    Compact();
+  }
+  if (size() > 1) {
+    // The first and the newest point are kept as they are
+    int64 newest_time = times_.back();
+    double newest_value = values_.back();
+    times_.pop_back();
+    values_.pop_back();
+    update_position_ = std::min(update_position_, size());
+    AddToBucket(newest_time, newest_value);
+  }
+  times_.push_back(time);
+  values_.push_back(value);
+}
+
+void Series::AddToBucket(int64 time, double value) {
+  const int64 origin = times_[0];
+  const int64 bucket = (time - origin) / bucket_seconds_;
+  // Points of the same bucket at the end, at most two
+  int begin = size();
+  while (begin > 1 && begin > size() - 2 &&
+         (times_[begin - 1] - origin) / bucket_seconds_ == bucket) {
+    --begin;
+  }
+  if (begin == size()) {
+    times_.push_back(time);
+    values_.push_back(value);
+    return;
+  }
+  int64 times[3];
+  double values[3];
+  int count = 0;
+  for (int i = begin; i < size(); ++i, ++count) {
+    times[count] = times_[i];
+    values[count] = values_[i];
+  }
+  times[count] = time;
+  values[count] = value;
+  ++count;
+  // On a tie the newer point is kept
+  int low = 0, high = 0;
+  for (int i = 1; i < count; ++i) {
+    if (values[i] <= values[low]) {
+      low = i;
+    }
+    if (values[i] >= values[high]) {
+      high = i;
+    }
+  }
+  times_.resize(begin);
+  values_.resize(begin);
+  times_.push_back(times[std::min(low, high)]);
+  values_.push_back(values[std::min(low, high)]);
+  if (low != high) {
+    times_.push_back(times[std::max(low, high)]);
+    values_.push_back(values[std::max(low, high)]);
+  }
+  update_position_ = std::min(update_position_, begin);
+}
+
+void Series::Compact() {
+  if (size() < 3) {
+    return;
+  }
+  if (bucket_seconds_ == 0) {
+    // Two points a bucket plus the first and the newest point make
+    // half of max_points_
+    const int64 buckets = (max_points_ / 2 - 2) / 2;
+    bucket_seconds_ = (times_.back() - times_[0]) / buckets + 1;
+  } else {
+    bucket_seconds_ *= 2;
+  }
+  // Rebucket from copies, the updates restart after the last point sent
+  vector<int64> times;
+  vector<double> values;
+  times.swap(times_);
+  values.swap(values_);
+  const int64 sent = update_position_ > 0 ?
+      times[update_position_ - 1] : times[0] - 1;
+  const int last = static_cast<int>(times.size()) - 1;
+  times_.reserve(max_points_);
+  values_.reserve(max_points_);
+  times_.push_back(times[0]);
+  values_.push_back(values[0]);
+  for (int i = 1; i < last; ++i) {
+    AddToBucket(times[i], values[i]);
+  }
+  times_.push_back(times[last]);
+  values_.push_back(values[last]);
+  update_position_ = static_cast<int>(
+      std::upper_bound(times_.begin(), times_.end(), sent) - times_.begin());
+}
+
 Series Series::GetUpdates() {
   Series copy = Series(name, series_type);
   // Add the updates since the last
-  for (int i = update_position_; i < values.size(); ++i) {
-    copy.values.push_back(values[i]);
-  }
+  copy.times_.assign(times_.begin() + update_position_, times_.end());
+  copy.values_.assign(values_.begin() + update_position_, values_.end());
   // Shuffle the update point to now
-  update_position_ = values.size();
+  update_position_ = size();
   return copy;
 }
 
@@ -70,11 +213,21 @@ void Chart::AddSeries(const Series& series) {
   }
 }
 
+Series* Chart::GetSeries(const string& series_name,
+                         SeriesType::Enum series_type) {
+  SeriesMap::iterator found = series_map.find(series_name);
+  if (found == series_map.end()) {
+    found = series_map.insert(
+        make_pair(series_name, Series(series_name, series_type))).first;
+  }
+  return &found->second;
+}
+
 Chart Chart::GetUpdates() {
   Chart copy = Chart(name, chart_type);
-  for (SeriesMap::const_iterator it = series_map.begin();
+  for (SeriesMap::iterator it = series_map.begin();
        it != series_map.end(); ++it) {
-    copy.AddSeries(it->second);
+    copy.AddSeries(it->second.GetUpdates());
   }
   return copy;
 }
@@ -79,7 +79,7 @@ class ChartPoint {
     y = value;
   }
 
-  explicit ChartPoint(const ChartPoint& point) {
+  ChartPoint(const ChartPoint& point) {
     x = point.x;
     y = point.y;
   }
@@ -87,15 +87,21 @@ class ChartPoint {
 
 /**
  * Chart Series Object - Series data and properties for a chart:
+ *
+ * The points are stored in two columns, the times and the values, in
+ * ascending time order. The times column can be delta encoded for
+ * storage. Outside of live mode a series holds at most max_points()
+ * points: when it is full the time between the first and the newest
+ * point is split in buckets of equal width, each keeping its minimum
+ * and maximum, and the series is compacted to half of max_points().
+ * Later points go straight into their bucket and each compaction
+ * doubles the width, so long backtests keep the whole period at one
+ * coarser resolution in bounded memory.
  * @ingroup CommonBaseUtil
  */
 class Series {
  public:
   string name;  // Name of the series
-  // Values for the series plot:
-  // These values are assumed to be in ascending time order
-  // (first points earliest, last points latest)
-  vector<ChartPoint> values;
   // Chart type for the series
   SeriesType::Enum series_type;
 
@@ -120,9 +126,85 @@ class Series {
    * Add a new point to this series:
    * @param time Time of the chart point
    * @param value Value of the chart point
+   * @param live_mode Bool indicate a live mode point, live series
+   * are not compacted
+   */
+  void AddPoint(const DateTime& time, double value, bool live_mode = false) {
+    AddPoint(static_cast<int64>(time.ToEpochTime()), value, live_mode);
+  }
+
+  /**
+   * Add a new point to this series:
+   * @param time Time of the chart point in seconds since the epoch
+   * @param value Value of the chart point
    * @param live_mode Bool indicate a live mode point
    */
-  void AddPoint(const DateTime& time, double value, bool live_mode = false);
+  void AddPoint(int64 time, double value, bool live_mode = false) {
+    if (!live_mode && (bucket_seconds_ > 0 || size() >= max_points_)) {
+      AddCompactedPoint(time, value);
+      return;
+    }
+    times_.push_back(time);
+    values_.push_back(value);
+  }
+
+  /**
+   * Append every point of another series.
+   * @param other Series with points later than the points of this series
+   * @param live_mode Bool indicate live mode points
+   */
+  void Append(const Series& other, bool live_mode = false);
+
+  /**
+   * Remove every point.
+   */
+  void Clear();
+
+  int size() const { return static_cast<int>(times_.size()); }
+  bool empty() const { return times_.empty(); }
+
+  int64 time(int index) const { return times_[index]; }
+  double value(int index) const { return values_[index]; }
+  ChartPoint point(int index) const {
+    return ChartPoint(DateTime(static_cast<time_t>(times_[index])),
+                      values_[index]);
+  }
+
+  /**
+   * Time column, seconds since the epoch.
+   */
+  const vector<int64>& times() const { return times_; }
+
+  /**
+   * Value column, parallel to the time column.
+   */
+  const vector<double>& values() const { return values_; }
+
+  /**
+   * Copy the points out as ChartPoints.
+   * @param points[out] Points of the series in time order
+   */
+  void GetPoints(vector<ChartPoint>* points) const;
+
+  /**
+   * Delta encode the time column: the first element is the first time,
+   * every other element the difference to the previous time.
+   * @param deltas[out] Encoded times
+   */
+  void EncodeTimes(vector<int64>* deltas) const;
+
+  /**
+   * Replace the points with a delta encoded time column and its values.
+   * @param deltas Times encoded by EncodeTimes
+   * @param values Values parallel to the times
+   */
+  void DecodeTimes(const vector<int64>& deltas, const vector<double>& values);
+
+  /**
+   * Maximum number of points kept outside of live mode.
+   */
+  int max_points() const { return max_points_; }
+  void set_max_points(int max_points);
 
   /**
    * Get the updates since the last call to this function.
@@ -131,9 +213,34 @@ class Series {
   Series GetUpdates();
 
  private:
+  static const int kDefaultMaxPoints = 4000;
+  vector<int64> times_;
+  vector<double> values_;
+  int max_points_;
+  // Width of the buckets of the compacted points, 0 until the first
+  // compaction
+  int64 bucket_seconds_;
   // Get the index of the last fetch update request to
   // only retrieve the "delta" of the previous request.
   int update_position_;
+
+  /**
+   * Add a point outside of live mode once the series is compacted or
+   * full: the previous newest point goes into its bucket.
+   */
+  void AddCompactedPoint(int64 time, double value);
+
+  /**
+   * Add a point after the first one to its bucket, which keeps its
+   * minimum and maximum in time order.
+   */
+  void AddToBucket(int64 time, double value);
+
+  /**
+   * Double the bucket width, or set the first one, and rebucket the
+   * points between the first and the newest.
+   */
+  void Compact();
 };
 
 /**
@@ -172,6 +279,17 @@ class Chart {
    */
   void AddSeries(const Series& series);
 
+  /**
+   * Get a series of this chart, adding it if it does not exist.
+   * The series address stays valid for the life of the chart, so it can
+   * be kept as a handle to sample without a lookup by name.
+   * @param series_name Name of the series
+   * @param series_type Type of the series if it is added
+   * @return Series of the chart
+   */
+  Series* GetSeries(const string& series_name,
+                    SeriesType::Enum series_type = SeriesType::kLine);
+
   /**
    * Fetch the updates of the chart, and save the index position.
    * @return Chart object
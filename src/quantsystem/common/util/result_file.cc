@@ -0,0 +1,558 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <glog/logging.h>
+#include <cstring>
+#include <utility>
+using std::make_pair;
+#include "quantsystem/common/json/json.h"
+#include "quantsystem/common/util/status.h"
+#include "quantsystem/common/util/result_file.h"
+namespace quantsystem {
+static const char kMagic[8] = {'Q', 'S', 'R', 'E', 'S', 'U', 'L', 'T'};
+
+COMPILE_ASSERT(sizeof(ResultFileHeader) == 32, ResultFileHeader_is_not_packed);
+COMPILE_ASSERT(sizeof(ResultSection) == 40, ResultSection_is_not_packed);
+
+/**
+ * Byte widths of the columns of a row section, 0 terminated.
+ */
+static const int* ColumnWidths(uint32 type) {
+  static const int kSeries[] = {8, 8, 0};
+  static const int kOrderEvents[] = {8, 8, 8, 4, 4, 4, 0};
+  static const int kOrders[] = {8, 8, 8, 4, 4, 4, 4, 0};
+  switch (type) {
+    case ResultSectionType::kSeries:
+      return kSeries;
+    case ResultSectionType::kOrderEvents:
+      return kOrderEvents;
+    case ResultSectionType::kOrders:
+      return kOrders;
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * Bytes of one row of a row section, 0 for a string table.
+ */
+static uint64 RowBytes(uint32 type) {
+  const int* widths = ColumnWidths(type);
+  uint64 bytes = 0;
+  for (int i = 0; widths != NULL && widths[i] != 0; ++i) {
+    bytes += widths[i];
+  }
+  return bytes;
+}
+
+const uint32 ResultFileWriter::kVersion;
+const int ResultFileWriter::kChunkRows;
+
+ResultFileWriter::ResultFileWriter()
+    : file_(NULL),
+      offset_(0),
+      failed_(false) {
+}
+
+ResultFileWriter::~ResultFileWriter() {
+  if (file_ != NULL) {
+    Close();
+  }
+}
+
+bool ResultFileWriter::Open(const string& path) {
+  file_ = File::Open(path, "w");
+  if (file_ == NULL) {
+    LOG(ERROR) << "Unable to create the result file: " << path;
+    return false;
+  }
+  ResultFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  offset_ = 0;
+  failed_ = false;
+  Write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return !failed_;
+}
+
+void ResultFileWriter::AddPoint(const string& chart_name,
+                                ChartType::Enum chart_type,
+                                const string& series_name,
+                                SeriesType::Enum series_type,
+                                int64 time, double value) {
+  if (file_ == NULL) {
+    return;
+  }
+  string key = chart_name + '\0' + series_name;
+  map<string, int>::const_iterator found = series_ids_.find(key);
+  if (found == series_ids_.end()) {
+    SeriesBuffer buffer;
+    buffer.name = GetStringId(chart_name);
+    buffer.series = GetStringId(series_name);
+    buffer.chart_type = static_cast<uint16>(chart_type);
+    buffer.series_type = static_cast<uint16>(series_type);
+    series_.push_back(buffer);
+    found = series_ids_.insert(
+        make_pair(key, static_cast<int>(series_.size()) - 1)).first;
+  }
+  SeriesBuffer* series = &series_[found->second];
+  series->times.push_back(time);
+  series->values.push_back(value);
+  if (series->times.size() >= kChunkRows) {
+    WriteSeries(series);
+  }
+}
+
+void ResultFileWriter::AddOrderEvent(int64 time, int order_id, int status,
+                                     const string& symbol, double quantity,
+                                     double price) {
+  if (file_ == NULL) {
+    return;
+  }
+  events_.times.push_back(time);
+  events_.quantities.push_back(quantity);
+  events_.prices.push_back(price);
+  events_.ids.push_back(order_id);
+  events_.statuses.push_back(status);
+  events_.symbols.push_back(GetStringId(symbol));
+  if (events_.times.size() >= kChunkRows) {
+    WriteOrders(ResultSectionType::kOrderEvents, &events_);
+  }
+}
+
+void ResultFileWriter::AddOrder(int64 time, int order_id, int status,
+                                int type, const string& symbol,
+                                double quantity, double price) {
+  if (file_ == NULL) {
+    return;
+  }
+  orders_.times.push_back(time);
+  orders_.quantities.push_back(quantity);
+  orders_.prices.push_back(price);
+  orders_.ids.push_back(order_id);
+  orders_.statuses.push_back(status);
+  orders_.symbols.push_back(GetStringId(symbol));
+  orders_.types.push_back(type);
+  if (orders_.times.size() >= kChunkRows) {
+    WriteOrders(ResultSectionType::kOrders, &orders_);
+  }
+}
+
+void ResultFileWriter::SetStatistics(const map<string, string>& statistics) {
+  statistics_.clear();
+  for (map<string, string>::const_iterator it = statistics.begin();
+       it != statistics.end(); ++it) {
+    statistics_.push_back(it->first);
+    statistics_.push_back(it->second);
+  }
+}
+
+bool ResultFileWriter::Close() {
+  if (file_ == NULL) {
+    return false;
+  }
+  for (int i = 0; i < static_cast<int>(series_.size()); ++i) {
+    WriteSeries(&series_[i]);
+  }
+  WriteOrders(ResultSectionType::kOrderEvents, &events_);
+  WriteOrders(ResultSectionType::kOrders, &orders_);
+  if (!statistics_.empty()) {
+    WriteStrings(ResultSectionType::kStatistics, statistics_);
+  }
+  WriteStrings(ResultSectionType::kStrings, strings_);
+  ResultFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.section_count = static_cast<uint32>(index_.size());
+  header.index_offset = offset_;
+  Write(reinterpret_cast<const char*>(index_.data()),
+        index_.size() * sizeof(ResultSection));
+  // The index offset marks the file as complete
+  if (!failed_ && !file_->Seek(0)) {
+    LOG(ERROR) << "Unable to seek to the result file header";
+    failed_ = true;
+  }
+  Write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file_->Close();
+  file_ = NULL;
+  index_.clear();
+  string_ids_.clear();
+  strings_.clear();
+  series_ids_.clear();
+  series_.clear();
+  statistics_.clear();
+  return !failed_;
+}
+
+uint32 ResultFileWriter::GetStringId(const string& text) {
+  map<string, uint32>::const_iterator found = string_ids_.find(text);
+  if (found != string_ids_.end()) {
+    return found->second;
+  }
+  uint32 id = static_cast<uint32>(strings_.size());
+  strings_.push_back(text);
+  string_ids_.insert(make_pair(text, id));
+  return id;
+}
+
+void ResultFileWriter::WriteSeries(SeriesBuffer* series) {
+  if (series->times.empty()) {
+    return;
+  }
+  ResultSection section;
+  memset(&section, 0, sizeof(section));
+  section.type = ResultSectionType::kSeries;
+  section.name = series->name;
+  section.series = series->series;
+  section.chart_type = series->chart_type;
+  section.series_type = series->series_type;
+  section.rows = series->times.size();
+  buffer_.clear();
+  AppendColumn(series->times);
+  AppendColumn(series->values);
+  WriteSection(&section);
+  series->times.clear();
+  series->values.clear();
+}
+
+void ResultFileWriter::WriteOrders(ResultSectionType::Enum type,
+                                   OrderBuffer* orders) {
+  if (orders->times.empty()) {
+    return;
+  }
+  ResultSection section;
+  memset(&section, 0, sizeof(section));
+  section.type = type;
+  section.rows = orders->times.size();
+  buffer_.clear();
+  AppendColumn(orders->times);
+  AppendColumn(orders->quantities);
+  AppendColumn(orders->prices);
+  AppendColumn(orders->ids);
+  AppendColumn(orders->statuses);
+  AppendColumn(orders->symbols);
+  if (type == ResultSectionType::kOrders) {
+    AppendColumn(orders->types);
+  }
+  WriteSection(&section);
+  orders->Clear();
+}
+
+void ResultFileWriter::WriteStrings(ResultSectionType::Enum type,
+                                    const vector<string>& strings) {
+  ResultSection section;
+  memset(&section, 0, sizeof(section));
+  section.type = type;
+  section.rows = strings.size();
+  vector<uint32> offsets(1, 0);
+  for (int i = 0; i < static_cast<int>(strings.size()); ++i) {
+    offsets.push_back(offsets.back() +
+                      static_cast<uint32>(strings[i].size()));
+  }
+  buffer_.clear();
+  AppendColumn(offsets);
+  for (int i = 0; i < static_cast<int>(strings.size()); ++i) {
+    buffer_ += strings[i];
+  }
+  WriteSection(&section);
+}
+
+void ResultFileWriter::WriteSection(ResultSection* section) {
+  section->offset = offset_;
+  section->size = buffer_.size();
+  // Every section starts on an 8-byte boundary
+  buffer_.append((8 - buffer_.size() % 8) % 8, '\0');
+  Write(buffer_.data(), buffer_.size());
+  index_.push_back(*section);
+}
+
+void ResultFileWriter::Write(const char* data, int64 size) {
+  if (failed_ || size == 0) {
+    return;
+  }
+  common::util::Status status = file_->Write(data, size);
+  if (!status.ok()) {
+    LOG(ERROR) << "Unable to write the result file: " <<
+        status.error_message();
+    failed_ = true;
+  }
+  offset_ += size;
+}
+
+void ResultFileWriter::OrderBuffer::Clear() {
+  times.clear();
+  quantities.clear();
+  prices.clear();
+  ids.clear();
+  statuses.clear();
+  symbols.clear();
+  types.clear();
+}
+
+ResultFileReader::ResultFileReader()
+    : data_(NULL),
+      size_(0),
+      mapped_(false),
+      sections_(NULL),
+      section_count_(0),
+      strings_(NULL) {
+}
+
+ResultFileReader::~ResultFileReader() {
+  Close();
+}
+
+bool ResultFileReader::Open(const string& path) {
+  Close();
+#if !defined(_MSC_VER)
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(ERROR) << "Unable to open the result file: " << path;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      data_ = static_cast<const char*>(data);
+      size_ = info.st_size;
+      mapped_ = true;
+    }
+  }
+  close(fd);
+#endif
+  if (!mapped_) {
+    if (!File::ReadPath(path, &content_).ok()) {
+      LOG(ERROR) << "Unable to read the result file: " << path;
+      return false;
+    }
+    data_ = content_.data();
+    size_ = content_.size();
+  }
+  if (!Validate()) {
+    LOG(ERROR) << "Invalid result file: " << path;
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void ResultFileReader::Close() {
+#if !defined(_MSC_VER)
+  if (mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  content_.clear();
+  data_ = NULL;
+  size_ = 0;
+  mapped_ = false;
+  sections_ = NULL;
+  section_count_ = 0;
+  strings_ = NULL;
+}
+
+bool ResultFileReader::Validate() {
+  if (size_ < sizeof(ResultFileHeader) ||
+      memcmp(header()->magic, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  if (header()->version == 0 ||
+      header()->version > ResultFileWriter::kVersion) {
+    LOG(ERROR) << "Unsupported result file version: " << header()->version;
+    return false;
+  }
+  const uint64 index_offset = header()->index_offset;
+  const uint64 count = header()->section_count;
+  if (index_offset < sizeof(ResultFileHeader) || index_offset % 8 != 0 ||
+      index_offset > size_ ||
+      count > (size_ - index_offset) / sizeof(ResultSection)) {
+    LOG(ERROR) << "The result file has no index, it was not closed";
+    return false;
+  }
+  sections_ = reinterpret_cast<const ResultSection*>(data_ + index_offset);
+  section_count_ = static_cast<int>(count);
+  for (int i = 0; i < section_count_; ++i) {
+    const ResultSection& section = sections_[i];
+    if (section.offset % 8 != 0 || section.offset > index_offset ||
+        section.size > index_offset - section.offset) {
+      return false;
+    }
+    uint64 row_bytes = RowBytes(section.type);
+    if (row_bytes > 0) {
+      if (section.rows > section.size / row_bytes ||
+          section.rows * row_bytes != section.size) {
+        return false;
+      }
+    } else if (section.type == ResultSectionType::kStatistics ||
+               section.type == ResultSectionType::kStrings) {
+      if (!ValidateStrings(section)) {
+        return false;
+      }
+      if (section.type == ResultSectionType::kStrings) {
+        strings_ = &section;
+      }
+    }
+  }
+  return true;
+}
+
+bool ResultFileReader::ValidateStrings(const ResultSection& section) const {
+  if (section.rows >= section.size / sizeof(uint32)) {
+    return false;
+  }
+  const uint32* offsets =
+      reinterpret_cast<const uint32*>(data_ + section.offset);
+  const uint64 chars = section.size - (section.rows + 1) * sizeof(uint32);
+  for (uint64 i = 0; i < section.rows; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      return false;
+    }
+  }
+  return offsets[0] == 0 && offsets[section.rows] == chars;
+}
+
+const char* ResultFileReader::ColumnData(const ResultSection& section,
+                                         int column) const {
+  const int* widths = ColumnWidths(section.type);
+  uint64 offset = section.offset;
+  for (int i = 0; i < column; ++i) {
+    if (widths == NULL || widths[i] == 0) {
+      LOG(ERROR) << "No column " << column << " in section type " <<
+          section.type;
+      return NULL;
+    }
+    offset += widths[i] * section.rows;
+  }
+  return data_ + offset;
+}
+
+StringPiece ResultFileReader::GetString(uint32 id) const {
+  if (strings_ == NULL || id >= strings_->rows) {
+    return StringPiece();
+  }
+  const uint32* offsets =
+      reinterpret_cast<const uint32*>(data_ + strings_->offset);
+  const char* chars = reinterpret_cast<const char*>(
+      offsets + strings_->rows + 1);
+  return StringPiece(chars + offsets[id], offsets[id + 1] - offsets[id]);
+}
+
+void ResultFileReader::GetStrings(const ResultSection& section,
+                                  vector<StringPiece>* strings) const {
+  const uint32* offsets =
+      reinterpret_cast<const uint32*>(data_ + section.offset);
+  const char* chars = reinterpret_cast<const char*>(
+      offsets + section.rows + 1);
+  for (uint64 i = 0; i < section.rows; ++i) {
+    strings->push_back(StringPiece(chars + offsets[i],
+                                   offsets[i + 1] - offsets[i]));
+  }
+}
+
+void ResultFileReader::ToJson(string* json) const {
+  Json::Value root(Json::objectValue);
+  Json::Value& charts = root["Charts"] = Json::Value(Json::objectValue);
+  Json::Value& orders = root["Orders"] = Json::Value(Json::objectValue);
+  Json::Value& events = root["OrderEvents"] = Json::Value(Json::arrayValue);
+  Json::Value& statistics = root["Statistics"] =
+      Json::Value(Json::objectValue);
+  for (int i = 0; i < section_count_; ++i) {
+    const ResultSection& section = sections_[i];
+    switch (section.type) {
+      case ResultSectionType::kSeries:
+        {
+          const int64* times = GetColumn<int64>(section, ResultColumn::kTime);
+          const double* values =
+              GetColumn<double>(section, ResultColumn::kValue);
+          string chart_name = GetString(section.name).as_string();
+          string series_name = GetString(section.series).as_string();
+          Json::Value& chart = charts[chart_name];
+          chart["Name"] = chart_name;
+          chart["ChartType"] = section.chart_type;
+          Json::Value& series = chart["Series"][series_name];
+          series["Name"] = series_name;
+          series["SeriesType"] = section.series_type;
+          Json::Value& points = series["Values"];
+          for (uint64 row = 0; row < section.rows; ++row) {
+            Json::Value point(Json::objectValue);
+            point["x"] = static_cast<Json::Int64>(times[row]);
+            point["y"] = values[row];
+            points.append(point);
+          }
+          break;
+        }
+      case ResultSectionType::kOrderEvents:
+      case ResultSectionType::kOrders:
+        {
+          const int64* times = GetColumn<int64>(section, ResultColumn::kTime);
+          const double* quantities =
+              GetColumn<double>(section, ResultColumn::kQuantity);
+          const double* prices =
+              GetColumn<double>(section, ResultColumn::kPrice);
+          const int32* ids = GetColumn<int32>(section, ResultColumn::kOrderId);
+          const int32* statuses =
+              GetColumn<int32>(section, ResultColumn::kStatus);
+          const int32* symbols =
+              GetColumn<int32>(section, ResultColumn::kSymbol);
+          const bool is_order = section.type == ResultSectionType::kOrders;
+          const int32* types = is_order ?
+              GetColumn<int32>(section, ResultColumn::kOrderType) : NULL;
+          for (uint64 row = 0; row < section.rows; ++row) {
+            Json::Value order(Json::objectValue);
+            order["Time"] = static_cast<Json::Int64>(times[row]);
+            order["Id"] = ids[row];
+            order["Status"] = statuses[row];
+            order["Symbol"] = GetString(symbols[row]).as_string();
+            order["Quantity"] = quantities[row];
+            order["Price"] = prices[row];
+            if (is_order) {
+              order["Type"] = types[row];
+              orders[std::to_string(ids[row])] = order;
+            } else {
+              events.append(order);
+            }
+          }
+          break;
+        }
+      case ResultSectionType::kStatistics:
+        {
+          vector<StringPiece> pairs;
+          GetStrings(section, &pairs);
+          for (int row = 0; row + 1 < static_cast<int>(pairs.size());
+               row += 2) {
+            statistics[pairs[row].as_string()] = pairs[row + 1].as_string();
+          }
+          break;
+        }
+      default:
+        break;
+    }
+  }
+  *json = Json::StyledWriter().write(root);
+}
+}  // namespace quantsystem
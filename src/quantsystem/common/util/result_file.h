@@ -0,0 +1,313 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_COMMON_RESULT_FILE_H_
+#define QUANTSYSTEM_COMMON_RESULT_FILE_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/strings/stringpiece.h"
+#include "quantsystem/common/util/charting.h"
+#include "quantsystem/common/util/file.h"
+
+namespace quantsystem {
+/**
+ * Kind of a section of the result file.
+ */
+namespace ResultSectionType {
+enum Enum {
+  // Chunk of a chart series: time int64, value double
+  kSeries = 1,
+  // Chunk of order events: time int64, quantity double, price double,
+  // order id int32, status int32, symbol string id int32
+  kOrderEvents = 2,
+  // Chunk of final orders: the order event columns, plus type int32
+  kOrders = 3,
+  // Statistics: string table of alternating names and values
+  kStatistics = 4,
+  // String table of the chart, series and symbol names
+  kStrings = 5
+};
+}  // namespace ResultSectionType
+
+/**
+ * Columns of the row sections, by position. The series sections only
+ * have kTime and kValue.
+ */
+namespace ResultColumn {
+enum Enum {
+  kTime = 0,
+  kValue = 1,
+  kQuantity = 1,
+  kPrice = 2,
+  kOrderId = 3,
+  kStatus = 4,
+  kSymbol = 5,
+  kOrderType = 6
+};
+}  // namespace ResultColumn
+
+/**
+ * Fixed header at the start of a result file.
+ */
+class ResultFileHeader {
+ public:
+  char magic[8];  // "QSRESULT"
+  uint32 version;  // Format version, ResultFileWriter::kVersion
+  uint32 section_count;  // Number of entries in the index
+  uint64 index_offset;  // Offset of the index, 0 until the file is closed
+  uint64 reserved;
+};
+
+/**
+ * Index entry of a section. The data of a section is its columns one
+ * after the other, 8-byte columns first, starting on an 8-byte boundary.
+ */
+class ResultSection {
+ public:
+  uint32 type;  // ResultSectionType
+  uint32 name;  // String id of the chart name of a series chunk
+  uint32 series;  // String id of the series name of a series chunk
+  uint16 chart_type;  // ChartType of a series chunk
+  uint16 series_type;  // SeriesType of a series chunk
+  uint64 offset;  // Offset of the data from the start of the file
+  uint64 rows;  // Number of rows, or of strings in a string table
+  uint64 size;  // Size of the data in bytes
+};
+
+/**
+ * Streaming writer of the binary result file of a backtest.
+ *
+ * The file is a header, the data of the sections and an index of the
+ * sections at the end. Rows are buffered per chart series and for the
+ * order events; a buffer is written as a section (a chunk) as soon as
+ * it holds kChunkRows rows, so the memory used does not grow with the
+ * length of the run. Close() writes the remaining chunks, the final
+ * orders, the statistics, the string table and the index, then stores
+ * the index offset in the header: a file which was not closed has no
+ * index and is rejected by the reader.
+ * @ingroup CommonBaseUtil
+ * @see ResultFileReader
+ */
+class ResultFileWriter {
+ public:
+  static const uint32 kVersion = 1;
+  static const int kChunkRows = 4096;
+
+  /**
+   * Standard constructor.
+   */
+  ResultFileWriter();
+
+  /**
+   * Closes the file if it is still open.
+   */
+  virtual ~ResultFileWriter();
+
+  /**
+   * Create the file and write the header.
+   * @param path Path of the result file
+   * @return False if the file could not be created.
+   */
+  bool Open(const string& path);
+
+  /**
+   * Add a point to a chart series.
+   */
+  void AddPoint(const string& chart_name, ChartType::Enum chart_type,
+                const string& series_name, SeriesType::Enum series_type,
+                int64 time, double value);
+
+  /**
+   * Add an order event.
+   */
+  void AddOrderEvent(int64 time, int order_id, int status,
+                     const string& symbol, double quantity, double price);
+
+  /**
+   * Add an order as it is at the end of the run.
+   */
+  void AddOrder(int64 time, int order_id, int status, int type,
+                const string& symbol, double quantity, double price);
+
+  /**
+   * Set the statistics written when the file is closed.
+   */
+  void SetStatistics(const map<string, string>& statistics);
+
+  /**
+   * Write everything which is buffered, the index and the header.
+   * @return False if a write failed.
+   */
+  bool Close();
+
+  bool is_open() const { return file_ != NULL; }
+
+ private:
+  class SeriesBuffer {
+   public:
+    uint32 name;
+    uint32 series;
+    uint16 chart_type;
+    uint16 series_type;
+    vector<int64> times;
+    vector<double> values;
+  };
+  class OrderBuffer {
+   public:
+    vector<int64> times;
+    vector<double> quantities;
+    vector<double> prices;
+    vector<int32> ids;
+    vector<int32> statuses;
+    vector<int32> symbols;
+    vector<int32> types;
+    void Clear();
+  };
+
+  File* file_;
+  uint64 offset_;
+  bool failed_;
+  vector<ResultSection> index_;
+  map<string, uint32> string_ids_;
+  vector<string> strings_;
+  // Series buffers, by chart and series name
+  map<string, int> series_ids_;
+  vector<SeriesBuffer> series_;
+  OrderBuffer events_;
+  OrderBuffer orders_;
+  vector<string> statistics_;
+  // Data of the section being written, reused
+  string buffer_;
+
+  uint32 GetStringId(const string& text);
+  void WriteSeries(SeriesBuffer* series);
+  void WriteOrders(ResultSectionType::Enum type, OrderBuffer* orders);
+  void WriteStrings(ResultSectionType::Enum type,
+                    const vector<string>& strings);
+  void WriteSection(ResultSection* section);
+  void Write(const char* data, int64 size);
+
+  template <typename T>
+  void AppendColumn(const vector<T>& column) {
+    if (!column.empty()) {
+      buffer_.append(reinterpret_cast<const char*>(column.data()),
+                     column.size() * sizeof(T));
+    }
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(ResultFileWriter);
+};
+
+/**
+ * Reader of a result file written by ResultFileWriter.
+ *
+ * The file is mapped in memory and only the header, the index and the
+ * string table offsets are validated: the columns are returned as
+ * pointers into the mapping, without parsing or copying.
+ * @ingroup CommonBaseUtil
+ * @see ResultFileWriter
+ */
+class ResultFileReader {
+ public:
+  /**
+   * Standard constructor.
+   */
+  ResultFileReader();
+
+  /**
+   * Unmaps the file.
+   */
+  virtual ~ResultFileReader();
+
+  /**
+   * Map and validate a result file.
+   * @param path Path of the result file
+   * @return False if the file is missing, not closed or invalid.
+   */
+  bool Open(const string& path);
+
+  /**
+   * Unmap the file.
+   */
+  void Close();
+
+  uint32 version() const { return header()->version; }
+  int section_count() const { return section_count_; }
+  const ResultSection& section(int index) const { return sections_[index]; }
+
+  /**
+   * Get a column of a row section.
+   * @param section Series, order events or orders section
+   * @param column ResultColumn of the section
+   * @return Pointer to the rows of the column in the mapping.
+   */
+  template <typename T>
+  const T* GetColumn(const ResultSection& section, int column) const {
+    return reinterpret_cast<const T*>(ColumnData(section, column));
+  }
+
+  /**
+   * Get a string of the string table.
+   * @param id String id from a section or a symbol column
+   */
+  StringPiece GetString(uint32 id) const;
+
+  /**
+   * Get the strings of a string table section.
+   * @param section Statistics or string table section
+   * @param strings[out] Strings, pointing into the mapping
+   */
+  void GetStrings(const ResultSection& section,
+                  vector<StringPiece>* strings) const;
+
+  /**
+   * Convert the result file to JSON: charts, orders, order events and
+   * statistics.
+   * @param json[out] JSON document
+   */
+  void ToJson(string* json) const;
+
+ private:
+  const char* data_;
+  uint64 size_;
+  // The file content when it can not be mapped
+  string content_;
+  bool mapped_;
+  const ResultSection* sections_;
+  int section_count_;
+  const ResultSection* strings_;
+
+  const ResultFileHeader* header() const {
+    return reinterpret_cast<const ResultFileHeader*>(data_);
+  }
+  const char* ColumnData(const ResultSection& section, int column) const;
+  bool Validate();
+  bool ValidateStrings(const ResultSection& section) const;
+
+  DISALLOW_COPY_AND_ASSIGN(ResultFileReader);
+};
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_COMMON_RESULT_FILE_H_
@@ -17,27 +17,114 @@
  * @}
  */
 
+#include <algorithm>
+#include <thread>
+#include <utility>
+using std::make_pair;
 #include "quantsystem/common/util/series_sampler.h"
 namespace quantsystem {
-SeriesSampler::SeriesSampler() {
+SeriesSampler::SeriesSampler()
+    : seconds_(24 * 60 * 60),
+      mode_(SamplingMode::kLinear) {
 }
 
 SeriesSampler::~SeriesSampler() {
 }
 
-SeriesSampler::SeriesSampler(const TimeSpan& resolution) {
+SeriesSampler::SeriesSampler(const TimeSpan& resolution,
+                             SamplingMode::Enum mode)
+    : seconds_(std::max(static_cast<int64>(resolution.TotalSeconds()),
+                        static_cast<int64>(1))),
+      mode_(mode) {
 }
 
 Series SeriesSampler::Sample(const Series& series, const DateTime& start,
-              const DateTime& stop) {
+                             const DateTime& stop) const {
+  Series sampled(series.name, series.series_type);
+  Sample(series, start.ToEpochTime(), stop.ToEpochTime(), &sampled);
+  return sampled;
 }
 
-map<string, Chart> SeriesSampler::SampleCharts(const map<string, Chart>& charts,
-                                const DateTime& start,
-                                const DateTime& stop) {
+void SeriesSampler::Sample(const Series& series, int64 start, int64 stop,
+                           Series* sampled) const {
+  const int count = series.size();
+  const int64* times = series.times().data();
+  const double* values = series.values().data();
+  // Samples are added as live points: they are never compacted
+  if (series.series_type == SeriesType::kScatter ||
+      series.series_type == SeriesType::kBar || count < 2) {
+    // Distinct points are not interpolated, only the period is kept
+    for (int i = 0; i < count; ++i) {
+      if (start <= times[i] && times[i] <= stop) {
+        sampled->AddPoint(times[i], values[i], true);
+      }
+    }
+    return;
+  }
+  const int64 first = std::max(start, times[0]);
+  const int64 last = std::min(stop, times[count - 1]);
+  // times[current - 1] <= target <= times[current] for every target
+  int current = 1;
+  for (int64 target = first; target <= last; target += seconds_) {
+    while (current < count - 1 && times[current] < target) {
+      ++current;
+    }
+    double value;
+    if (times[current] == target) {
+      value = values[current];
+    } else if (mode_ == SamplingMode::kStep) {
+      value = values[current - 1];
+    } else {
+      value = Interpolate(times[current - 1], values[current - 1],
+                          times[current], values[current], target);
+    }
+    sampled->AddPoint(target, value, true);
+  }
 }
 
-double SeriesSampler::Interpolate(const ChartPoint& previous,
-                            const ChartPoint& current, int64 target) {
+map<string, Chart> SeriesSampler::SampleCharts(
+    const map<string, Chart>& charts, const DateTime& start,
+    const DateTime& stop) const {
+  map<string, Chart> sampled;
+  // Add every chart and series first, the threads only fill the series
+  vector<SampleJob> jobs;
+  for (map<string, Chart>::const_iterator it = charts.begin();
+       it != charts.end(); ++it) {
+    const Chart& source = it->second;
+    Chart& chart = sampled.insert(make_pair(
+        it->first, Chart(source.name, source.chart_type))).first->second;
+    for (Chart::SeriesMap::const_iterator it_s = source.series_map.begin();
+         it_s != source.series_map.end(); ++it_s) {
+      jobs.push_back(make_pair(&it_s->second, chart.GetSeries(
+          it_s->second.name, it_s->second.series_type)));
+    }
+  }
+  const int64 start_time = start.ToEpochTime();
+  const int64 stop_time = stop.ToEpochTime();
+  const int job_count = static_cast<int>(jobs.size());
+  int thread_count = std::min(
+      static_cast<int>(std::thread::hardware_concurrency()),
+      job_count / kSeriesPerThread);
+  if (thread_count < 2) {
+    SampleJobs(&jobs, 0, 1, start_time, stop_time);
+    return sampled;
+  }
+  vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.push_back(std::thread(&SeriesSampler::SampleJobs, this, &jobs, t,
+                                  thread_count, start_time, stop_time));
+  }
+  for (int t = 0; t < thread_count; ++t) {
+    threads[t].join();
+  }
+  return sampled;
+}
+
+void SeriesSampler::SampleJobs(const vector<SampleJob>* jobs, int first,
+                               int step, int64 start, int64 stop) const {
+  const int count = static_cast<int>(jobs->size());
+  for (int i = first; i < count; i += step) {
+    Sample(*(*jobs)[i].first, start, stop, (*jobs)[i].second);
+  }
 }
 }  // namespace quantsystem
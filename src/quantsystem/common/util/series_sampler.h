@@ -22,21 +22,42 @@
 
 #include <map>
 using std::map;
+#include <utility>
+using std::pair;
+#include <vector>
+using std::vector;
 #include "quantsystem/common/time/date_time.h"
 #include "quantsystem/common/time/time_span.h"
 #include "quantsystem/common/base/integral_types.h"
 #include "quantsystem/common/util/charting.h"
 
 namespace quantsystem {
+/**
+ * Value of a series between two of its points.
+ */
+namespace SamplingMode {
+enum Enum {
+  // Linear interpolation between the surrounding points
+  kLinear,
+  // Value of the last point at or before the sample time
+  kStep
+};
+};  // namespace SamplingMode
+
 /**
  * A type capable of taking a chart and resampling using
  * a linear interpolation strategy.
+ *
+ * Line and candle series are sampled on a uniform time grid in one
+ * pass over their time and value columns, scatter and bar series keep
+ * their points within the period. The series of several charts are
+ * sampled in parallel.
  * @ingroup CommonBaseUtil
  */
 class SeriesSampler {
  public:
   /**
-   * Standard constructor.
+   * Standard constructor: daily linear sampling.
    */
   SeriesSampler();
 
@@ -44,8 +65,10 @@ class SeriesSampler {
    * Creates a new SeriesSampler to sample Series data
    * on the specified resolution
    * @param resolution The desired sampling resolution.
+   * @param mode Interpolation between the points of the series
    */
-  explicit SeriesSampler(const TimeSpan& resolution);
+  explicit SeriesSampler(const TimeSpan& resolution,
+                         SamplingMode::Enum mode = SamplingMode::kLinear);
 
   /**
    * Standard destructor.
@@ -62,7 +85,7 @@ class SeriesSampler {
    * @return The sampled series
    */
   Series Sample(const Series& series, const DateTime& start,
-                const DateTime& stop);
+                const DateTime& stop) const;
 
   /**
    * Samples the given charts
@@ -73,17 +96,41 @@ class SeriesSampler {
    */
   map<string, Chart> SampleCharts(const map<string, Chart>& charts,
                                   const DateTime& start,
-                                  const DateTime& stop);
+                                  const DateTime& stop) const;
 
  private:
-  double seconds_;
+  // Series sampled by each thread of SampleCharts at least
+  static const int kSeriesPerThread = 4;
+  // Input series and the empty series its samples go to
+  typedef pair<const Series*, Series*> SampleJob;
+  int64 seconds_;
+  SamplingMode::Enum mode_;
+
+  /**
+   * Sample a series into an empty series.
+   */
+  void Sample(const Series& series, int64 start, int64 stop,
+              Series* sampled) const;
+
+  /**
+   * Sample the jobs first, first + step, first + 2 * step, ...
+   * Entry point of the threads of SampleCharts.
+   */
+  void SampleJobs(const vector<SampleJob>* jobs, int first, int step,
+                  int64 start, int64 stop) const;
 
   /**
    * Linear interpolation used for sampling.
    */
-  static double Interpolate(const ChartPoint& previous,
-                            const ChartPoint& current,
-                            int64 target);
+  static double Interpolate(int64 previous_time, double previous_value,
+                            int64 current_time, double current_value,
+                            int64 target) {
+    if (current_time == previous_time) {
+      return current_value;
+    }
+    return previous_value + (current_value - previous_value) *
+        (target - previous_time) / (current_time - previous_time);
+  }
 };
 
 }  // namespace quantsystem
@@ -0,0 +1,89 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::string;
+#include <thread>
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/util/bounded_queue.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+TEST(BoundedQueue, TestFullAndEmpty) {
+  BoundedQueue<string> queue(3);
+  EXPECT_EQ(4, queue.capacity());
+  EXPECT_TRUE(queue.empty());
+  string item;
+  EXPECT_FALSE(queue.TryPop(&item));
+  // Wrap around the ring a few times
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(queue.TryPush(std::to_string(round * 10 + i)));
+    }
+    EXPECT_FALSE(queue.TryPush("full"));
+    EXPECT_EQ(4, queue.size());
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(queue.TryPop(&item));
+      EXPECT_EQ(std::to_string(round * 10 + i), item);
+    }
+    EXPECT_FALSE(queue.TryPop(&item));
+  }
+}
+
+static void Produce(BoundedQueue<int>* queue, int first, int count) {
+  for (int i = first; i < first + count; ++i) {
+    while (!queue->TryPush(i)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+TEST(BoundedQueue, TestConcurrentProducers) {
+  const int kProducers = 4;
+  const int kItems = 20000;
+  BoundedQueue<int> queue(64);
+  vector<std::thread> producers;
+  for (int i = 0; i < kProducers; ++i) {
+    producers.push_back(std::thread(Produce, &queue, i * kItems, kItems));
+  }
+  // Every item arrives once and each producer's items stay in order
+  vector<int> last(kProducers, -1);
+  vector<bool> seen(kProducers * kItems, false);
+  int received = 0;
+  int item;
+  while (received < kProducers * kItems) {
+    if (!queue.TryPop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_FALSE(seen[item]);
+    seen[item] = true;
+    EXPECT_GT(item, last[item / kItems]);
+    last[item / kItems] = item;
+    ++received;
+  }
+  for (int i = 0; i < kProducers; ++i) {
+    producers[i].join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+}  // namespace quantsystem
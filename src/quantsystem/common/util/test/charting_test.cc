@@ -0,0 +1,141 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/util/charting.h"
+#include "quantsystem/common/util/chart_downsampler.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+TEST(Series, TestCompactionBoundsPointsAndKeepsExtremes) {
+  Series series("Equity");
+  series.set_max_points(100);
+  const int kCount = 100000;
+  for (int i = 0; i < kCount; ++i) {
+    // The drawdown bottom is a single point in the middle of the run
+    double value = i == kCount / 2 ? -50 : std::sin(i * 0.01);
+    series.AddPoint(static_cast<int64>(i) * 60, value);
+  }
+  EXPECT_LE(series.size(), 100);
+  EXPECT_EQ(0, series.time(0));
+  EXPECT_EQ(static_cast<int64>(kCount - 1) * 60,
+            series.time(series.size() - 1));
+  double low = 0;
+  for (int i = 1; i < series.size(); ++i) {
+    EXPECT_LT(series.time(i - 1), series.time(i));
+    low = std::min(low, series.value(i));
+  }
+  EXPECT_EQ(-50, low);
+
+  // Live series are never compacted
+  Series live("Live");
+  live.set_max_points(10);
+  for (int i = 0; i < 50; ++i) {
+    live.AddPoint(i, i, true);
+  }
+  EXPECT_EQ(50, live.size());
+}
+
+TEST(Series, TestCompactionIsUniformInTime) {
+  Series series("Equity");
+  series.set_max_points(100);
+  const int kCount = 100000;
+  for (int i = 0; i < kCount; ++i) {
+    series.AddPoint(static_cast<int64>(i) * 60, std::sin(i * 0.01));
+  }
+  ASSERT_LE(series.size(), 100);
+  EXPECT_GE(series.size(), 40);
+  // The early history is not thinned more than the recent one
+  const int64 middle = static_cast<int64>(kCount / 2) * 60;
+  int early = 0;
+  for (int i = 0; i < series.size(); ++i) {
+    if (series.time(i) < middle) {
+      ++early;
+    }
+  }
+  const int late = series.size() - early;
+  EXPECT_LE(std::abs(early - late), 4) << early << " " << late;
+  // Rebucketing whole buckets keeps the extremes of the raw points
+  double high = -2, low = 2;
+  for (int i = 0; i < series.size(); ++i) {
+    high = std::max(high, series.value(i));
+    low = std::min(low, series.value(i));
+  }
+  EXPECT_NEAR(1, high, 1e-4);
+  EXPECT_NEAR(-1, low, 1e-4);
+}
+
+TEST(Series, TestUpdatesAndDeltaEncoding) {
+  Series series("Price");
+  for (int i = 0; i < 10; ++i) {
+    series.AddPoint(1000 + i * 5, i);
+  }
+  EXPECT_EQ(10, series.GetUpdates().size());
+  series.AddPoint(2000, 10);
+  Series updates = series.GetUpdates();
+  ASSERT_EQ(1, updates.size());
+  EXPECT_EQ(2000, updates.time(0));
+  EXPECT_EQ(0, series.GetUpdates().size());
+
+  vector<int64> deltas;
+  series.EncodeTimes(&deltas);
+  EXPECT_EQ(1000, deltas[0]);
+  EXPECT_EQ(5, deltas[1]);
+  Series decoded;
+  decoded.DecodeTimes(deltas, series.values());
+  ASSERT_EQ(series.size(), decoded.size());
+  for (int i = 0; i < series.size(); ++i) {
+    EXPECT_EQ(series.time(i), decoded.time(i));
+    EXPECT_EQ(series.value(i), decoded.value(i));
+  }
+}
+
+TEST(ChartDownsampler, TestLargestTriangleKeepsSpike) {
+  Series series("Line");
+  for (int i = 0; i < 1000; ++i) {
+    series.AddPoint(i, i == 437 ? 100 : 0, true);
+  }
+  Series sampled;
+  ChartDownsampler::Downsample(series, 20, DownsampleMethod::kLargestTriangle,
+                               &sampled);
+  EXPECT_EQ(20, sampled.size());
+  EXPECT_EQ("Line", sampled.name);
+  EXPECT_EQ(0, sampled.time(0));
+  EXPECT_EQ(999, sampled.time(sampled.size() - 1));
+  bool has_spike = false;
+  for (int i = 0; i < sampled.size(); ++i) {
+    has_spike = has_spike || sampled.time(i) == 437;
+  }
+  EXPECT_TRUE(has_spike);
+
+  // Short series are kept as they are
+  Series few("Few");
+  for (int i = 0; i < 5; ++i) {
+    few.AddPoint(i, i, true);
+  }
+  ChartDownsampler::Downsample(few, 20, DownsampleMethod::kMinMax, &sampled);
+  EXPECT_EQ(5, sampled.size());
+}
+}  // namespace quantsystem
@@ -0,0 +1,106 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+
+#include "quantsystem/common/util/result_file.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+TEST(ResultFile, TestWriteAndRead) {
+  const string path = "result_file_test.bin";
+  const int kPoints = ResultFileWriter::kChunkRows + 10;
+  ResultFileWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  for (int i = 0; i < kPoints; ++i) {
+    writer.AddPoint("Strategy Equity", ChartType::kStacked, "Equity",
+                    SeriesType::kCandle, i * 60, 100000 + i);
+  }
+  writer.AddOrderEvent(120, 1, 3, "SPY", 10, 205.5);
+  writer.AddOrder(60, 1, 3, 0, "SPY", 10, 205.5);
+  map<string, string> statistics;
+  statistics["Total Trades"] = "1";
+  writer.SetStatistics(statistics);
+  ASSERT_TRUE(writer.Close());
+
+  ResultFileReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(ResultFileWriter::kVersion, reader.version());
+  // Two equity chunks, the events, the orders, statistics and strings
+  ASSERT_EQ(6, reader.section_count());
+  int64 points = 0;
+  int64 last_time = -1;
+  for (int i = 0; i < reader.section_count(); ++i) {
+    const ResultSection& section = reader.section(i);
+    if (section.type == ResultSectionType::kSeries) {
+      EXPECT_EQ("Strategy Equity", reader.GetString(section.name));
+      EXPECT_EQ("Equity", reader.GetString(section.series));
+      EXPECT_EQ(SeriesType::kCandle, section.series_type);
+      const int64* times =
+          reader.GetColumn<int64>(section, ResultColumn::kTime);
+      const double* values =
+          reader.GetColumn<double>(section, ResultColumn::kValue);
+      for (uint64 row = 0; row < section.rows; ++row) {
+        EXPECT_GT(times[row], last_time);
+        EXPECT_EQ(100000 + times[row] / 60, values[row]);
+        last_time = times[row];
+      }
+      points += section.rows;
+    } else if (section.type == ResultSectionType::kOrderEvents) {
+      ASSERT_EQ(1, section.rows);
+      EXPECT_EQ(1, *reader.GetColumn<int32>(section, ResultColumn::kOrderId));
+      EXPECT_EQ(205.5,
+                *reader.GetColumn<double>(section, ResultColumn::kPrice));
+      EXPECT_EQ("SPY", reader.GetString(
+          *reader.GetColumn<int32>(section, ResultColumn::kSymbol)));
+    }
+  }
+  EXPECT_EQ(kPoints, points);
+  string json;
+  reader.ToJson(&json);
+  EXPECT_NE(string::npos, json.find("\"Total Trades\" : \"1\""));
+  reader.Close();
+  std::remove(path.c_str());
+}
+
+TEST(ResultFile, TestUnclosedFileIsRejected) {
+  const string path = "result_file_unclosed_test.bin";
+  {
+    ResultFileWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    for (int i = 0; i < ResultFileWriter::kChunkRows; ++i) {
+      writer.AddPoint("Chart", ChartType::kOverlay, "Series",
+                      SeriesType::kLine, i, i);
+    }
+    // The first chunk is on disk, the index is not
+    ResultFileReader reader;
+    EXPECT_FALSE(reader.Open(path));
+  }
+  ResultFileReader reader;
+  EXPECT_TRUE(reader.Open(path));
+  std::remove(path.c_str());
+}
+}  // namespace quantsystem
@@ -0,0 +1,108 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+
+#include "quantsystem/common/util/series_sampler.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/time/time_span.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+TEST(SeriesSampler, TestLinearAndStepSampling) {
+  Series series("Equity");
+  series.AddPoint(0, 100.0, true);
+  series.AddPoint(40, 140.0, true);
+  series.AddPoint(100, 80.0, true);
+
+  SeriesSampler linear(TimeSpan::FromSeconds(20));
+  Series sampled = linear.Sample(series, DateTime(static_cast<time_t>(-50)),
+                                 DateTime(static_cast<time_t>(1000)));
+  // The grid is clipped to the data: 0, 20, ..., 100
+  ASSERT_EQ(6, sampled.size());
+  EXPECT_EQ("Equity", sampled.name);
+  EXPECT_EQ(0, sampled.time(0));
+  EXPECT_EQ(100, sampled.time(5));
+  EXPECT_DOUBLE_EQ(120, sampled.value(1));
+  EXPECT_DOUBLE_EQ(140, sampled.value(2));
+  EXPECT_DOUBLE_EQ(120, sampled.value(3));
+  EXPECT_DOUBLE_EQ(100, sampled.value(4));
+  EXPECT_DOUBLE_EQ(80, sampled.value(5));
+
+  SeriesSampler step(TimeSpan::FromSeconds(20), SamplingMode::kStep);
+  sampled = step.Sample(series, DateTime(static_cast<time_t>(10)),
+                        DateTime(static_cast<time_t>(90)));
+  ASSERT_EQ(5, sampled.size());
+  EXPECT_EQ(10, sampled.time(0));
+  EXPECT_EQ(100, sampled.value(0));
+  EXPECT_EQ(100, sampled.value(1));
+  EXPECT_EQ(140, sampled.value(2));
+  EXPECT_EQ(140, sampled.value(4));
+
+  // Scatter points are only clipped to the period
+  Series trades("Trades", SeriesType::kScatter);
+  trades.AddPoint(5, 1.0, true);
+  trades.AddPoint(7, 2.0, true);
+  trades.AddPoint(50, 3.0, true);
+  sampled = linear.Sample(trades, DateTime(static_cast<time_t>(6)),
+                          DateTime(static_cast<time_t>(100)));
+  ASSERT_EQ(2, sampled.size());
+  EXPECT_EQ(7, sampled.time(0));
+}
+
+TEST(SeriesSampler, TestParallelChartsMatchSerialSampling) {
+  map<string, Chart> charts;
+  for (int c = 0; c < 8; ++c) {
+    string chart_name = "Chart" + std::to_string(c);
+    Chart& chart = charts.insert(std::make_pair(
+        chart_name, Chart(chart_name))).first->second;
+    for (int s = 0; s < 4; ++s) {
+      Series* series = chart.GetSeries("Series" + std::to_string(s));
+      for (int i = 0; i < 1000; ++i) {
+        series->AddPoint(static_cast<int64>(i) * 7, c * 100 + s * 10 + i,
+                         true);
+      }
+    }
+  }
+  SeriesSampler sampler(TimeSpan::FromSeconds(30));
+  DateTime start(static_cast<time_t>(0));
+  DateTime stop(static_cast<time_t>(7000));
+  map<string, Chart> sampled = sampler.SampleCharts(charts, start, stop);
+  ASSERT_EQ(charts.size(), sampled.size());
+  for (map<string, Chart>::iterator it = charts.begin(); it != charts.end();
+       ++it) {
+    Chart& chart = sampled[it->first];
+    ASSERT_EQ(4, chart.series_map.size());
+    for (Chart::SeriesMap::iterator it_s = it->second.series_map.begin();
+         it_s != it->second.series_map.end(); ++it_s) {
+      Series expected = sampler.Sample(it_s->second, start, stop);
+      const Series& actual = chart.series_map[it_s->first];
+      ASSERT_EQ(expected.size(), actual.size());
+      for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected.time(i), actual.time(i));
+        EXPECT_EQ(expected.value(i), actual.value(i));
+      }
+    }
+  }
+}
+}  // namespace quantsystem
@@ -74,21 +74,14 @@ void AlgorithmManager::Run(
       frontier_ = time;
       // Refresh the realtime event monitor
       realtime->SetTime(time);
-      // Fire EOD if the time packet we just processed is greater
-      if (backtest_mode && (previous_time_.Date() != time.Date())) {
+      // Fire EOD if the time packet we just processed is greater, in
+      // live runs too so their runtime statistics have daily returns
+      if (previous_time_.Date() != time.Date()) {
         // Sample the portfolio value over time for chart
-        results->SampleEquity(previous_time_,
-                              algorithm->portfolio()->TotalPortfolioValue());
-        if (starting_performance == 0) {
-          results->SamplePerformance(previous_time_.Date(), 0);
-        } else {
-          double performance_percent =
-              (algorithm->portfolio()->TotalPortfolioValue() -
-               starting_performance) * 100 / starting_performance;
-          results->SamplePerformance(previous_time_.Date(),
-                                     performance_percent);
-        }
-        starting_performance = algorithm->portfolio()->TotalPortfolioValue();
+        double equity = algorithm->portfolio()->TotalPortfolioValue();
+        results->SampleEquity(previous_time_, equity);
+        SampleDailyPerformance(results, previous_time_.Date(), equity,
+                               &starting_performance);
       }
       if (algorithm->GetQuit()) {
         algorithm_state_ = AlgorithmStatus::kQuit;
@@ -98,14 +91,14 @@ void AlgorithmManager::Run(
       // Trigger the data events
       scoped_ptr<TradeBars> new_bars(new TradeBars(time));
       scoped_ptr<Ticks> new_ticks(new Ticks(time));
+      // Update the securities properties with the whole slice:
+      // first before calling user code to avoid issues with data
+      algorithm->securities()->Update(time, it->second);
       // map<int, vector<BaseData*>>
       for (DataStream::BaseDataVectorMap::iterator map_it = it->second.begin();
          map_it != it->second.end(); ++map_it) {
         SubscriptionDataConfig* config = feed->subscriptions()[map_it->first];
         for (BaseData* data_point :  map_it->second) {
-          // Update the securities properties:
-          // first before calling user code to avoid issues with data
-          algorithm->securities()->Update(time, data_point);
           // Update registered consolidators for this symbol index
           for (int i = 0; i < config->consolidators.size(); ++i) {
             config->consolidators[i]->Update(data_point);
@@ -140,10 +133,32 @@ void AlgorithmManager::Run(
           std::this_thread::yield();
         }
       }
+      // Track the equity of every slice, only the daily summaries are
+      // charted so intrabar drawdowns count without storing the curve
+      double equity = algorithm->portfolio()->TotalPortfolioValue();
+      if (results->mutable_statistics()->AddEquity(time, equity)) {
+        SampleDay(results,
+                  results->statistics().equity_tracker().last_day());
+      }
+      // Margin is tracked incrementally, check it at every slice
+      vector<int> margin_call_orders;
+      if (algorithm->portfolio()->ScanForMarginCall(&margin_call_orders) &&
+          !margin_call_orders.empty()) {
+        results->DebugMessage("Margin call: liquidating " +
+                              std::to_string(margin_call_orders.size()) +
+                              " positions.");
+      }
       if (time > next_sample_) {
         next_sample_ = time + results->resample_period();
-        results->SampleEquity(time,
-                              algorithm->portfolio()->TotalPortfolioValue());
+        results->SampleEquity(time, equity);
+        if (!backtest_mode) {
+          // Live runs show the statistics accumulated so far
+          map<string, string> statistics;
+          results->statistics().GetStatistics(&statistics);
+          for (pair<const string, string>& statistic : statistics) {
+            results->RuntimeStatistic(statistic.first, statistic.second);
+          }
+        }
         vector<Chart> charts;
         algorithm->GetChartUpdates(&charts);
         results->SampleRange(charts);
@@ -185,8 +200,12 @@ void AlgorithmManager::Run(
   vector<Chart> charts;
   algorithm->GetChartUpdates(&charts);
   results->SampleRange(charts);
-  results->SampleEquity(frontier_,
-                        algorithm->portfolio()->TotalPortfolioValue());
+  double equity = algorithm->portfolio()->TotalPortfolioValue();
+  results->mutable_statistics()->AddEquity(frontier_, equity);
+  if (results->statistics().equity_tracker().has_equity()) {
+    SampleDay(results, results->statistics().equity_tracker().day());
+  }
+  results->SampleEquity(frontier_, equity);
   double performance_percent =
       (algorithm->portfolio()->TotalPortfolioValue() -
        starting_performance) * 100 / starting_performance;
@@ -214,6 +233,31 @@ void AlgorithmManager::ProcessMessages(IResultHandler* results,
   algorithm->runtime_statistics().clear();
 }
 
+void AlgorithmManager::SampleDailyPerformance(IResultHandler* results,
+                                              const DateTime& date,
+                                              double equity,
+                                              double* starting_performance) {
+  if (*starting_performance == 0) {
+    results->SamplePerformance(date, 0);
+  } else {
+    double performance_percent =
+        (equity - *starting_performance) * 100 / *starting_performance;
+    results->SamplePerformance(date, performance_percent);
+  }
+  *starting_performance = equity;
+}
+
+void AlgorithmManager::SampleDay(IResultHandler* results,
+                                 const statistics::EquityTracker::Day& day) {
+  DateTime date(static_cast<time_t>(day.date));
+  results->Sample("Strategy Equity", ChartType::kOverlay, "Daily High",
+                  SeriesType::kLine, date, day.high);
+  results->Sample("Strategy Equity", ChartType::kOverlay, "Daily Low",
+                  SeriesType::kLine, date, day.low);
+  results->Sample("Drawdown", ChartType::kOverlay, "Drawdown",
+                  SeriesType::kLine, date, -day.max_drawdown * 100);
+}
+
 void AlgorithmManager::ResetManager() {
   next_sample_ = DateTime();
   frontier_ = DateTime();
@@ -106,6 +106,18 @@ class AlgorithmManager {
 
   static string* runtime_error() { return runtime_error_.get(); }
 
+  /**
+   * Sample the performance of the day which just ended.
+   * @param results Result handler receiving the sample
+   * @param date Day which ended
+   * @param equity Total portfolio value at the end of the day
+   * @param starting_performance[out] Portfolio value at the start of
+   * the day, set to equity for the next day
+   */
+  static void SampleDailyPerformance(IResultHandler* results,
+                                     const DateTime& date, double equity,
+                                     double* starting_performance);
+
  private:
   static DateTime previous_time_;
   // Current time horizon of the algorithm
@@ -115,6 +127,15 @@ class AlgorithmManager {
   // Currently running algorithm id
   static string algorithm_id_;
   static scoped_ptr<string> runtime_error_;
+
+  /**
+   * Chart the summary of one day of the equity tracker: the daily
+   * high and low equity and the deepest drawdown of the day.
+   * @param results Result handler receiving the samples
+   * @param day Day summary of the equity tracker
+   */
+  static void SampleDay(IResultHandler* results,
+                        const statistics::EquityTracker::Day& day);
 };
 
 }  // namespace engine
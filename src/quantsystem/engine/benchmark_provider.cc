@@ -0,0 +1,98 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <typeinfo>
+#include <utility>
+using std::make_pair;
+#include <vector>
+using std::vector;
+#include "quantsystem/algorithm/history_reader.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/data/subscription_data_config.h"
+#include "quantsystem/common/strings/case.h"
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/engine/benchmark_provider.h"
+namespace quantsystem {
+using algorithm::HistoryReader;
+using data::SubscriptionDataConfig;
+using data::market::TradeBar;
+namespace engine {
+BenchmarkProvider::BenchmarkProvider() {
+}
+
+BenchmarkProvider::~BenchmarkProvider() {
+  STLDeleteValues(&entries_);
+}
+
+const BenchmarkSeries* BenchmarkProvider::Get(const string& symbol,
+                                              SecurityType::Enum type,
+                                              const DateTime& start,
+                                              const DateTime& end) {
+  string key = symbol;
+  UpperString(&key);
+  EntryMap::iterator found = entries_.find(key);
+  Entry* entry;
+  if (found == entries_.end()) {
+    entry = new Entry();
+    entry->start = start.Date();
+    entry->end = end.Date();
+    entries_.insert(make_pair(key, entry));
+    Read(key, type, entry->start, entry->end, &entry->series);
+  } else {
+    entry = found->second;
+    if (start.Date() < entry->start || entry->end < end.Date()) {
+      // Read the union of the periods so the series stays contiguous
+      if (start.Date() < entry->start) {
+        entry->start = start.Date();
+      }
+      if (entry->end < end.Date()) {
+        entry->end = end.Date();
+      }
+      entry->series.Clear();
+      Read(key, type, entry->start, entry->end, &entry->series);
+    }
+  }
+  return entry->series.empty() ? NULL : &entry->series;
+}
+
+int BenchmarkProvider::Read(const string& symbol, SecurityType::Enum type,
+                            const DateTime& start, const DateTime& end,
+                            BenchmarkSeries* series) {
+  SubscriptionDataConfig config(typeid(TradeBar).name(), type, symbol,
+                                Resolution::kDaily, false);
+  HistoryReader reader;
+  int days = 0;
+  for (DateTime date = start; !(end < date);
+       date += TimeSpan::FromDays(1)) {
+    vector<TradeBar*> bars;
+    if (reader.ReadDay(config, date, &bars) && !bars.empty()) {
+      series->AddClose(date, bars.back()->close());
+      ++days;
+    }
+    STLDeleteElements(&bars);
+  }
+  if (days == 0) {
+    LOG(ERROR) << "No benchmark data for " << symbol << " from " <<
+        start.ToShortString() << " to " << end.ToShortString();
+  }
+  return days;
+}
+}  // namespace engine
+}  // namespace quantsystem
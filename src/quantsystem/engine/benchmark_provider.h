@@ -0,0 +1,94 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_ENGINE_BENCHMARK_PROVIDER_H_
+#define QUANTSYSTEM_ENGINE_BENCHMARK_PROVIDER_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include "quantsystem/common/global.h"
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/statistics/benchmark_series.h"
+namespace quantsystem {
+using statistics::BenchmarkSeries;
+namespace engine {
+/**
+ * Daily closes of the benchmark symbols read from the local data store.
+ *
+ * The day files are the ones SubscriptionDataReader reads for a daily
+ * TradeBar subscription of the benchmark symbol; the close of the last
+ * bar of each file is kept in a BenchmarkSeries. The series are cached
+ * per symbol for the life of the provider, so the algorithms run by the
+ * same engine process parse each day file once.
+ * @ingroup EngineLayer
+ * @see StatisticsAccumulator
+ */
+class BenchmarkProvider {
+ public:
+  /**
+   * Standard constructor.
+   */
+  BenchmarkProvider();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~BenchmarkProvider();
+
+  /**
+   * Get the daily closes of a benchmark over a period, reading the
+   * day files not yet cached.
+   * @param symbol Benchmark symbol, e.g. "SPY"
+   * @param type Security type of the benchmark
+   * @param start First day of the period
+   * @param end Last day of the period
+   * @return Series owned by the provider, NULL if no day has data.
+   */
+  const BenchmarkSeries* Get(const string& symbol, SecurityType::Enum type,
+                             const DateTime& start, const DateTime& end);
+
+ private:
+  /**
+   * Cached closes of one symbol and the period read for them.
+   */
+  class Entry {
+   public:
+    BenchmarkSeries series;
+    DateTime start;
+    DateTime end;
+  };
+  typedef map<string, Entry*> EntryMap;
+  EntryMap entries_;
+
+  /**
+   * Read the closes of every day of the period.
+   * @return Number of days with data.
+   */
+  static int Read(const string& symbol, SecurityType::Enum type,
+                  const DateTime& start, const DateTime& end,
+                  BenchmarkSeries* series);
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkProvider);
+};
+}  // namespace engine
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_ENGINE_BENCHMARK_PROVIDER_H_
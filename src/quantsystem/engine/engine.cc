@@ -35,8 +35,6 @@ using std::queue;
 #include "quantsystem/common/strings/join.h"
 #include "quantsystem/common/base/scoped_ptr.h"
 using namespace quantsystem;  // NOLINT
-#include "quantsystem/common/statistics/statistics.h"
-using statistics::Statistics;
 #include "quantsystem/configuration/configuration.h"
 using configuration::Config;
 #include "quantsystem/interfaces/iapi.h"
@@ -95,6 +93,8 @@ using engine::transaction_handlers::TradierTransactionHandler;
 using engine::transaction_handlers::BacktestingTransactionHandler;
 #include "quantsystem/engine/algorithm_manager.h"
 using engine::AlgorithmManager;
+#include "quantsystem/engine/benchmark_provider.h"
+using engine::BenchmarkProvider;
 
 namespace quantsystem {
 
@@ -280,36 +280,12 @@ static ITransactionHandler* GetTransactionHandler(
   return th;
 }
 
-const Statistics::ChartPointVector&
-GetChartPoints(const IResultHandler::ChartsMap& charts,
-               const string& charts_name,
-               const string& series_name) {
-  return charts.at(charts_name)->series_map.at(series_name).values;
-}
-
-bool ChartsHasTheSeries(const IResultHandler::ChartsMap& charts,
-                        const string& charts_name,
-                        const string& series_name) {
-  bool res = false;
-  IResultHandler::ChartsMap::const_iterator found_chart =
-      charts.find(charts_name);
-  if (found_chart != charts.end()) {
-    Chart::SeriesMap::const_iterator found_serie =
-        found_chart->second->series_map.find(series_name);
-    if (found_serie != found_chart->second->series_map.end()) {
-      res = true;
-    }
-  }
-  return res;
-}
-
 void DoStatisAndSendResult(AlgorithmNodePacket* job,
                            const IAlgorithm* algorithm,
                            const ITransactionHandler* transaction_handler,
                            const ISetupHandler* setup_handler,
                            IResultHandler* result_handler) {
   // Send result data back
-  const IResultHandler::ChartsMap& charts = result_handler->charts();
   const securities::OrderMap& orders = transaction_handler->orders();
   map<string, Holding> holdings;
   map<string, string> statistics;
@@ -317,20 +293,13 @@ void DoStatisAndSendResult(AlgorithmNodePacket* job,
 
   const securities::TransactionMap& profit_loss =
       algorithm->transactions()->transaction_record();
-  if (ChartsHasTheSeries(charts, "Strategy Equity", "Equity") &&
-      ChartsHasTheSeries(charts, "Strategy Equity", "Daily Performance")) {
-    const Statistics::ChartPointVector& equity =
-        GetChartPoints(charts, "Strategy Equity", "Equity");
-    const Statistics::ChartPointVector& performance =
-        GetChartPoints(charts, "Strategy Equity", "Daily Performance");
-    if (equity.empty() || performance.empty() || profit_loss.empty()) {
-      LOG(ERROR) << "Error generating statistics results";
-    } else {
-      Statistics::Generate(equity, profit_loss, performance,
-                         setup_handler->starting_capital(), &statistics, 252);
-    }
-  } else {
+  // The statistics were accumulated during the run from the equity and
+  // performance samples and the closed trades.
+  const StatisticsAccumulator& accumulator = result_handler->statistics();
+  if (accumulator.trading_days() == 0 || profit_loss.empty()) {
     LOG(ERROR) << "Error generating statistics results";
+  } else {
+    accumulator.GetStatistics(&statistics);
   }
   // Diagnostics Completed
   result_handler->DebugMessage("Algorithm Id:(" + job->AlgorithmId() +
@@ -360,6 +329,8 @@ int main(int argc, char* argv[]) {
   notify->Initialize();
   queue->Initialize(live_mode_);
   api->Initialize();
+  // Benchmark closes are cached for every algorithm run by this process
+  BenchmarkProvider benchmarks;
 
   do {
     // Reset algo manager internal variables preparing for a new algorithm.
@@ -399,6 +370,17 @@ int main(int argc, char* argv[]) {
     algorithm->SetLocked();
     // Load the associated handlers for data, transaction and realtime events
     result_handler->SetAlgorithm(algorithm.get());
+    // Accumulate the statistics while the algorithm runs
+    result_handler->mutable_statistics()->Initialize(
+        setup_handler->starting_capital());
+    algorithm->portfolio()->set_statistics(
+        result_handler->mutable_statistics());
+    if (!live_mode_) {
+      result_handler->mutable_statistics()->set_benchmark(
+          benchmarks.Get(Config::Get("benchmark-symbol", "SPY"),
+                         SecurityType::kEquity, algorithm->start_date(),
+                         algorithm->end_date()));
+    }
     scoped_ptr<IDataFeed> data_feed(
         GetDataFeedHandler(algorithm.get(),
                            brokerage.get(),
@@ -17,21 +17,179 @@
  * @}
  */
 
+#include <glog/logging.h>
+#include <ctime>
+#include "quantsystem/common/strings/join.h"
+#include "quantsystem/common/util/series_sampler.h"
+#include "quantsystem/configuration/configuration.h"
 #include "quantsystem/engine/results/backtesting_result_handler.h"
 namespace quantsystem {
+using configuration::Config;
 namespace engine {
 namespace results {
 BacktestingResultHandler::BacktestingResultHandler(
-    const BacktestNodePacket* job_) {
+    const BacktestNodePacket* job)
+    : exit_triggered_(false),
+      job_(job),
+      job_days_(0),
+      algorithm_(NULL),
+      days_processed_(0),
+      last_days_processed_(0),
+      processing_final_packet_(false),
+      debug_message_count_(0),
+      debug_message_min_(0),
+      debug_message_max_(0),
+      debug_message_length_(0),
+      queue_(ResultQueue::CreateFromConfig()),
+      result_path_(Config::Get("result-file", "")),
+      json_path_(Config::Get("result-json-file", "")),
+      flush_period_ms_(Config::GetInt("result-flush-ms", 1000)),
+      max_log_lines_(Config::GetInt("result-max-log-lines", 10000)) {
+  LOG(INFO) << "Launching Backtesting Result Handler";
+  is_active_ = true;
+  compile_id_ = job_->compile_id;
+  backtest_id_ = job_->backtest_id;
+  start_time_ = DateTime();
+  // Sample the equity 4000 times over the backtest, at most once a minute
+  const double kSamples = 4000;
+  double total_minutes = (job_->period_finish -
+                          job_->period_start).TotalMinutes();
+  job_days_ = static_cast<int>(total_minutes / (24 * 60));
+  resample_period_ = TimeSpan::FromMinutes(
+      total_minutes > kSamples ? total_minutes / kSamples : 1);
+  notification_period_ = TimeSpan::FromMilliseconds(flush_period_ms_);
+  if (!result_path_.empty()) {
+    result_file_.Open(result_path_);
+  }
+}
+
+BacktestingResultHandler::~BacktestingResultHandler() {
 }
 
 void BacktestingResultHandler::Run() {
+  LOG(INFO) << "BacktestingResultHandler: Starting Thread.";
+  while (!exit_triggered_.load()) {
+    queue_->WaitForFlush(flush_period_ms_);
+    while (Flush() >= kMaxBatchSize) {
+    }
+  }
+  // Exit is triggered once the producing threads are done: take the rest
+  while (Flush() > 0) {
+  }
+  if (result_file_.is_open()) {
+    CloseResultFile();
+  }
+  if (processing_final_packet_) {
+    BuildFinalPacket();
+  }
+  if (queue_->overflow_count() > 0) {
+    LOG(INFO) << "BacktestingResultHandler: " << queue_->overflow_count() <<
+        " records did not fit in the result queue of " <<
+        queue_->capacity();
+  }
+  LOG(INFO) << "BacktestingResultHandler: Ending Thread.";
+  is_active_ = false;
+}
+
+int BacktestingResultHandler::Flush() {
+  int count = queue_->Drain(kMaxBatchSize, &batch_);
+  for (int i = 0; i < count; ++i) {
+    Process(batch_[i]);
+  }
+  return count;
+}
+
+void BacktestingResultHandler::CloseResultFile() {
+  for (vector<Order>::const_iterator it = final_orders_.begin();
+       it != final_orders_.end(); ++it) {
+    result_file_.AddOrder(it->time.ToEpochTime(), it->id, it->status,
+                          it->type, it->symbol, it->quantity, it->price);
+  }
+  result_file_.SetStatistics(final_statistics_);
+  if (!result_file_.Close() || json_path_.empty()) {
+    return;
+  }
+  ResultFileReader reader;
+  string json;
+  if (reader.Open(result_path_)) {
+    reader.ToJson(&json);
+    if (!File::WritePath(json_path_, json).ok()) {
+      LOG(ERROR) << "Unable to write the JSON results: " << json_path_;
+    }
+  }
+}
+
+void BacktestingResultHandler::BuildFinalPacket() {
+  map<string, Chart> charts;
+  for (ChartsMap::const_iterator it = charts_.begin();
+       it != charts_.end(); ++it) {
+    charts.insert(std::make_pair(it->first, *it->second));
+  }
+  map<int, Order> orders;
+  for (vector<Order>::const_iterator it = final_orders_.begin();
+       it != final_orders_.end(); ++it) {
+    orders[it->id] = *it;
+  }
+  SeriesSampler sampler(resample_period_);
+  packets::BacktestResult result(
+      sampler.SampleCharts(charts, job_->period_start, job_->period_finish),
+      orders, final_profit_loss_, final_statistics_);
+  final_packet_.reset(new BacktestResultPacket(*job_, result));
+}
+
+void BacktestingResultHandler::Process(const ResultRecord& record) {
+  switch (record.type) {
+    case ResultRecordType::kLog:
+      if (static_cast<int>(log_.size()) < max_log_lines_) {
+        log_.push_back(record.text);
+      }
+      break;
+    case ResultRecordType::kDebug:
+      LOG(INFO) << "Debug Message:" << record.text;
+      break;
+    case ResultRecordType::kError:
+    case ResultRecordType::kRuntimeError:
+      LOG(ERROR) << "Error Message:" << record.text << " " << record.detail;
+      error_message_ = record.text;
+      break;
+    case ResultRecordType::kOrderEvent:
+      result_file_.AddOrderEvent(record.time, record.id, record.status,
+                                 record.name, record.quantity, record.value);
+      break;
+    case ResultRecordType::kSample:
+      RegisterSeries(record.name, record.chart_type, record.series,
+                     record.series_type)->AddPoint(record.time, record.value);
+      result_file_.AddPoint(record.name, record.chart_type, record.series,
+                            record.series_type, record.time, record.value);
+      break;
+    default:
+      break;
+  }
+}
+
+int64 BacktestingResultHandler::AlgorithmTime() const {
+  if (algorithm_ == NULL) {
+    return std::time(NULL);
+  }
+  return algorithm_->time().ToEpochTime();
+}
+
+void BacktestingResultHandler::PushMessage(ResultRecordType::Enum type,
+                                           const string& text,
+                                           const string& detail) {
+  ResultRecord record;
+  record.type = type;
+  record.time = AlgorithmTime();
+  record.text = text;
+  record.detail = detail;
+  queue_->Push(record);
 }
 
 void BacktestingResultHandler::ProcessSeriesUpdate() {
 }
 
 void BacktestingResultHandler::DebugMessage(const string& message) {
+  PushMessage(ResultRecordType::kDebug, message);
 }
 
 void BacktestingResultHandler::SecurityType(
@@ -39,14 +197,17 @@ void BacktestingResultHandler::SecurityType(
 }
 
 void BacktestingResultHandler::LogMessage(const string& message) {
+  PushMessage(ResultRecordType::kLog, message);
 }
 
 void BacktestingResultHandler::ErrorMessage(const string& error,
                                            const string& stacktrace) {
+  PushMessage(ResultRecordType::kError, error, stacktrace);
 }
 
 void BacktestingResultHandler::RuntimeError(const string& message,
                                            const string& stacktrace ) {
+  PushMessage(ResultRecordType::kRuntimeError, message, stacktrace);
 }
 
 void BacktestingResultHandler::Sample(const string& chart_name,
@@ -55,14 +216,43 @@ void BacktestingResultHandler::Sample(const string& chart_name,
                                      SeriesType::Enum series_type,
                                      const DateTime& time,
                                      double value) {
+  ResultRecord record;
+  record.type = ResultRecordType::kSample;
+  record.time = time.ToEpochTime();
+  record.value = value;
+  record.chart_type = chart_type;
+  record.series_type = series_type;
+  record.name = chart_name;
+  record.series = series_name;
+  queue_->Push(record);
 }
 
 void BacktestingResultHandler::SampleAssetPrices(const string& symbol,
                                                 const DateTime& time,
                                                 double value) {
+  Sample("Stockplot: " + symbol, ChartType::kOverlay, "Stockplot: " + symbol,
+         SeriesType::kLine, time, value);
 }
 
 void BacktestingResultHandler::SampleRange(const vector<Chart>& samples) {
+  ResultRecord record;
+  record.type = ResultRecordType::kSample;
+  for (vector<Chart>::const_iterator it = samples.begin();
+       it != samples.end(); ++it) {
+    record.name = it->name;
+    record.chart_type = it->chart_type;
+    for (Chart::SeriesMap::const_iterator it_s = it->series_map.begin();
+         it_s != it->series_map.end(); ++it_s) {
+      const Series& series = it_s->second;
+      record.series = series.name;
+      record.series_type = series.series_type;
+      for (int i = 0; i < series.size(); ++i) {
+        record.time = series.time(i);
+        record.value = series.value(i);
+        queue_->Push(record);
+      }
+    }
+  }
 }
 
 void BacktestingResultHandler::StoreResult(
@@ -76,11 +266,26 @@ void BacktestingResultHandler::SendFinalResult(
     const map<string, Holding>& holdings,
     const map<string, string>& statistics,
     const map<string, string>& banner) {
+  processing_final_packet_ = true;
+  for (map<string, string>::const_iterator it = statistics.begin();
+       it != statistics.end(); ++it) {
+    LOG(INFO) << "Statistics:" << it->first << it->second;
+  }
+  // Read by the result thread once Exit() is triggered
+  final_orders_.clear();
+  for (securities::OrderMap::const_iterator it = orders.begin();
+       it != orders.end(); ++it) {
+    final_orders_.push_back(*it->second);
+  }
+  final_profit_loss_ = profit_loss;
+  final_statistics_ = statistics;
 }
 
 void BacktestingResultHandler::SendStatusUpdate(const string& algorithm_id,
                                                AlgorithmStatus::Enum status,
                                                const string& message) {
+  LOG(INFO) << "SendStatusUpdate(): Algorithm status:" <<
+      AlgorithmStatus::AlgorithmStatusToString(status) << ":" << message;
 }
 
 void BacktestingResultHandler::RuntimeStatistic(
@@ -88,16 +293,32 @@ void BacktestingResultHandler::RuntimeStatistic(
 }
 
 void BacktestingResultHandler::SendOrderEvent(const OrderEvent* new_event) {
+  ResultRecord record;
+  record.type = ResultRecordType::kOrderEvent;
+  record.time = AlgorithmTime();
+  record.id = new_event->order_id;
+  record.status = new_event->status;
+  record.quantity = new_event->fill_quantity;
+  record.value = new_event->fill_price;
+  record.name = new_event->symbol;
+  record.text = new_event->message;
+  queue_->Push(record);
 }
 
 void BacktestingResultHandler::Exit() {
+  exit_triggered_.store(true);
+  queue_->RequestFlush();
 }
 
 void BacktestingResultHandler::PurgeQueue() {
+  vector<ResultRecord> purged;
+  while (queue_->Drain(kMaxBatchSize, &purged) > 0) {
+  }
 }
 
 string BacktestingResultHandler::ProcessLogMessages(
     const AlgorithmNodePacket& job) {
+  return common::strings::Join(log_, "\n");
 }
 
 }  // namespace results
@@ -20,6 +20,7 @@
 #ifndef QUANTSYSTEM_ENGINE_RESULTS_BACKTESTING_RESULT_HANDLER_H_
 #define QUANTSYSTEM_ENGINE_RESULTS_BACKTESTING_RESULT_HANDLER_H_
 
+#include <atomic>
 #include <vector>
 using std::vector;
 #include <string>
@@ -27,6 +28,8 @@ using std::string;
 #include <map>
 using std::map;
 #include "quantsystem/common/global.h"
+#include "quantsystem/common/base/scoped_ptr.h"
+#include "quantsystem/common/util/result_file.h"
 #include "quantsystem/common/util/charting.h"
 #include "quantsystem/common/time/date_time.h"
 #include "quantsystem/common/packets/packet.h"
@@ -34,7 +37,9 @@ using std::map;
 #include "quantsystem/common/orders/order_event.h"
 #include "quantsystem/interfaces/ialgorithm.h"
 #include "quantsystem/engine/results/iresult_handler.h"
+#include "quantsystem/engine/results/result_queue.h"
 #include "quantsystem/common/packets/backtest_node_packet.h"
+#include "quantsystem/common/packets/backtest_result_packet.h"
 #include "quantsystem/common/packets/algorithm_node_packet.h"
 #include "quantsystem/common/securities/security_transaction_manager.h"
 namespace quantsystem {
@@ -44,11 +49,20 @@ using orders::OrderEvent;
 using packets::Packet;
 using packets::AlgorithmNodePacket;
 using packets::BacktestNodePacket;
+using packets::BacktestResultPacket;
 using securities::Holding;
 namespace engine {
 namespace results {
 /**
  * Backtesting result handler passes messages back from the System to the User.
+ *
+ * The algorithm and transaction threads only copy their messages, order
+ * events and chart samples into a bounded ResultQueue. The result thread
+ * drains the queue in batches every "result-flush-ms" milliseconds, or
+ * earlier when the queue fills, and applies the samples to the charts.
+ * When "result-file" is set the samples, order events, final orders and
+ * statistics are streamed to that binary result file, which is converted
+ * to JSON in "result-json-file" at the end of the run when that is set.
  * @ingroup EngineLayerResults
  */
 class BacktestingResultHandler : public IResultHandler {
@@ -58,7 +72,12 @@ class BacktestingResultHandler : public IResultHandler {
    * Setup the default sampling and notification periods based
    * on the backtest length.
    */
-  explicit BacktestingResultHandler(const BacktestNodePacket* job_);
+  explicit BacktestingResultHandler(const BacktestNodePacket* job);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~BacktestingResultHandler();
 
     /**
    * Primary result thread entry point to process the result message queue
@@ -145,6 +164,7 @@ class BacktestingResultHandler : public IResultHandler {
   virtual void SamplePerformance(const DateTime& time, double value) {
     Sample("Strategy Equity", ChartType::kOverlay, "Daily Performance",
            SeriesType::kLine, time, value);
+    statistics_.AddPerformance(time, value / 100);
   }
 
   /**
@@ -234,9 +254,18 @@ class BacktestingResultHandler : public IResultHandler {
     algorithm_ = algorithm;
   }
 
+  /**
+   * Final result packet with the charts sampled over the backtest period,
+   * NULL until the result thread ends after SendFinalResult().
+   */
+  const BacktestResultPacket* final_packet() const {
+    return final_packet_.get();
+  }
+
  private:
-  bool exit_triggered_;
-  BacktestNodePacket* job_;
+  static const int kMaxBatchSize = 1024;
+  std::atomic<bool> exit_triggered_;
+  const BacktestNodePacket* job_;
   int job_days_;
   string compile_id_;
   string backtest_id_;
@@ -259,6 +288,56 @@ class BacktestingResultHandler : public IResultHandler {
   string debug_message_period_;
   // Processing Time
   DateTime start_time_;
+  // Records of the producing threads, drained by the result thread
+  scoped_ptr<ResultQueue> queue_;
+  // Drained records, reused from batch to batch
+  vector<ResultRecord> batch_;
+  // Binary result file, only written by the result thread
+  ResultFileWriter result_file_;
+  string result_path_;
+  string json_path_;
+  int64 flush_period_ms_;
+  int max_log_lines_;
+  // Final orders and statistics, written by the result thread once it exits
+  vector<Order> final_orders_;
+  map<DateTime, double> final_profit_loss_;
+  map<string, string> final_statistics_;
+  scoped_ptr<BacktestResultPacket> final_packet_;
+
+  /**
+   * Time of the algorithm in epoch seconds; the wall clock until the
+   * algorithm is set.
+   */
+  int64 AlgorithmTime() const;
+
+  /**
+   * Queue a message record.
+   */
+  void PushMessage(ResultRecordType::Enum type, const string& text,
+                   const string& detail = "");
+
+  /**
+   * Drain and process one batch of records.
+   * @return Number of records processed
+   */
+  int Flush();
+
+  /**
+   * Apply one record to the charts, the log and the result file on the
+   * result thread.
+   */
+  void Process(const ResultRecord& record);
+
+  /**
+   * Write the final orders and statistics and close the result file.
+   */
+  void CloseResultFile();
+
+  /**
+   * Compose the final result packet: the charts are resampled on the
+   * sampling period over the backtest period.
+   */
+  void BuildFinalPacket();
 
   /**
    * Process log messages to ensure the meet the user caps and
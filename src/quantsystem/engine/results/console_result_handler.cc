@@ -19,21 +19,16 @@
 
 #include <utility>
 using std::make_pair;
-#include <thread>
-#include <chrono>
-#include "quantsystem/common/packets/log_packet.h"
-#include "quantsystem/common/packets/debug_packet.h"
-#include "quantsystem/common/util/stl_util.h"
+#include <ctime>
 #include "quantsystem/engine/results/console_result_handler.h"
 
 namespace quantsystem {
-using packets::LogPacket;
-using packets::DebugPacket;
 namespace engine {
 namespace results {
 ConsoleResultHandler::ConsoleResultHandler(
     AlgorithmNodePacket* packet)
-    : exit_triggered_(false) {
+    : exit_triggered_(false),
+      queue_(ResultQueue::CreateFromConfig()) {
   LOG(INFO) << "Launching Console Result Handler";
   is_active_ = true;
   if (dynamic_cast<BacktestNodePacket*>(packet)) {
@@ -51,38 +46,38 @@ ConsoleResultHandler::ConsoleResultHandler(
   notification_period_ = TimeSpan::FromSeconds(5);
   update_time_ = DateTime();
   last_sampleed_timed_ = DateTime(1990, 01, 01);
+  // Handles of the series sampled at every resample period
+  equity_series_ = RegisterSeries("Strategy Equity", ChartType::kStacked,
+                                  "Equity", SeriesType::kCandle);
+  performance_series_ = RegisterSeries("Strategy Equity", ChartType::kStacked,
+                                       "Daily Performance",
+                                       SeriesType::kLine);
   LOG(INFO) << "Launching Console Result Handler finish";
 }
 
 void ConsoleResultHandler::Run() {
   LOG(INFO) << "ConsoleResultHandler: Starting Thread.";
-  while (!exit_triggered_ || messages().size() > 0) {
-    while (messages().size() > 0) {
-      Packet* packet = messages().front();
-      messages().pop();
-      if (!packet) {
-        continue;
-      }
-      switch (packet->type) {
-        case packets::kLog:
-          {
-            LogPacket* log = dynamic_cast<LogPacket*>(packet);
-            if (log) {
-              LOG(INFO) << "Log Message:" << log->message;
-            }
-            break;
-          }
-        case packets::kDebug:
-          {
-            DebugPacket* debug = dynamic_cast<DebugPacket*>(packet);
-            if (debug) {
-              LOG(INFO) << "Debug Message:" << debug->message;
-            }
-            break;
-          }
+  while (!exit_triggered_.load() || !queue_->empty()) {
+    int count = queue_->Drain(kMaxBatchSize, &batch_);
+    for (int i = 0; i < count; ++i) {
+      const ResultRecord& record = batch_[i];
+      switch (record.type) {
+        case ResultRecordType::kLog:
+          LOG(INFO) << "Log Message:" << record.text;
+          break;
+        case ResultRecordType::kDebug:
+          LOG(INFO) << "Debug Message:" << record.text;
+          break;
+        default:
+          LOG(ERROR) << "Error Message:" << record.text << " " <<
+              record.detail;
+          break;
       }
     }
-    std::this_thread::sleep_for(std::chrono::seconds(100));
+    if (count < kMaxBatchSize && !exit_triggered_.load()) {
+      queue_->WaitForFlush(static_cast<int64>(
+          notification_period_.TotalSeconds() * 1000));
+    }
     DateTime now = DateTime();
     if (now > update_time_) {
       update_time_ = now + TimeSpan::FromSeconds(5);
@@ -99,35 +94,17 @@ void ConsoleResultHandler::Sample(const string& chart_name,
                                   SeriesType::Enum series_type,
                                   const DateTime& time,
                                   double value) {
-  if (charts_.find(chart_name) == charts_.end()) {
-    charts_.insert(make_pair(chart_name,
-                                            new Chart(chart_name, chart_type)));
-  }
-  Chart::SeriesMap& series_map = charts_[chart_name]->series_map;
-  if (series_map.find(series_name) == series_map.end()) {
-    series_map.insert(make_pair(
-        series_name, Series(series_name, series_type)));
-  }
-  series_map[series_name].values.push_back(ChartPoint(time, value));
+  RegisterSeries(chart_name, chart_type, series_name,
+                 series_type)->AddPoint(time, value);
 }
 
 void ConsoleResultHandler::SampleRange(const vector<Chart>& samples) {
   for (vector<Chart>::const_iterator it = samples.begin();
        it != samples.end(); ++it) {
-    if (charts_.find(it->name) == charts_.end()) {
-      charts_.insert(make_pair(
-          it->name, new Chart(it->name, it->chart_type)));
-    }
     for (Chart::SeriesMap::const_iterator it_s = it->series_map.begin();
          it_s != it->series_map.end(); ++it_s) {
-      Chart::SeriesMap& series_map = charts_[it->name]->series_map;
-      if (series_map.find(it_s->second.name) == series_map.end()) {
-        series_map.insert(make_pair(
-            it_s->second.name, Series(it_s->second.name,
-                                      it_s->second.series_type)));
-      }
-      vector<ChartPoint>& values = charts_[it->name]->series_map[it_s->second.name].values;
-      values.insert(values.end(), it_s->second.values.begin(), it_s->second.values.end());
+      RegisterSeries(it->name, it->chart_type, it_s->second.name,
+                     it_s->second.series_type)->Append(it_s->second);
     }
   }
 }
@@ -145,8 +122,22 @@ void ConsoleResultHandler::SendFinalResult(
   }
 }
 
-void ConsoleResultHandler::UnsafePurgeQueue() {
-  STLDeleteMapElements(&messages_);
+void ConsoleResultHandler::PushMessage(ResultRecordType::Enum type,
+                                       const string& text,
+                                       const string& detail) {
+  ResultRecord record;
+  record.type = type;
+  record.time = std::time(NULL);
+  record.text = text;
+  record.detail = detail;
+  queue_->Push(record);
+}
+
+void ConsoleResultHandler::PurgeQueue() {
+  VLOG(1) << "PurgeQueue";
+  vector<ResultRecord> purged;
+  while (queue_->Drain(kMaxBatchSize, &purged) > 0) {
+  }
 }
 }  // namespace results
 }  // namespace engine
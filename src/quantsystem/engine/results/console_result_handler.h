@@ -21,6 +21,7 @@
 #define QUANTSYSTEM_ENGINE_RESULTS_CONSOLE_RESULT_HANDLER_H_
 
 #include <glog/logging.h>
+#include <atomic>
 #include <vector>
 using std::vector;
 #include <string>
@@ -36,12 +37,10 @@ using std::map;
 #include "quantsystem/common/orders/order_event.h"
 #include "quantsystem/interfaces/ialgorithm.h"
 #include "quantsystem/engine/results/iresult_handler.h"
+#include "quantsystem/engine/results/result_queue.h"
 #include "quantsystem/common/packets/backtest_node_packet.h"
 #include "quantsystem/common/packets/algorithm_node_packet.h"
 #include "quantsystem/common/packets/live_node_packet.h"
-#include "quantsystem/common/packets/debug_packet.h"
-#include "quantsystem/common/packets/runtime_error_packet.h"
-#include "quantsystem/common/packets/log_packet.h"
 namespace quantsystem {
 using interfaces::IAlgorithm;
 using orders::Order;
@@ -50,9 +49,6 @@ using packets::Packet;
 using packets::AlgorithmNodePacket;
 using packets::BacktestNodePacket;
 using packets::LiveNodePacket;
-using packets::DebugPacket;
-using packets::RuntimeErrorPacket;
-using packets::LogPacket;
 using securities::Holding;
 namespace engine {
 namespace results {
@@ -167,7 +163,7 @@ class ConsoleResultHandler : public IResultHandler {
    * @param message String debug message
    */
   virtual void DebugMessage(const string& message) {
-    messages_.push(new DebugPacket(message, "", "", 0));
+    PushMessage(ResultRecordType::kDebug, message);
   }
 
   /**
@@ -183,7 +179,7 @@ class ConsoleResultHandler : public IResultHandler {
    * @param message Message we'd in the log
    */
   virtual void LogMessage(const string& message) {
-    messages_.push(new LogPacket("", message));
+    PushMessage(ResultRecordType::kLog, message);
   }
 
   /**
@@ -194,7 +190,7 @@ class ConsoleResultHandler : public IResultHandler {
    */
   virtual void ErrorMessage(const string& error,
                             const string& stacktrace = "") {
-    messages_.push(new RuntimeErrorPacket("", error, stacktrace));
+    PushMessage(ResultRecordType::kError, error, stacktrace);
   }
 
   /**
@@ -204,7 +200,7 @@ class ConsoleResultHandler : public IResultHandler {
    */
   virtual void RuntimeError(const string& message,
                             const string& stacktrace = "") {
-    messages_.push(new RuntimeErrorPacket("", message, stacktrace));
+    PushMessage(ResultRecordType::kRuntimeError, message, stacktrace);
   }
 
   /**
@@ -232,8 +228,7 @@ class ConsoleResultHandler : public IResultHandler {
    * @param value Equity value at this moment in time
    */
   virtual void SampleEquity(const DateTime& time, double value) {
-    Sample("Strategy Equity", ChartType::kStacked, "Equity",
-           SeriesType::kCandle, time, value);
+    equity_series_->AddPoint(time, value);
     last_sampleed_timed_ = time;
   }
 
@@ -243,8 +238,8 @@ class ConsoleResultHandler : public IResultHandler {
    * @param value Current daily performance value
    */
   virtual void SamplePerformance(const DateTime& time, double value) {
-    Sample("Strategy Equity", ChartType::kOverlay, "Daily Performance",
-           SeriesType::kLine, time, value);
+    performance_series_->AddPoint(time, value);
+    statistics_.AddPerformance(time, value / 100);
   }
 
   /**
@@ -333,16 +328,14 @@ class ConsoleResultHandler : public IResultHandler {
    * Terminate the result thread and apply any required exit proceedures.
    */
   virtual void Exit() {
-    exit_triggered_ = true;
+    exit_triggered_.store(true);
+    queue_->RequestFlush();
   }
 
   /**
    * Purge/clear any outstanding messages in message queue.
    */
-  virtual void PurgeQueue() {
-     VLOG(1) << "PurgeQueue";
-     UnsafePurgeQueue();
-  }
+  virtual void PurgeQueue();
 
   /**
    * Local object access to the algorithm for the underlying Debug
@@ -354,14 +347,25 @@ class ConsoleResultHandler : public IResultHandler {
   }
 
  private:
-  bool exit_triggered_;
+  static const int kMaxBatchSize = 1024;
+  std::atomic<bool> exit_triggered_;
   scoped_ptr<IConsoleStatusHandler> algorithm_node_;
   DateTime update_time_;
   DateTime last_sampleed_timed_;
   IAlgorithm* algorithm_;
   int job_days_;
+  // Series handles of the equity chart, owned by charts_
+  Series* equity_series_;
+  Series* performance_series_;
+  // Messages of the producing threads, drained by the result thread
+  scoped_ptr<ResultQueue> queue_;
+  vector<ResultRecord> batch_;
 
-  void UnsafePurgeQueue();
+  /**
+   * Queue a message record.
+   */
+  void PushMessage(ResultRecordType::Enum type, const string& text,
+                   const string& detail = "");
 };
 
 }  // namespace results
@@ -44,6 +44,7 @@ using std::queue;
 #include "quantsystem/common/packets/packet.h"
 #include "quantsystem/common/packets/algorithm_node_packet.h"
 #include "quantsystem/common/securities/security_transaction_manager.h"
+#include "quantsystem/common/statistics/statistics_accumulator.h"
 namespace quantsystem {
 using interfaces::IAlgorithm;
 using orders::Order;
@@ -51,6 +52,7 @@ using orders::OrderEvent;
 using packets::Packet;
 using packets::AlgorithmNodePacket;
 using securities::Holding;
+using statistics::StatisticsAccumulator;
 namespace engine {
 namespace results {
 /**
@@ -218,11 +220,39 @@ class IResultHandler {
     messages_ = messages;
   }
 
+  /**
+   * Get the series of a chart, adding the chart and the series if they
+   * do not exist. The series is a handle: sampling through it does not
+   * look up the chart and series names again.
+   * @param chart_name Name of the chart
+   * @param chart_type Type of the chart if it is added
+   * @param series_name Name of the series
+   * @param series_type Type of the series if it is added
+   * @return Series owned by the chart
+   */
+  Series* RegisterSeries(const string& chart_name, ChartType::Enum chart_type,
+                         const string& series_name,
+                         SeriesType::Enum series_type) {
+    ChartsMap::iterator found = charts_.find(chart_name);
+    if (found == charts_.end()) {
+      found = charts_.insert(std::make_pair(
+          chart_name, new Chart(chart_name, chart_type))).first;
+    }
+    return found->second->GetSeries(series_name, series_type);
+  }
+
   ChartsMap& charts() { return charts_; }
   void set_charts(const ChartsMap& charts) {
     charts_ = charts;
   }
 
+  /**
+   * Online statistics fed by the equity of every time slice,
+   * SamplePerformance and the closed trades of the portfolio.
+   */
+  StatisticsAccumulator* mutable_statistics() { return &statistics_; }
+  const StatisticsAccumulator& statistics() const { return statistics_; }
+
   TimeSpan resample_period() const { return resample_period_; }
 
   TimeSpan notification_period() const { return notification_period_; }
@@ -235,6 +265,8 @@ class IResultHandler {
   MessQue messages_;
   // Charts collection for storing the master copy of user charting data.
   ChartsMap charts_;
+  // Statistics of the run updated with every equity and performance sample.
+  StatisticsAccumulator statistics_;
   // Sampling period for timespans between resamples of the charting equity.
   TimeSpan resample_period_;
   // How frequently the backtests push messages to the browser.
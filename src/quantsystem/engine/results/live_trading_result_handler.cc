@@ -62,6 +62,7 @@ void LiveTradingResultHandler::SampleEquity(
 
 void LiveTradingResultHandler::SamplePerformance(
     const DateTime& time, double value){
+  statistics_.AddPerformance(time, value / 100);
 }
 
 void LiveTradingResultHandler::SampleAssetPrices(const string& symbol,
@@ -0,0 +1,252 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <string>
+using std::string;
+#include <utility>
+using std::make_pair;
+using std::swap;
+#include "quantsystem/common/strings/case.h"
+#include "quantsystem/configuration/configuration.h"
+#include "quantsystem/engine/results/result_queue.h"
+namespace quantsystem {
+using configuration::Config;
+namespace engine {
+namespace results {
+namespace ResultRecordType {
+const char* ResultRecordTypeToString(Enum type) {
+  static const char* const kNames[kCount] = {
+    "log", "debug", "error", "runtime error", "order event", "sample"
+  };
+  return type >= 0 && type < kCount ? kNames[type] : "unknown";
+}
+}  // namespace ResultRecordType
+
+ResultRecord::ResultRecord()
+    : type(ResultRecordType::kLog),
+      time(0),
+      value(0),
+      quantity(0),
+      id(0),
+      status(0),
+      chart_type(ChartType::kOverlay),
+      series_type(SeriesType::kLine) {
+}
+
+const int ResultQueue::kDefaultCapacity;
+const uint64 ResultQueue::kNoPosition;
+
+ResultQueue::ResultQueue(int capacity, ResultOverflowPolicy::Enum policy)
+    : ring_(capacity),
+      policy_(policy),
+      flush_requested_(false),
+      overflowed_(false),
+      overflow_count_(0),
+      pop_position_(0),
+      next_aggregated_position_(kNoPosition) {
+  high_water_ = ring_.capacity() - ring_.capacity() / 4;
+  for (int i = 0; i < ResultRecordType::kCount; ++i) {
+    busy_records_[i].store(0);
+    overflowed_records_[i] = 0;
+  }
+}
+
+ResultQueue::~ResultQueue() {
+}
+
+ResultQueue* ResultQueue::CreateFromConfig() {
+  string policy = strings::ToLower(
+      Config::Get("result-queue-policy", "aggregate"));
+  ResultOverflowPolicy::Enum overflow_policy =
+      ResultOverflowPolicy::kAggregate;
+  if (policy == "drop") {
+    overflow_policy = ResultOverflowPolicy::kDrop;
+  } else if (policy != "aggregate") {
+    LOG(ERROR) << "Unknown result-queue-policy: " << policy <<
+        ", using aggregate";
+  }
+  return new ResultQueue(Config::GetInt("result-queue-capacity",
+                                        kDefaultCapacity),
+                         overflow_policy);
+}
+
+bool ResultQueue::Push(const ResultRecord& record) {
+  if (!ring_.TryPush(record)) {
+    Overflow(record);
+    RequestFlush();
+    return false;
+  }
+  if (ring_.size() >= high_water_ && !flush_requested_.load()) {
+    RequestFlush();
+  }
+  return true;
+}
+
+void ResultQueue::Overflow(const ResultRecord& record) {
+  // Records pushed from now on take this ring position or a later one
+  AggregatedKey position(ring_.push_position(), overflow_count_.fetch_add(1));
+  if (!overflow_mutex_.TryLock()) {
+    // Another producer or the drain holds the overflow: do not wait
+    busy_records_[record.type].fetch_add(1);
+    overflowed_.store(true);
+    return;
+  }
+  ++overflowed_records_[record.type];
+  if (policy_ == ResultOverflowPolicy::kAggregate) {
+    if (record.type == ResultRecordType::kSample) {
+      Aggregate(SeriesKey(record), record, position, &aggregated_samples_);
+    } else if (record.type == ResultRecordType::kOrderEvent) {
+      Aggregate(record.id, record, position, &aggregated_orders_);
+    }
+  }
+  overflowed_.store(true);
+  overflow_mutex_.Unlock();
+}
+
+uint64 ResultQueue::SeriesKey(const ResultRecord& record) {
+  // 64 bit FNV-1a of the chart name, a separator and the series name
+  const uint64 kPrime = 1099511628211ULL;
+  uint64 hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < record.name.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned char>(record.name[i])) * kPrime;
+  }
+  hash *= kPrime;
+  for (size_t i = 0; i < record.series.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned char>(record.series[i])) * kPrime;
+  }
+  return hash;
+}
+
+template <typename Key>
+void ResultQueue::Aggregate(const Key& key, const ResultRecord& record,
+                            const AggregatedKey& position,
+                            map<Key, AggregatedKey>* positions) {
+  typename map<Key, AggregatedKey>::iterator found = positions->find(key);
+  if (found == positions->end()) {
+    positions->insert(make_pair(key, position));
+  } else {
+    // The newer record supersedes the one set aside before
+    aggregated_.erase(found->second);
+    found->second = position;
+  }
+  aggregated_[position] = record;
+  next_aggregated_position_.store(aggregated_.begin()->first.first);
+}
+
+int ResultQueue::Drain(int max_records, vector<ResultRecord>* batch) {
+  int count = 0;
+  while (count < max_records) {
+    if (pop_position_ >= next_aggregated_position_.load()) {
+      DrainOverflow(false, batch, &count);
+    }
+    if (count == static_cast<int>(batch->size())) {
+      batch->resize(count + 1);
+    }
+    if (!ring_.TryPop(&(*batch)[count])) {
+      break;
+    }
+    ++count;
+    ++pop_position_;
+  }
+  if (overflowed_.exchange(false)) {
+    DrainOverflow(true, batch, &count);
+  }
+  return count;
+}
+
+void ResultQueue::DrainOverflow(bool with_counts, vector<ResultRecord>* batch,
+                                int* count) {
+  MutexLock lock(&overflow_mutex_);
+  // An aggregated record is newer than the ring records before its
+  // position and older than the ones from its position on
+  while (!aggregated_.empty() &&
+         aggregated_.begin()->first.first <= pop_position_) {
+    ResultRecord* record = NextRecord(batch, count);
+    swap(*record, aggregated_.begin()->second);
+    if (record->type == ResultRecordType::kSample) {
+      aggregated_samples_.erase(SeriesKey(*record));
+    } else {
+      aggregated_orders_.erase(record->id);
+    }
+    aggregated_.erase(aggregated_.begin());
+  }
+  next_aggregated_position_.store(aggregated_.empty() ? kNoPosition :
+                                  aggregated_.begin()->first.first);
+  if (!with_counts) {
+    return;
+  }
+  const bool aggregate = policy_ == ResultOverflowPolicy::kAggregate;
+  for (int i = 0; i < ResultRecordType::kCount; ++i) {
+    const ResultRecordType::Enum type = static_cast<ResultRecordType::Enum>(i);
+    // Only samples and order events are kept aside by the aggregation
+    const bool kept = aggregate && (i == ResultRecordType::kSample ||
+                                    i == ResultRecordType::kOrderEvent);
+    int64 dropped = busy_records_[i].exchange(0);
+    if (kept) {
+      AddCountRecord(type, overflowed_records_[i], "aggregated", batch,
+                     count);
+    } else {
+      dropped += overflowed_records_[i];
+    }
+    AddCountRecord(type, dropped, "dropped", batch, count);
+    overflowed_records_[i] = 0;
+  }
+}
+
+void ResultQueue::AddCountRecord(ResultRecordType::Enum type, int64 records,
+                                 const char* what,
+                                 vector<ResultRecord>* batch, int* count) {
+  if (records == 0) {
+    return;
+  }
+  ResultRecord* record = NextRecord(batch, count);
+  *record = ResultRecord();
+  record->type = ResultRecordType::kLog;
+  record->text = "Result queue full: " + std::to_string(records) + " " +
+      ResultRecordType::ResultRecordTypeToString(type) + " records " + what;
+}
+
+ResultRecord* ResultQueue::NextRecord(vector<ResultRecord>* batch,
+                                      int* count) {
+  if (*count == static_cast<int>(batch->size())) {
+    batch->resize(*count + 1);
+  }
+  return &(*batch)[(*count)++];
+}
+
+void ResultQueue::WaitForFlush(int64 milliseconds) {
+  MutexLock lock(&wait_mutex_);
+  if (!flush_requested_.load()) {
+    flush_signal_.WaitWithTimeout(&wait_mutex_, milliseconds);
+  }
+  flush_requested_.store(false);
+}
+
+void ResultQueue::RequestFlush() {
+  if (flush_requested_.exchange(true)) {
+    return;
+  }
+  MutexLock lock(&wait_mutex_);
+  flush_signal_.Signal();
+}
+
+}  // namespace results
+}  // namespace engine
+}  // namespace quantsystem
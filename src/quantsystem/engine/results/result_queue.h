@@ -0,0 +1,247 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_ENGINE_RESULTS_RESULT_QUEUE_H_
+#define QUANTSYSTEM_ENGINE_RESULTS_RESULT_QUEUE_H_
+
+#include <atomic>
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <utility>
+using std::pair;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/global.h"
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/base/mutex.h"
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/util/charting.h"
+#include "quantsystem/common/util/bounded_queue.h"
+namespace quantsystem {
+namespace engine {
+namespace results {
+/**
+ * Kind of a result record.
+ */
+namespace ResultRecordType {
+enum Enum {
+  kLog,  // Algorithm log message
+  kDebug,  // Algorithm debug message
+  kError,  // Algorithm error message
+  kRuntimeError,  // Runtime error which stopped the algorithm
+  kOrderEvent,  // Order status update or fill
+  kSample,  // Chart sample
+  kCount  // Number of record types
+};
+
+/**
+ * Lower case name of the record type.
+ */
+const char* ResultRecordTypeToString(Enum type);
+}  // namespace ResultRecordType
+
+/**
+ * What the result queue does with a record which does not fit.
+ */
+namespace ResultOverflowPolicy {
+enum Enum {
+  // Discard the record, only the number of discarded records is reported
+  kDrop,
+  // Keep the last sample of every series and the last event of every
+  // order aside and deliver them where they were pushed; count the
+  // messages
+  kAggregate
+};
+}  // namespace ResultOverflowPolicy
+
+/**
+ * Flat record written by the algorithm thread for the result thread.
+ * The fields used depend on the type.
+ * @ingroup EngineLayerResults
+ */
+class ResultRecord {
+ public:
+  ResultRecordType::Enum type;
+  int64 time;  // Epoch seconds of the sample or of the order event
+  double value;  // Sample value, fill price of an order event
+  double quantity;  // Fill quantity of an order event
+  int id;  // Order id of an order event
+  int status;  // Order status of an order event
+  ChartType::Enum chart_type;  // Chart type of a sample
+  SeriesType::Enum series_type;  // Series type of a sample
+  string name;  // Chart name of a sample, symbol of an order event
+  string series;  // Series name of a sample
+  string text;  // Message of a log, debug, error or order event
+  string detail;  // Stacktrace of an error
+
+  ResultRecord();
+};
+
+/**
+ * Bounded queue of result records between the threads producing results
+ * (algorithm, transactions) and the result thread.
+ *
+ * Pushing is lock-free: the records are copied into a preallocated ring
+ * whose slots keep their string buffers, so a chatty algorithm neither
+ * allocates per message nor waits for the result thread. When the ring
+ * reaches three quarters of its capacity the result thread is woken to
+ * flush early; only that push takes the wake-up mutex. A record which
+ * does not fit is handled by the overflow policy, so memory stays
+ * bounded by the capacity plus, when aggregating, one record per series
+ * and per order. An aggregated record remembers the ring position at
+ * the time it did not fit and is drained right before the record pushed
+ * at that position, so the records of a series or an order keep their
+ * order. The producer never waits for the overflow either: a series is
+ * keyed by a hash of its names, and a record which finds the overflow
+ * busy with another thread or with a drain is dropped and counted.
+ *
+ * The capacity and the policy are read from the "result-queue-capacity"
+ * and "result-queue-policy" ("drop" or "aggregate") configuration keys.
+ * @ingroup EngineLayerResults
+ */
+class ResultQueue {
+ public:
+  static const int kDefaultCapacity = 8192;
+
+  /**
+   * Create the queue.
+   * @param capacity Number of records held, rounded up to a power of two
+   * @param policy What to do with the records which do not fit
+   */
+  explicit ResultQueue(int capacity = kDefaultCapacity,
+                       ResultOverflowPolicy::Enum policy =
+                       ResultOverflowPolicy::kAggregate);
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~ResultQueue();
+
+  /**
+   * Create a queue with the capacity and the policy of the configuration.
+   * @return New queue owned by the caller
+   */
+  static ResultQueue* CreateFromConfig();
+
+  /**
+   * Add a record. Safe from any thread.
+   * @param record Record to copy into the queue
+   * @return False if the queue was full and the overflow policy applied.
+   */
+  bool Push(const ResultRecord& record);
+
+  /**
+   * Take the queued records with whatever the overflow policy kept aside
+   * merged in push order, followed by one log record per record type
+   * reporting how many records were dropped or aggregated since the last
+   * drain.
+   * Only the result thread drains.
+   * @param max_records Maximum number of records taken from the ring
+   * @param batch[out] Receives the records in its first elements; the
+   * storage of the elements is reused from one drain to the next
+   * @return Number of records written to the batch
+   */
+  int Drain(int max_records, vector<ResultRecord>* batch);
+
+  /**
+   * Wait until the queue asks for a flush or the timeout elapses.
+   * @param milliseconds Maximum time to wait
+   */
+  void WaitForFlush(int64 milliseconds);
+
+  /**
+   * Wake the thread waiting in WaitForFlush.
+   */
+  void RequestFlush();
+
+  int capacity() const { return ring_.capacity(); }
+  int size() const { return ring_.size(); }
+  bool empty() const { return ring_.empty() && !overflowed_.load(); }
+  ResultOverflowPolicy::Enum policy() const { return policy_; }
+
+  /**
+   * Number of records which did not fit in the queue since it was created.
+   */
+  int64 overflow_count() const { return overflow_count_.load(); }
+
+ private:
+  BoundedQueue<ResultRecord> ring_;
+  ResultOverflowPolicy::Enum policy_;
+  int high_water_;
+  std::atomic<bool> flush_requested_;
+  std::atomic<bool> overflowed_;
+  std::atomic<int64> overflow_count_;
+  Mutex wait_mutex_;
+  CondVar flush_signal_;
+  // Ring position of the next record popped, only used by the result
+  // thread
+  uint64 pop_position_;
+  // Ring position of the first aggregated record, kNoPosition if none
+  static const uint64 kNoPosition = ~0ULL;
+  std::atomic<uint64> next_aggregated_position_;
+  // Records dropped because the overflow was busy, by record type
+  std::atomic<int64> busy_records_[ResultRecordType::kCount];
+  // Records which did not fit, by record type
+  Mutex overflow_mutex_;
+  int64 overflowed_records_[ResultRecordType::kCount] GUARDED_BY(
+      overflow_mutex_);
+  // Ring position and overflow number of an aggregated record
+  typedef pair<uint64, int64> AggregatedKey;
+  // Aggregated records in the order they are drained
+  map<AggregatedKey, ResultRecord> aggregated_ GUARDED_BY(overflow_mutex_);
+  // Last sample of each series, keyed by the hash of its names
+  map<uint64, AggregatedKey> aggregated_samples_ GUARDED_BY(overflow_mutex_);
+  // Last event of each order
+  map<int, AggregatedKey> aggregated_orders_ GUARDED_BY(overflow_mutex_);
+
+  void Overflow(const ResultRecord& record);
+  /**
+   * Hash of the chart and series names of a sample, without allocating.
+   */
+  static uint64 SeriesKey(const ResultRecord& record);
+  /**
+   * Replace the aggregated record of a series or an order.
+   */
+  template <typename Key>
+  void Aggregate(const Key& key, const ResultRecord& record,
+                 const AggregatedKey& position,
+                 map<Key, AggregatedKey>* positions);
+  /**
+   * Take the aggregated records set aside before the next ring record,
+   * then, with_counts, one log record per type of overflowed records.
+   */
+  void DrainOverflow(bool with_counts, vector<ResultRecord>* batch,
+                     int* count);
+  static ResultRecord* NextRecord(vector<ResultRecord>* batch, int* count);
+  /**
+   * Add a log record reporting a number of overflowed records, if any.
+   */
+  static void AddCountRecord(ResultRecordType::Enum type, int64 records,
+                             const char* what, vector<ResultRecord>* batch,
+                             int* count);
+
+  DISALLOW_COPY_AND_ASSIGN(ResultQueue);
+};
+
+}  // namespace results
+}  // namespace engine
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_ENGINE_RESULTS_RESULT_QUEUE_H_
@@ -0,0 +1,100 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include "quantsystem/common/securities/security_transaction_manager.h"
+#include "quantsystem/engine/results/backtesting_result_handler.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace engine {
+namespace results {
+namespace {
+const time_t kStart = 1420070400;  // 2015-01-01 00:00:00 UTC
+const time_t kDay = 24 * 3600;
+// 4000 samples over the 30 days of the backtest
+const time_t kPeriod = 30 * kDay / 4000;
+}  // namespace
+
+class BacktestingResultHandlerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    job_.period_start = DateTime(kStart);
+    job_.period_finish = DateTime(kStart + 30 * kDay);
+    handler_.reset(new BacktestingResultHandler(&job_));
+  }
+
+  void SampleEquity(time_t time, double value) {
+    handler_->Sample("Strategy Equity", ChartType::kStacked, "Equity",
+                     SeriesType::kLine, DateTime(time), value);
+  }
+
+  BacktestNodePacket job_;
+  scoped_ptr<BacktestingResultHandler> handler_;
+};
+
+TEST_F(BacktestingResultHandlerTest, TestFinalChartsAreSampled) {
+  SampleEquity(kStart - kDay, 90000);
+  SampleEquity(kStart, 100000);
+  SampleEquity(kStart + 30 * kDay, 103000);
+  Order order("SPY", 10, orders::kMarket, DateTime(kStart), 200);
+  order.id = 1;
+  securities::OrderMap orders;
+  orders[order.id] = &order;
+  map<string, string> statistics;
+  statistics["Total Trades"] = "1";
+  handler_->SendFinalResult(&job_, orders, map<DateTime, double>(),
+                            map<string, Holding>(), statistics,
+                            map<string, string>());
+  handler_->Exit();
+  handler_->Run();
+
+  const BacktestResultPacket* packet = handler_->final_packet();
+  ASSERT_TRUE(packet != NULL);
+  ASSERT_EQ(1, packet->results.charts.count("Strategy Equity"));
+  const Chart& chart = packet->results.charts.find("Strategy Equity")->second;
+  ASSERT_EQ(1, chart.series_map.count("Equity"));
+  const Series& series = chart.series_map.find("Equity")->second;
+  // The point before the backtest is dropped, the rest is on the grid
+  ASSERT_EQ(4001, series.size());
+  EXPECT_EQ(kStart, series.time(0));
+  EXPECT_EQ(100000, series.value(0));
+  EXPECT_EQ(kStart + kPeriod, series.time(1));
+  EXPECT_NEAR(100000 + 3000.0 / 4000, series.value(1), 1e-9);
+  EXPECT_EQ(kStart + 30 * kDay, series.time(4000));
+  EXPECT_EQ(103000, series.value(4000));
+  ASSERT_EQ(1, packet->results.orders.count(1));
+  EXPECT_EQ("SPY", packet->results.orders.find(1)->second.symbol);
+  EXPECT_EQ("1", packet->results.statistics.find("Total Trades")->second);
+}
+
+TEST_F(BacktestingResultHandlerTest, TestNoFinalPacketWithoutFinalResult) {
+  SampleEquity(kStart, 100000);
+  handler_->Exit();
+  handler_->Run();
+  EXPECT_TRUE(handler_->final_packet() == NULL);
+  EXPECT_EQ(1, handler_->charts().count("Strategy Equity"));
+}
+}  // namespace results
+}  // namespace engine
+}  // namespace quantsystem
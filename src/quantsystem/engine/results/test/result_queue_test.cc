@@ -0,0 +1,149 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+using std::vector;
+#include "quantsystem/engine/results/result_queue.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace engine {
+namespace results {
+namespace {
+ResultRecord OrderEventRecord(int id, int status) {
+  ResultRecord record;
+  record.type = ResultRecordType::kOrderEvent;
+  record.time = status;
+  record.id = id;
+  record.status = status;
+  return record;
+}
+
+ResultRecord SampleRecord(const string& series, int64 time) {
+  ResultRecord record;
+  record.type = ResultRecordType::kSample;
+  record.time = time;
+  record.value = time;
+  record.name = "Strategy Equity";
+  record.series = series;
+  return record;
+}
+}  // namespace
+
+TEST(ResultQueue, TestAggregatedOrderEventKeepsItsPlace) {
+  ResultQueue queue(4, ResultOverflowPolicy::kAggregate);
+  for (int status = 1; status <= 4; ++status) {
+    EXPECT_TRUE(queue.Push(OrderEventRecord(1, status)));
+  }
+  EXPECT_FALSE(queue.Push(OrderEventRecord(1, 5)));
+  vector<ResultRecord> batch;
+  ASSERT_EQ(3, queue.Drain(2, &batch));
+  EXPECT_EQ(1, batch[0].status);
+  EXPECT_EQ(2, batch[1].status);
+  EXPECT_EQ(ResultRecordType::kLog, batch[2].type);
+  EXPECT_EQ("Result queue full: 1 order event records aggregated",
+            batch[2].text);
+  // Pushed after the overflowed event: drained after it
+  EXPECT_TRUE(queue.Push(OrderEventRecord(1, 6)));
+  ASSERT_EQ(4, queue.Drain(10, &batch));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(ResultRecordType::kOrderEvent, batch[i].type);
+    EXPECT_EQ(3 + i, batch[i].status);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ResultQueue, TestAggregatedSamplesStayInTimeOrder) {
+  ResultQueue queue(4, ResultOverflowPolicy::kAggregate);
+  int64 time = 0;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.Push(SampleRecord("Equity", ++time)));
+  }
+  // Only the last sample of each series is kept
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FALSE(queue.Push(SampleRecord("Equity", ++time)));
+  }
+  EXPECT_FALSE(queue.Push(SampleRecord("Benchmark", ++time)));
+  vector<ResultRecord> batch;
+  ASSERT_EQ(2, queue.Drain(1, &batch));
+  EXPECT_EQ(1, batch[0].time);
+  EXPECT_EQ("Result queue full: 4 sample records aggregated", batch[1].text);
+  EXPECT_TRUE(queue.Push(SampleRecord("Equity", ++time)));
+  ASSERT_EQ(6, queue.Drain(10, &batch));
+  const int64 times[] = {2, 3, 4, 7, 8, 9};
+  const char* series[] = {
+    "Equity", "Equity", "Equity", "Equity", "Benchmark", "Equity"
+  };
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(times[i], batch[i].time);
+    EXPECT_EQ(series[i], batch[i].series);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ResultQueue, TestConcurrentOverflowCountsEveryRecord) {
+  ResultQueue queue(16, ResultOverflowPolicy::kDrop);
+  const int kProducers = 4;
+  const int kRecords = 5000;
+  std::atomic<int> running(kProducers);
+  vector<std::thread> producers;
+  for (int i = 0; i < kProducers; ++i) {
+    producers.push_back(std::thread([&queue, &running, kRecords]() {
+      ResultRecord record;
+      record.type = ResultRecordType::kDebug;
+      for (int j = 0; j < kRecords; ++j) {
+        queue.Push(record);
+      }
+      running.fetch_sub(1);
+    }));
+  }
+  // Whatever does not fit is either delivered or reported as dropped
+  int64 delivered = 0;
+  int64 dropped = 0;
+  vector<ResultRecord> batch;
+  for (;;) {
+    const bool finished = running.load() == 0;
+    int count = queue.Drain(64, &batch);
+    for (int i = 0; i < count; ++i) {
+      long long records = 0;
+      if (batch[i].type == ResultRecordType::kDebug) {
+        ++delivered;
+      } else if (std::sscanf(batch[i].text.c_str(),
+                             "Result queue full: %lld", &records) == 1) {
+        dropped += records;
+      }
+    }
+    if (finished && count == 0) {
+      break;
+    }
+  }
+  for (int i = 0; i < kProducers; ++i) {
+    producers[i].join();
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(kProducers * kRecords, delivered + dropped);
+  EXPECT_EQ(dropped, queue.overflow_count());
+}
+}  // namespace results
+}  // namespace engine
+}  // namespace quantsystem
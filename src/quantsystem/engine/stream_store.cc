@@ -17,22 +17,75 @@
  * @}
  */
 
+#include <glog/logging.h>
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/data/consolidators/tick_consolidator.h"
 #include "quantsystem/engine/stream_store.h"
 namespace quantsystem {
+using data::market::TradeBar;
+using data::consolidators::TickConsolidator;
 namespace engine {
-StreamStore::StreamStore(const SubscriptionDataConfig* config) {
+StreamStore::StreamStore(const SubscriptionDataConfig* config)
+    : type_(config->type_name),
+      config_(config),
+      increment_(config->increment) {
 }
 
 void StreamStore::Update(const BaseData* data) {
+  if (data->symbol() != config_->symbol) {
+    return;
+  }
+  data_.reset(data->Clone());
 }
 
 void StreamStore::Update(const Tick* tick) {
+  if (tick->symbol() != config_->symbol) {
+    return;
+  }
+  if (data_ == NULL) {
+    TradeBar* bar = new TradeBar();
+    TickConsolidator::StartBar(*tick, bar);
+    bar->set_time(ComputeBarStartTime(tick));
+    data_.reset(bar);
+    return;
+  }
+  // The bar of the period is aggregated in place
+  TradeBar* bar = dynamic_cast<TradeBar*>(data_.get());
+  if (bar == NULL) {
+    LOG(ERROR) << "Stream of " << config_->symbol << " is not a TradeBar";
+    return;
+  }
+  TickConsolidator::AggregateTick(*tick, bar);
 }
 
 void StreamStore::TriggerArchive(bool fill_forward, bool is_qs_data) {
+  if (data_ == NULL && fill_forward && previous_data_ != NULL) {
+    // No data in this period: repeat the previous close
+    data_.reset(previous_data_->Clone());
+    data_->set_time(previous_data_->time() + increment_);
+    TradeBar* bar = dynamic_cast<TradeBar*>(data_.get());
+    if (bar != NULL) {
+      bar->set_open(bar->close());
+      bar->set_high(bar->close());
+      bar->set_low(bar->close());
+      bar->set_volume(0);
+    }
+  }
+  if (data_ == NULL) {
+    return;
+  }
+  previous_data_.reset(data_->Clone());
+  queue_.push_back(data_.release());
 }
 
 DateTime StreamStore::ComputeBarStartTime(const BaseData* data) {
+  const int64 span = increment_.TotalMicroseconds();
+  if (span <= 0) {
+    return data->time();
+  }
+  const int64 time = data->time().ToEpochMicroseconds();
+  return DateTime::FromEpochMicroseconds(time - time % span);
 }
 
 }  // namespace engine
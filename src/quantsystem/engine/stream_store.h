@@ -102,7 +102,7 @@ class StreamStore {
   scoped_ptr<BaseData> data_;
   scoped_ptr<BaseData> previous_data_;
   string type_;
-  SubscriptionDataConfig* config_;
+  const SubscriptionDataConfig* config_;
   TimeSpan increment_;
   DataQueue queue_;
 
@@ -24,8 +24,6 @@ using std::vector;
 #include "quantsystem/common/data/market/tick.h"
 #include "quantsystem/common/data/market/tradebar.h"
 #include "quantsystem/common/data/custom/quandl.h"
-#include "quantsystem/common/strings/case.h"
-#include "quantsystem/common/strings/strcat.h"
 #include "quantsystem/common/util/file.h"
 #include "quantsystem/common/util/curl_processor.h"
 #include "quantsystem/compression/compression.h"
@@ -219,19 +217,10 @@ string SubscriptionDataReader::GetSource(const DateTime& date) {
 
 string SubscriptionDataReader::GetQuantSystemSource(const DateTime& date) {
   string source = "";
-  TickType data_type = kTrade;
   switch (feed_endpoint_) {
     case DataFeedEndpoint::kBacktesting:
     case DataFeedEndpoint::kFileSystem:
-      source = StrCat("./data/",
-                      strings::ToLower(SecurityType::SecurityTypeToString(
-          config_->security)));
-      source += StrCat("/", strings::ToLower(
-          Resolution::ResolutionToString(config_->resolution)),
-                       "/", strings::ToLower(config_->symbol));
-      source += StrCat("/", date.ToShortString(),
-                       "_", strings::ToLower(TickTypeToString(data_type)),
-                       ".zip");
+      source = config_->GetLocalSource(date);
       break;
     case DataFeedEndpoint::kLiveTrading:
       source = "";
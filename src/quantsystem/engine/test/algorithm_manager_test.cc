@@ -0,0 +1,68 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include "quantsystem/engine/algorithm_manager.h"
+#include "quantsystem/engine/results/live_trading_result_handler.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace engine {
+namespace {
+using results::LiveTradingResultHandler;
+const time_t kStart = 1420070400;  // 2015-01-01 00:00:00 UTC
+const time_t kDay = 24 * 3600;
+}  // namespace
+
+TEST(AlgorithmManager, TestLiveDailyPerformanceFeedsStatistics) {
+  LiveTradingResultHandler results(NULL);
+  results.mutable_statistics()->Initialize(100000);
+  const double equities[] = {101000, 100000, 102000, 102000};
+  double starting_performance = 100000;
+  for (int i = 0; i < 4; ++i) {
+    AlgorithmManager::SampleDailyPerformance(
+        &results, DateTime(kStart + i * kDay), equities[i],
+        &starting_performance);
+    EXPECT_EQ(equities[i], starting_performance);
+  }
+  EXPECT_EQ(4, results.statistics().trading_days());
+  // Mean of +1%, -0.99%, +2% and 0% times 252 days
+  double mean = (0.01 - 1000.0 / 101000 + 0.02) / 4;
+  EXPECT_NEAR(mean * 252, results.statistics().AnnualPerformance(), 1e-9);
+  map<string, string> statistics;
+  results.statistics().GetStatistics(&statistics);
+  EXPECT_FALSE(statistics.empty());
+}
+
+TEST(AlgorithmManager, TestDailyPerformanceWithoutCapital) {
+  LiveTradingResultHandler results(NULL);
+  results.mutable_statistics()->Initialize(0);
+  double starting_performance = 0;
+  AlgorithmManager::SampleDailyPerformance(&results, DateTime(kStart), 5000,
+                                           &starting_performance);
+  EXPECT_EQ(1, results.statistics().trading_days());
+  EXPECT_EQ(0, results.statistics().AnnualPerformance());
+  EXPECT_EQ(5000, starting_performance);
+}
+}  // namespace engine
+}  // namespace quantsystem
@@ -0,0 +1,115 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <typeinfo>
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/util/stl_util.h"
+#include "quantsystem/engine/stream_store.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace engine {
+namespace {
+using data::market::TradeBar;
+const time_t kStart = 1420070400;  // 2015-01-01 00:00:00 UTC
+
+Tick MakeTick(const string& symbol, time_t time, double price,
+              int quantity) {
+  Tick tick(DateTime(time), symbol, price, price, price);
+  tick.set_quantity(quantity);
+  return tick;
+}
+}  // namespace
+
+TEST(StreamStore, TestTicksAggregateIntoAlignedBar) {
+  SubscriptionDataConfig config(typeid(TradeBar).name(),
+                                SecurityType::kEquity, "SPY",
+                                Resolution::kMinute);
+  StreamStore store(&config);
+  const double prices[] = {10, 12, 9};
+  const int quantities[] = {100, 50, 10};
+  for (int i = 0; i < 3; ++i) {
+    Tick tick = MakeTick("SPY", kStart + 5 + 20 * i, prices[i],
+                         quantities[i]);
+    store.Update(&tick);
+  }
+  const TradeBar* bar = dynamic_cast<const TradeBar*>(store.data());
+  ASSERT_TRUE(bar != NULL);
+  // The bar starts at the minute of its first tick
+  EXPECT_EQ(kStart, bar->time().ToEpochTime());
+  EXPECT_EQ(10, bar->open());
+  EXPECT_EQ(12, bar->high());
+  EXPECT_EQ(9, bar->low());
+  EXPECT_EQ(9, bar->close());
+  EXPECT_EQ(160, bar->volume());
+
+  // A tick of another symbol is not aggregated
+  Tick other = MakeTick("IBM", kStart + 50, 100, 1000);
+  store.Update(&other);
+  EXPECT_EQ(160, bar->volume());
+  EXPECT_EQ(12, bar->high());
+}
+
+TEST(StreamStore, TestArchiveFillsForwardEmptyPeriods) {
+  SubscriptionDataConfig config(typeid(TradeBar).name(),
+                                SecurityType::kEquity, "SPY",
+                                Resolution::kMinute);
+  StreamStore store(&config);
+  Tick tick = MakeTick("SPY", kStart + 5, 10, 100);
+  store.Update(&tick);
+  tick = MakeTick("SPY", kStart + 30, 11, 20);
+  store.Update(&tick);
+  store.TriggerArchive(true, false);
+  EXPECT_TRUE(store.data() == NULL);
+  ASSERT_EQ(1, store.queue().size());
+
+  // The next period has no tick: its bar repeats the previous close
+  store.TriggerArchive(true, false);
+  StreamStore::DataQueue queue = store.queue();
+  ASSERT_EQ(2, queue.size());
+  const TradeBar* bar = dynamic_cast<const TradeBar*>(queue[1]);
+  ASSERT_TRUE(bar != NULL);
+  EXPECT_EQ(kStart + 60, bar->time().ToEpochTime());
+  EXPECT_EQ(11, bar->open());
+  EXPECT_EQ(11, bar->high());
+  EXPECT_EQ(11, bar->low());
+  EXPECT_EQ(11, bar->close());
+  EXPECT_EQ(0, bar->volume());
+
+  // Without fill forward an empty period queues nothing
+  store.TriggerArchive(false, false);
+  EXPECT_EQ(2, store.queue().size());
+  STLDeleteElements(&queue);
+}
+
+TEST(StreamStore, TestOtherSymbolIsIgnored) {
+  SubscriptionDataConfig config(typeid(TradeBar).name(),
+                                SecurityType::kEquity, "SPY",
+                                Resolution::kMinute);
+  StreamStore store(&config);
+  Tick tick = MakeTick("IBM", kStart + 5, 100, 10);
+  store.Update(&tick);
+  EXPECT_TRUE(store.data() == NULL);
+  store.TriggerArchive(true, false);
+  EXPECT_TRUE(store.queue().empty());
+}
+
+}  // namespace engine
+}  // namespace quantsystem
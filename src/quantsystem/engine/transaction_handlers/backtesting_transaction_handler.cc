@@ -22,10 +22,15 @@
 #include <string>
 using std::to_string;
 #include "quantsystem/common/base/scoped_ptr.h"
+#include "quantsystem/common/securities/forex/forex_transaction_model.h"
+#include "quantsystem/configuration/configuration.h"
 #include "quantsystem/engine/transaction_handlers/\
 backtesting_transaction_handler.h"
 
 namespace quantsystem {
+using configuration::Config;
+using securities::Security;
+using securities::forex::ForexTransactionModel;
 namespace engine {
 namespace transaction_handlers {
 BacktestingTransactionHandler::BacktestingTransactionHandler(
@@ -36,12 +41,22 @@ BacktestingTransactionHandler::BacktestingTransactionHandler(
       result_handler_(result_handler) {
   is_active_ = true;
   ready_ = false;
+  latency_.LoadFromConfig();
+  if (algorithm_ != NULL) {
+    algorithm_->transactions()->set_simulated_latency(latency_.enabled());
+    if (Config::GetBool("forex-queue-simulation", false)) {
+      EnableForexQueueSimulation(
+          Config::GetDouble("forex-queue-depth", 1000000),
+          Config::GetDouble("forex-queue-depth-per-quote", 100000));
+    }
+  }
 }
 
 void BacktestingTransactionHandler::Run() {
   while (!exit_triggered_) {
     // 1. Add order commands from queue to primary order list
-    if (order_queue().size() == 0) {
+    Order* order = NULL;
+    if (!algorithm_->transactions()->PopOrder(&order)) {
       // We've processed all the orders in queue
       ready_ = true;
       algorithm_->set_processing_order(false);
@@ -49,9 +64,6 @@ void BacktestingTransactionHandler::Run() {
     } else {
       ready_ = false;
       // Scan jobs in the new orders queue
-      Order* order;
-      order = order_queue().front();
-      order_queue().pop();
       OrderMap::iterator it;
       if (order) {
         switch (order->status) {
@@ -61,14 +73,20 @@ void BacktestingTransactionHandler::Run() {
               // Tell the algorithm to wait
               algorithm_->set_processing_order(true);
               orders()[order->id] = order;
+              if (latency_.enabled()) {
+                ScheduleOrder(order);
+              }
             }
             break;
           case orders::kCanceled:
 	    it = orders().find(order->id);
+            // An order in flight can still be canceled before its fill
             if (it != orders().end() &&
-                orders()[order->id]->status == orders::kSubmitted) {
+                (orders()[order->id]->status == orders::kSubmitted ||
+                 latency_.InFlight(order->id))) {
               delete it->second;
               orders()[order->id] = order;
+              latency_.Cancel(order->id);
             }
             break;
           case orders::kUpdate:
@@ -86,6 +104,9 @@ void BacktestingTransactionHandler::Run() {
         }
       }
     }
+    if (latency_.HasEvents()) {
+      ProcessLatencyEvents();
+    }
     vector<int> keys;
     GetProcessOrderKeys(keys);
     for (int i = 0; i < keys.size(); ++i) {
@@ -110,7 +131,8 @@ void BacktestingTransactionHandler::Run() {
         algorithm_->Error("Order Errror: id:" + to_string(id) +
                           ":Insufficient buying power to complete order.");
       }
-      if (fill_event->status != orders::kNone) {
+      if (fill_event.get() != NULL &&
+          fill_event->status != orders::kNone) {
         result_handler_->SendOrderEvent(fill_event.get());
         algorithm_->OnOrderEvent(fill_event.get());
       }
@@ -126,12 +148,53 @@ void BacktestingTransactionHandler::GetProcessOrderKeys(
        it != orders().end(); ++it) {
     orders::OrderStatus status = it->second->status;
     if (status != orders::kFilled && status != orders::kCanceled &&
-        status != orders::kInvalid) {
+        status != orders::kInvalid &&
+        !latency_.InFlight(it->first)) {
       keys.push_back(it->first);
     }
   }
 }
-  
+
+void BacktestingTransactionHandler::EnableForexQueueSimulation(
+    double queue_depth, double depth_per_quote) {
+  vector<string> symbols;
+  algorithm_->securities()->Keys(&symbols);
+  for (int i = 0; i < symbols.size(); ++i) {
+    Security* security = algorithm_->securities()->Get(symbols[i]);
+    if (security->type() != SecurityType::kForex) {
+      continue;
+    }
+    ForexTransactionModel* model =
+        dynamic_cast<ForexTransactionModel*>(security->model());
+    if (model != NULL) {
+      model->EnableQueueSimulation(queue_depth, depth_per_quote);
+    }
+  }
+}
+
+void BacktestingTransactionHandler::ScheduleOrder(const Order* order) {
+  latency_.Schedule(algorithm_->time(), order->id,
+                    algorithm_->securities()->Get(order->symbol)->type());
+}
+
+void BacktestingTransactionHandler::ProcessLatencyEvents() {
+  LatencyModel::Event event;
+  while (latency_.NextEvent(algorithm_->time(), &event)) {
+    if (event.stage != LatencyModel::kAcknowledgement) {
+      continue;
+    }
+    OrderMap::iterator it = orders().find(event.order_id);
+    if (it == orders().end()) {
+      continue;
+    }
+    Order* order = it->second;
+    order->status = orders::kSubmitted;
+    OrderEvent submitted(*order);
+    result_handler_->SendOrderEvent(&submitted);
+    algorithm_->OnOrderEvent(&submitted);
+  }
+}
+
 int BacktestingTransactionHandler::NewOrder(Order* order) {
   // if this a new order (with no id), set it
   if (order->id == 0) {
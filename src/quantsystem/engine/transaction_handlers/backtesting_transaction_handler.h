@@ -33,6 +33,7 @@ using std::queue;
 #include "quantsystem/interfaces/ialgorithm.h"
 #include "quantsystem/engine/results/iresult_handler.h"
 #include "quantsystem/engine/transaction_handlers/itransaction_handler.h"
+#include "quantsystem/engine/transaction_handlers/latency_model.h"
 
 namespace quantsystem {
 using interfaces::IAlgorithm;
@@ -47,6 +48,16 @@ namespace transaction_handlers {
 /**
  * Backtesting transaction handler class for modelling the order fills
  * and portfolio impact when in a backtest.
+ *
+ * When the latency model has delays, new orders go through a time
+ * ordered queue of submission, acknowledgement and fillable events
+ * driven by the algorithm time, and are only offered to the fill
+ * models once they are fillable.
+ *
+ * With "forex-queue-simulation" set, the forex limit orders fill from
+ * their simulated position in the quote queue: "forex-queue-depth"
+ * units are assumed ahead of an order joining the touch and each quote
+ * at the order price consumes "forex-queue-depth-per-quote" of them.
  * @ingroup EngineLayerTransactionHandlers
  */
 class BacktestingTransactionHandler : public ITransactionHandler {
@@ -90,6 +101,7 @@ class BacktestingTransactionHandler : public ITransactionHandler {
    */
   virtual void SetAlgorithm(IAlgorithm* algorithm) {
     algorithm_ = algorithm;
+    algorithm_->transactions()->set_simulated_latency(latency_.enabled());
   }
 
   /**
@@ -130,8 +142,30 @@ class BacktestingTransactionHandler : public ITransactionHandler {
   bool exit_triggered_;
   IAlgorithm* algorithm_;
   IResultHandler* result_handler_;
+  LatencyModel latency_;
 
   void GetProcessOrderKeys(vector<int>& keys);
+
+  /**
+   * Fill the limit orders of the forex securities from the queue
+   * position aware simulation of their quote ticks.
+   * @param queue_depth Units assumed ahead of an order joining the touch
+   * @param depth_per_quote Units of the queue consumed by each quote
+   * update at the order price
+   */
+  void EnableForexQueueSimulation(double queue_depth, double depth_per_quote);
+
+  /**
+   * Put a new order in flight: schedule its arrival at the exchange.
+   * @param order New order
+   */
+  void ScheduleOrder(const Order* order);
+
+  /**
+   * Move the orders in flight through the latency stages which are
+   * due at the current algorithm time.
+   */
+  void ProcessLatencyEvents();
 };
 
 }  // namespace transaction_handlers
@@ -0,0 +1,115 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::string;
+#include "quantsystem/common/strings/case.h"
+#include "quantsystem/configuration/configuration.h"
+#include "quantsystem/engine/transaction_handlers/latency_model.h"
+namespace quantsystem {
+using configuration::Config;
+namespace engine {
+namespace transaction_handlers {
+LatencyModel::LatencyModel()
+    : enabled_(false) {
+}
+
+LatencyModel::~LatencyModel() {
+}
+
+void LatencyModel::LoadFromConfig() {
+  const SecurityType::Enum types[] = {
+    SecurityType::kBase, SecurityType::kEquity, SecurityType::kOption,
+    SecurityType::kCommodity, SecurityType::kForex, SecurityType::kFuture
+  };
+  for (int i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+    string prefix = "latency-" +
+        strings::ToLower(SecurityType::SecurityTypeToString(types[i]));
+    Delays delays;
+    delays.submission = TimeSpan::FromMilliseconds(
+        Config::GetInt(prefix + "-submission-ms", 0));
+    delays.acknowledgement = TimeSpan::FromMilliseconds(
+        Config::GetInt(prefix + "-ack-ms", 0));
+    delays.fill = TimeSpan::FromMilliseconds(
+        Config::GetInt(prefix + "-fill-ms", 0));
+    SetDelays(types[i], delays);
+  }
+}
+
+void LatencyModel::SetDelays(SecurityType::Enum type, const Delays& delays) {
+  delays_[type] = delays;
+  enabled_ = false;
+  for (map<SecurityType::Enum, Delays>::const_iterator it = delays_.begin();
+       it != delays_.end(); ++it) {
+    if (!it->second.IsZero()) {
+      enabled_ = true;
+      break;
+    }
+  }
+}
+
+const LatencyModel::Delays& LatencyModel::GetDelays(
+    SecurityType::Enum type) const {
+  map<SecurityType::Enum, Delays>::const_iterator found = delays_.find(type);
+  if (found == delays_.end()) {
+    return no_delays_;
+  }
+  return found->second;
+}
+
+void LatencyModel::Schedule(const DateTime& time, int order_id,
+                            SecurityType::Enum type) {
+  in_flight_.insert(order_id);
+  events_.push(Event(time + GetDelays(type).submission, order_id,
+                     kSubmission, type));
+}
+
+bool LatencyModel::Cancel(int order_id) {
+  return in_flight_.erase(order_id) > 0;
+}
+
+bool LatencyModel::NextEvent(const DateTime& time, Event* event) {
+  while (!events_.empty() && events_.top().time <= time) {
+    *event = events_.top();
+    events_.pop();
+    if (in_flight_.count(event->order_id) == 0) {
+      // Canceled while in flight
+      continue;
+    }
+    const Delays& delays = GetDelays(event->type);
+    switch (event->stage) {
+      case kSubmission:
+        events_.push(Event(event->time + delays.acknowledgement,
+                           event->order_id, kAcknowledgement, event->type));
+        break;
+      case kAcknowledgement:
+        events_.push(Event(event->time + delays.fill, event->order_id,
+                           kFillable, event->type));
+        break;
+      case kFillable:
+        in_flight_.erase(event->order_id);
+        break;
+    }
+    return true;
+  }
+  return false;
+}
+}  // namespace transaction_handlers
+}  // namespace engine
+}  // namespace quantsystem
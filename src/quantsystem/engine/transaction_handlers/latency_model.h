@@ -0,0 +1,187 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_ENGINE_TRANSACTION_LATENCY_MODEL_H_
+#define QUANTSYSTEM_ENGINE_TRANSACTION_LATENCY_MODEL_H_
+
+#include <map>
+using std::map;
+#include <queue>
+using std::priority_queue;
+#include <set>
+using std::set;
+#include "quantsystem/common/global.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/common/time/time_span.h"
+namespace quantsystem {
+namespace engine {
+namespace transaction_handlers {
+/**
+ * Simulated order latency for backtests.
+ *
+ * An order sent by the algorithm reaches the exchange after the
+ * submission delay, is acknowledged (status Submitted) after the
+ * acknowledgement delay and can only be matched against market data
+ * once the fill delay has also passed. The delays are set per security
+ * type from the "latency-<type>-submission-ms", "latency-<type>-ack-ms"
+ * and "latency-<type>-fill-ms" configuration keys, e.g.
+ * "latency-equity-fill-ms". All delays default to 0: no latency.
+ * @ingroup EngineLayerTransactionHandlers
+ */
+class LatencyModel {
+ public:
+  /**
+   * The three delays of one security type.
+   */
+  class Delays {
+   public:
+    TimeSpan submission;  // Algorithm to exchange
+    TimeSpan acknowledgement;  // Exchange receipt to acknowledgement
+    TimeSpan fill;  // Acknowledgement to the first possible match
+    Delays()
+        : submission(0.0),
+          acknowledgement(0.0),
+          fill(0.0) {
+    }
+    bool IsZero() const {
+      return submission.TotalSeconds() == 0 &&
+          acknowledgement.TotalSeconds() == 0 &&
+          fill.TotalSeconds() == 0;
+    }
+  };
+
+  /**
+   * Stage reached by an order in flight.
+   */
+  enum Stage {
+    kSubmission,  // The order reaches the exchange
+    kAcknowledgement,  // The exchange acknowledges the order
+    kFillable  // The order can be matched against market data
+  };
+
+  /**
+   * Event of the time ordered latency queue.
+   */
+  class Event {
+   public:
+    DateTime time;  // Simulated time the stage is reached
+    int order_id;  // Order the event belongs to
+    Stage stage;  // Stage reached at this time
+    SecurityType::Enum type;  // Security type of the order
+    Event()
+        : order_id(0),
+          stage(kSubmission),
+          type(SecurityType::kBase) {
+    }
+    Event(const DateTime& in_time, int in_order_id, Stage in_stage,
+          SecurityType::Enum in_type)
+        : time(in_time),
+          order_id(in_order_id),
+          stage(in_stage),
+          type(in_type) {
+    }
+    /**
+     * Reversed order so the priority queue keeps the earliest
+     * event on top.
+     */
+    bool operator <(const Event& other) const {
+      return other.time < time;
+    }
+  };
+  typedef priority_queue<Event> EventQueue;
+
+  /**
+   * Standard constructor: no latency for every security type.
+   */
+  LatencyModel();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~LatencyModel();
+
+  /**
+   * Read the delays of every security type from the configuration.
+   */
+  void LoadFromConfig();
+
+  /**
+   * Set the delays of a security type.
+   * @param type Security type
+   * @param delays Submission, acknowledgement and fill delays
+   */
+  void SetDelays(SecurityType::Enum type, const Delays& delays);
+
+  /**
+   * Delays of a security type.
+   */
+  const Delays& GetDelays(SecurityType::Enum type) const;
+
+  /**
+   * True if any security type has a delay.
+   */
+  bool enabled() const { return enabled_; }
+
+  /**
+   * Put a new order in flight: schedule its arrival at the exchange.
+   * @param time Algorithm time the order was sent
+   * @param order_id Id of the new order
+   * @param type Security type of the order
+   */
+  void Schedule(const DateTime& time, int order_id, SecurityType::Enum type);
+
+  /**
+   * Take an order out of flight, e.g. when it is canceled.
+   * @param order_id Id of the order
+   * @return True if the order was in flight
+   */
+  bool Cancel(int order_id);
+
+  /**
+   * True if the order can not be matched against market data yet.
+   */
+  bool InFlight(int order_id) const {
+    return in_flight_.count(order_id) > 0;
+  }
+
+  /**
+   * True if any order is in flight.
+   */
+  bool HasEvents() const { return !events_.empty(); }
+
+  /**
+   * Pop the earliest event due at this time and schedule the next stage
+   * of its order. Events of canceled orders are dropped.
+   * @param time Current algorithm time
+   * @param event[out] Stage reached by an order in flight
+   * @return False when no event is due
+   */
+  bool NextEvent(const DateTime& time, Event* event);
+
+ private:
+  map<SecurityType::Enum, Delays> delays_;
+  Delays no_delays_;
+  bool enabled_;
+  EventQueue events_;
+  set<int> in_flight_;
+};
+}  // namespace transaction_handlers
+}  // namespace engine
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_ENGINE_TRANSACTION_LATENCY_MODEL_H_
@@ -0,0 +1,128 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/common/securities/security.h"
+#include "quantsystem/engine/transaction_handlers/latency_model.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace engine {
+namespace transaction_handlers {
+namespace {
+using data::market::TradeBar;
+using orders::Order;
+using orders::OrderEvent;
+using securities::Security;
+const time_t kStart = 1420194600;  // 2015-01-02 10:30:00 UTC
+
+LatencyModel::Delays MakeDelays(int submission_ms, int ack_ms, int fill_ms) {
+  LatencyModel::Delays delays;
+  delays.submission = TimeSpan::FromMilliseconds(submission_ms);
+  delays.acknowledgement = TimeSpan::FromMilliseconds(ack_ms);
+  delays.fill = TimeSpan::FromMilliseconds(fill_ms);
+  return delays;
+}
+}  // namespace
+
+TEST(LatencyModel, TestEventsOrderedBySubmitAckAndFillTime) {
+  LatencyModel latency;
+  EXPECT_FALSE(latency.enabled());
+  latency.SetDelays(SecurityType::kEquity, MakeDelays(100, 200, 300));
+  latency.SetDelays(SecurityType::kForex, MakeDelays(50, 50, 1000));
+  EXPECT_TRUE(latency.enabled());
+  const DateTime start(kStart);
+  latency.Schedule(start, 1, SecurityType::kEquity);
+  latency.Schedule(start + TimeSpan::FromMilliseconds(10), 2,
+                   SecurityType::kForex);
+  latency.Schedule(start, 3, SecurityType::kEquity);
+  EXPECT_TRUE(latency.Cancel(3));
+  EXPECT_FALSE(latency.Cancel(3));
+
+  // Nothing is due before the first submission
+  LatencyModel::Event event;
+  EXPECT_FALSE(latency.NextEvent(start + TimeSpan::FromMilliseconds(59),
+                                 &event));
+
+  // Forex submitted at 60ms, acknowledged at 110ms, fillable at 1110ms;
+  // equity at 100ms, 300ms and 600ms; the canceled order never shows up
+  const int expected_ids[] = {2, 1, 2, 1, 1, 2};
+  const LatencyModel::Stage expected_stages[] = {
+    LatencyModel::kSubmission, LatencyModel::kSubmission,
+    LatencyModel::kAcknowledgement, LatencyModel::kAcknowledgement,
+    LatencyModel::kFillable, LatencyModel::kFillable
+  };
+  const int expected_ms[] = {60, 100, 110, 300, 600, 1110};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(latency.InFlight(expected_ids[i]));
+    ASSERT_TRUE(latency.NextEvent(start + TimeSpan::FromSeconds(2), &event));
+    EXPECT_EQ(expected_ids[i], event.order_id);
+    EXPECT_EQ(expected_stages[i], event.stage);
+    EXPECT_TRUE(start + TimeSpan::FromMilliseconds(expected_ms[i]) ==
+                event.time);
+  }
+  EXPECT_FALSE(latency.NextEvent(start + TimeSpan::FromSeconds(2), &event));
+  EXPECT_FALSE(latency.HasEvents());
+  EXPECT_FALSE(latency.InFlight(1));
+  EXPECT_FALSE(latency.InFlight(2));
+}
+
+TEST(LatencyModel, TestFillMatchesPostDelayData) {
+  LatencyModel latency;
+  latency.SetDelays(SecurityType::kBase, MakeDelays(1000, 1000, 1000));
+  // Base securities: always open, no fees
+  Security security("SPY", SecurityType::kBase, Resolution::kSecond, true,
+                    1, false);
+  vector<TradeBar*> bars;
+  Order order("SPY", 10, orders::kMarket, DateTime(kStart), 100);
+  order.id = 1;
+  order.status = orders::kSubmitted;
+  latency.Schedule(DateTime(kStart), order.id, SecurityType::kBase);
+
+  // The price moves by 1 every second; the order only becomes fillable
+  // 3 seconds after it was sent
+  double fill_price = 0;
+  for (int second = 0; second < 5 && fill_price == 0; ++second) {
+    DateTime time = DateTime(kStart) + TimeSpan::FromSeconds(second);
+    double price = 100 + second;
+    bars.push_back(new TradeBar(time, "SPY", price, price, price, price,
+                                100));
+    security.Update(time, bars.back());
+    LatencyModel::Event event;
+    while (latency.NextEvent(time, &event)) {
+    }
+    if (latency.InFlight(order.id)) {
+      continue;
+    }
+    OrderEvent* fill = security.model()->Fill(&security, &order);
+    EXPECT_EQ(orders::kFilled, fill->status);
+    fill_price = fill->fill_price;
+    delete fill;
+  }
+  EXPECT_DOUBLE_EQ(103, fill_price);
+  for (int i = 0; i < bars.size(); ++i) {
+    delete bars[i];
+  }
+}
+}  // namespace transaction_handlers
+}  // namespace engine
+}  // namespace quantsystem
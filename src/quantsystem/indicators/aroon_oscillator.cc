@@ -41,43 +41,52 @@ AroonOscillator::AroonOscillator(const string& name,
 
 void AroonOscillator::InitAroonOscillator(const string& name,
                                      int up_period, int down_period) {
-  scoped_ptr<Maximum> max(new Maximum(name + "_Max", up_period));
- // typedef std::function<bool()> ReadyHandler;
- //s typedef std::function<double(IndicatorDataPoint)> ComputeNewHandler;  //NOLINT
-  /*FunctionalIndicator<IndicatorDataPoint>::ComputeNewHandler AroonUpHandler = bind(AroonOscillator::ComputeAroonUp, up_period,
-                                   max.get(), std::placeholders::_1);
-  FunctionalIndicator<IndicatorDataPoint>::ReadyHandler ReadyUpHandler = &max->is_ready;
-  aroon_up_.reset(new FunctionalIndicator<IndicatorDataPoint>(
-      name + "_AroonUp", AroonUpHandler, ReadyUpHandler));
-  scoped_ptr<Minimum> min(new Minimum(name + "_Min", down_period));
-  FunctionalIndicator<IndicatorDataPoint>::ComputeNewHandler AroonDownHandler = bind(AroonOscillator::ComputeAroonDown, down_period,
-                                            min.get(), std::placeholders::_1);
-  FunctionalIndicator<IndicatorDataPoint>::ReadyHandler ReadyDownHandler = &min->is_ready;
-  aroon_down_.reset(new FunctionalIndicator<IndicatorDataPoint>(
-      name + "_AroonDown", AroonDownHandler, ReadyDownHandler)); */
+  // The window spans the current bar and the period before it
+  max_.reset(new Maximum(name + "_Max", up_period + 1));
+  min_.reset(new Minimum(name + "_Min", down_period + 1));
+  Maximum* max = max_.get();
+  Minimum* min = min_.get();
+  aroon_up_.reset(new FunctionalIndicator<IndicatorSample>(
+      name + "_AroonUp",
+      bind(AroonOscillator::ComputeAroonUp, up_period, max,
+           std::placeholders::_1),
+      [max]() { return max->is_ready(); }));
+  aroon_down_.reset(new FunctionalIndicator<IndicatorSample>(
+      name + "_AroonDown",
+      bind(AroonOscillator::ComputeAroonDown, down_period, min,
+           std::placeholders::_1),
+      [min]() { return min->is_ready(); }));
 }
 
 double AroonOscillator::ComputeNextValue(const TradeBar& input) {
-  IndicatorDataPoint data_point_up(input.time(), input.high());
-  aroon_up_->Update(data_point_up);
-  IndicatorDataPoint data_point_down(input.time(), input.low());
-  aroon_down_->Update(data_point_down);
+  const int64 time = ToSampleTime(input.time());
+  aroon_up_->Update(MakeIndicatorSample(time, input.high()));
+  aroon_down_->Update(MakeIndicatorSample(time, input.low()));
   return aroon_up_->value() - aroon_down_->value();
 }
 
+void AroonOscillator::Reset() {
+  max_->Reset();
+  min_->Reset();
+  aroon_up_->Reset();
+  aroon_down_->Reset();
+  TradeBarIndicator::Reset();
+}
+
 double AroonOscillator::ComputeAroonUp(
     int up_period,
     Maximum* max,
-    const IndicatorDataPoint& input) {
+    const IndicatorSample& input) {
   max->Update(input);
-  return 100 * (up_period - max->periods_since_maximum()) / up_period;
+  return 100.0 * (up_period - max->periods_since_maximum()) / up_period;
 }
 
 double AroonOscillator::ComputeAroonDown(
     int down_period, Minimum* min,
-    const IndicatorDataPoint& input) {
+    const IndicatorSample& input) {
   min->Update(input);
-  return 100 * (down_period - min->periods_since_minimum()) / down_period;
+  return 100.0 * (down_period - min->periods_since_minimum()) /
+      down_period;
 }
 
 }  // namespace indicators
@@ -27,7 +27,7 @@ using std::string;
 #include "quantsystem/indicators/minimum.h"
 #include "quantsystem/indicators/indicator_base.h"
 #include "quantsystem/common/data/market/tradebar.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/tradebar_indicator.h"
 namespace quantsystem {
 using data::market::TradeBar;
@@ -43,7 +43,7 @@ namespace indicators {
  */
 class AroonOscillator : public TradeBarIndicator {
  public:
-  typedef IndicatorBase<IndicatorDataPoint> AroonType;
+  typedef IndicatorBase<IndicatorSample> AroonType;
 
   AroonType* aroon_up() const { return aroon_up_.get(); }
 
@@ -52,7 +52,7 @@ class AroonOscillator : public TradeBarIndicator {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return aroon_up_->is_ready() && aroon_down_->is_ready();
   }
 
@@ -75,6 +75,12 @@ class AroonOscillator : public TradeBarIndicator {
    */
   AroonOscillator(const string& name, int up_period, int down_period);
 
+  /**
+   * Resets this indicator and its AroonUp and AroonDown to their
+   * initial state.
+   */
+  virtual void Reset();
+
   /**
    * Computes the next value of this indicator from the given state.
    * @param input The input given to the indicator.
@@ -90,7 +96,7 @@ class AroonOscillator : public TradeBarIndicator {
    * @return The AroonUp value
    */
   static double ComputeAroonUp(int up_period, Maximum* max,
-                               const IndicatorDataPoint& input);
+                               const IndicatorSample& input);
 
   /**
    * AroonDown = 100 * (period - {periods since min})/period.
@@ -100,11 +106,14 @@ class AroonOscillator : public TradeBarIndicator {
    * @return The AroonDown value
    */
   static double ComputeAroonDown(int down_period, Minimum* min,
-                                 const IndicatorDataPoint& input);
+                                 const IndicatorSample& input);
 
  private:
   scoped_ptr<AroonType> aroon_up_;
   scoped_ptr<AroonType> aroon_down_;
+  // Monotonic deque windows behind AroonUp and AroonDown
+  scoped_ptr<Maximum> max_;
+  scoped_ptr<Minimum> min_;
 
   void set_aroon_up(AroonType* aroon_up) { aroon_up_.reset(aroon_up); }
 
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 using std::to_string;
 #include "quantsystem/indicators/average_true_range.h"
@@ -25,14 +27,18 @@ namespace quantsystem {
 namespace indicators {
 AverageTrueRange::AverageTrueRange(const string& name, int period,
                                    MovingAverageType moving_average_type)
-    : TradeBarIndicator(name) {
+    : TradeBarIndicator(name),
+      previous_close_(0),
+      have_previous_input_(false) {
   string tmp_name = name + "_" + MovingAverageTypeToString(moving_average_type);
   smoother_.reset(ToIndicator(moving_average_type, tmp_name, period));
 }
 
 AverageTrueRange::AverageTrueRange(int period,
                                    MovingAverageType moving_average_type)
-    : TradeBarIndicator("ATR" + to_string(period)) {
+    : TradeBarIndicator("ATR" + to_string(period)),
+      previous_close_(0),
+      have_previous_input_(false) {
   string tmp_name = "ATR" + to_string(period) + "_" +
       MovingAverageTypeToString(moving_average_type);
   smoother_.reset(ToIndicator(moving_average_type, tmp_name, period));
@@ -41,9 +47,33 @@ AverageTrueRange::AverageTrueRange(int period,
 double AverageTrueRange::ComputeTrueRange(
     const TradeBar* previous,
     const TradeBar* current) {
+  double range1 = current->high() - current->low();
+  if (previous == NULL) {
+    return range1;
+  }
+  double range2 = std::fabs(current->high() - previous->close());
+  double range3 = std::fabs(current->low() - previous->close());
+  return std::max(range1, std::max(range2, range3));
 }
 
 double AverageTrueRange::ComputeNextValue(const TradeBar& input) {
+  double true_range = input.high() - input.low();
+  if (have_previous_input_) {
+    true_range = std::max(true_range,
+                          std::max(std::fabs(input.high() - previous_close_),
+                                   std::fabs(input.low() - previous_close_)));
+  }
+  previous_close_ = input.close();
+  have_previous_input_ = true;
+  smoother_->Update(ToIndicatorSample(input.time(), true_range));
+  return smoother_->value();
+}
+
+void AverageTrueRange::Reset() {
+  smoother_->Reset();
+  previous_close_ = 0;
+  have_previous_input_ = false;
+  TradeBarIndicator::Reset();
 }
 
 }  // namespace indicators
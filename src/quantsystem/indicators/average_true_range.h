@@ -25,7 +25,7 @@ using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
 #include "quantsystem/common/data/market/tradebar.h"
 #include "quantsystem/indicators/tradebar_indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/moving_average_type.h"
 #include "quantsystem/indicators/indicator_base.h"
 namespace quantsystem {
@@ -83,10 +83,15 @@ class AverageTrueRange : public TradeBarIndicator {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return smoother_->is_ready();
   }
 
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
  protected:
   /**
    * Computes the next value of this indicator from the given state.
@@ -96,12 +101,13 @@ class AverageTrueRange : public TradeBarIndicator {
   virtual double ComputeNextValue(const TradeBar& input);
 
  private:
-  // The input we received last time, this is used in ComputeTrueRange
-  TradeBar previous_input_;
+  // The close of the input we received last time, only the close is
+  // used in the true range so the whole bar is not kept
+  double previous_close_;
   // Indicate having the previous input
   bool have_previous_input_ : 1;
   // This indicator is used to smooth the TrueRange computation
-  scoped_ptr<IndicatorBase<IndicatorDataPoint> > smoother_;
+  scoped_ptr<IndicatorBase<IndicatorSample> > smoother_;
 };
 
 }  // namespace indicators
@@ -0,0 +1,39 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/beta.h"
+namespace quantsystem {
+namespace indicators {
+Beta::Beta(const string& name, int period)
+    : Covariance(name, period) {
+}
+
+Beta::Beta(int period)
+    : Covariance("BETA" + to_string(period), period) {
+}
+
+double Beta::ComputeStatistic() const {
+  const RollingComoments& moments = comoments();
+  return moments.m2_x() > 0 ? moments.c_xy() / moments.m2_x() : 0;
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,62 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_BETA_H_
+#define QUANTSYSTEM_INDICATORS_BETA_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/covariance.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Beta of the second series (y) against the first (x) over a rolling
+ * period: the least squares slope of y on x, cov(x, y) / var(x). Fed
+ * with the returns of a security (y) and of its benchmark (x) it is
+ * the beta of the security. A window where x is constant has a beta
+ * of 0.
+ * @ingroup IndicatorsLayer
+ */
+class Beta : public Covariance {
+ public:
+  /**
+   * Initializes a new instance of the Beta class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the beta
+   */
+  Beta(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the Beta class with
+   * the default name and period.
+   * @param period The period of the beta
+   */
+  explicit Beta(int period);
+
+ protected:
+  /**
+   * Beta from the comoments, 0 when x is constant.
+   */
+  virtual double ComputeStatistic() const;
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_BETA_H_
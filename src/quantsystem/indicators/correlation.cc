@@ -0,0 +1,41 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/correlation.h"
+namespace quantsystem {
+namespace indicators {
+Correlation::Correlation(const string& name, int period)
+    : Covariance(name, period) {
+}
+
+Correlation::Correlation(int period)
+    : Covariance("CORR" + to_string(period), period) {
+}
+
+double Correlation::ComputeStatistic() const {
+  const RollingComoments& moments = comoments();
+  const double deviation = std::sqrt(moments.m2_x() * moments.m2_y());
+  return deviation > 0 ? moments.c_xy() / deviation : 0;
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
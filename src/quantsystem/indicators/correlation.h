@@ -0,0 +1,60 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_CORRELATION_H_
+#define QUANTSYSTEM_INDICATORS_CORRELATION_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/covariance.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Pearson correlation of two series over a rolling period, between -1
+ * and 1. A window where either series is constant has a correlation
+ * of 0.
+ * @ingroup IndicatorsLayer
+ */
+class Correlation : public Covariance {
+ public:
+  /**
+   * Initializes a new instance of the Correlation class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the correlation
+   */
+  Correlation(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the Correlation class with
+   * the default name and period.
+   * @param period The period of the correlation
+   */
+  explicit Correlation(int period);
+
+ protected:
+  /**
+   * Correlation from the comoments, 0 when a series is constant.
+   */
+  virtual double ComputeStatistic() const;
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_CORRELATION_H_
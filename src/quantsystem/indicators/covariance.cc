@@ -0,0 +1,61 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/covariance.h"
+namespace quantsystem {
+namespace indicators {
+Covariance::Covariance(const string& name, int period)
+    : WindowIndicator<IndicatorPairSample>(name, period),
+      comoments_(period) {
+}
+
+Covariance::Covariance(int period)
+    : WindowIndicator<IndicatorPairSample>("COV" + to_string(period),
+                                           period),
+      comoments_(period) {
+}
+
+void Covariance::Reset() {
+  WindowIndicator<IndicatorPairSample>::Reset();
+  comoments_.Reset();
+}
+
+double Covariance::ComputeNextValue(
+    IReadOnlyWindow<IndicatorPairSample>* window,
+    const IndicatorPairSample& input) {
+  if (window->is_ready()) {
+    const IndicatorPairSample removed = window->most_recently_removed();
+    comoments_.Replace(removed.x, removed.y, input.x, input.y);
+    if (comoments_.needs_resum()) {
+      comoments_.Resum(this->window());
+    }
+  } else {
+    comoments_.Add(input.x, input.y);
+  }
+  return ComputeStatistic();
+}
+
+double Covariance::ComputeStatistic() const {
+  return comoments_.c_xy() / comoments_.count();
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
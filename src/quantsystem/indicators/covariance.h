@@ -0,0 +1,88 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_COVARIANCE_H_
+#define QUANTSYSTEM_INDICATORS_COVARIANCE_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/window_indicator.h"
+#include "quantsystem/indicators/iread_only_window.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/rolling_moments.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Population covariance of two series over a rolling period.
+ *
+ * The inputs are paired samples of both series at the same time. The
+ * comoments are maintained by RollingComoments in O(1) per update, and
+ * the statistics derived from them (Correlation, Beta) override
+ * ComputeStatistic.
+ * @ingroup IndicatorsLayer
+ */
+class Covariance : public WindowIndicator<IndicatorPairSample> {
+ public:
+  /**
+   * Initializes a new instance of the Covariance class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the covariance
+   */
+  Covariance(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the Covariance class with
+   * the default name and period.
+   * @param period The period of the covariance
+   */
+  explicit Covariance(int period);
+
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
+ protected:
+  /**
+   * Computes the next value for this indicator from the given state.
+   * @param[out] window The window of data held in this indicator
+   * @param input The input value to this indicator on this time step
+   * @return A new value for this indicator
+   */
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorPairSample>* window,
+                                  const IndicatorPairSample& input);
+
+  /**
+   * Computes the statistic of this indicator from the comoments.
+   */
+  virtual double ComputeStatistic() const;
+
+  /**
+   * Comoments of the samples of the window.
+   */
+  const RollingComoments& comoments() const { return comoments_; }
+
+ private:
+  RollingComoments comoments_;
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_COVARIANCE_H_
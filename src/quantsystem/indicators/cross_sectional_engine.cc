@@ -0,0 +1,327 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+using std::make_pair;
+#include "quantsystem/indicators/cross_sectional_engine.h"
+namespace quantsystem {
+namespace indicators {
+namespace {
+// Orders row ids by the values of a column
+class ValueGreater {
+ public:
+  explicit ValueGreater(const double* values) : values_(values) {}
+  bool operator()(int left, int right) const {
+    return values_[left] > values_[right];
+  }
+
+ private:
+  const double* values_;
+};
+
+class ValueLess {
+ public:
+  explicit ValueLess(const double* values) : values_(values) {}
+  bool operator()(int left, int right) const {
+    return values_[left] < values_[right];
+  }
+
+ private:
+  const double* values_;
+};
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+}  // namespace
+
+CrossSectionalEngine::CrossSectionalEngine()
+    : capacity_(0),
+      updated_(false),
+      slice_count_(0) {
+}
+
+CrossSectionalEngine::~CrossSectionalEngine() {
+}
+
+int CrossSectionalEngine::Register(const string& symbol) {
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  if (found != symbol_ids_.end()) {
+    return found->second;
+  }
+  int id = size();
+  symbol_ids_.insert(make_pair(symbol, id));
+  symbols_.push_back(symbol);
+  samples_.push_back(0);
+  row_slice_.push_back(-1);
+  history_.resize(history_.size() + capacity_, 0);
+  for (int i = 0; i < columns(); ++i) {
+    columns_[i].values.push_back(0);
+    columns_[i].sums.push_back(0);
+  }
+  return id;
+}
+
+int CrossSectionalEngine::GetId(const string& symbol) const {
+  map<string, int>::const_iterator found = symbol_ids_.find(symbol);
+  if (found == symbol_ids_.end()) {
+    return -1;
+  }
+  return found->second;
+}
+
+int CrossSectionalEngine::AddColumn(Kernel kernel, int period) {
+  if (updated_) {
+    LOG(ERROR) << "Columns must be added before the first update";
+    return -1;
+  }
+  if (period <= 0) {
+    LOG(ERROR) << "Invalid column period=" << period;
+    return -1;
+  }
+  Column column;
+  column.kernel = kernel;
+  column.period = period;
+  column.smoothing_factor = 2.0 / (period + 1);
+  column.values.assign(size(), 0);
+  column.sums.assign(size(), 0);
+  columns_.push_back(column);
+  return columns() - 1;
+}
+
+void CrossSectionalEngine::Update(const vector<int>& ids,
+                                  const vector<double>& prices) {
+  DCHECK_EQ(ids.size(), prices.size());
+  if (!updated_) {
+    Allocate();
+  }
+  const int mask = capacity_ - 1;
+  const int count = static_cast<int>(ids.size());
+  const int rows = size();
+  slice_ids_.clear();
+  for (int i = 0; i < count; ++i) {
+    const int id = ids[i];
+    if (id < 0 || id >= rows) {
+      LOG(ERROR) << "Invalid row id=" << id;
+      continue;
+    }
+    if (row_slice_[id] == slice_count_) {
+      // The kernels take one price per row and slice: keep the newest
+      LOG(WARNING) << "Row id=" << id << " repeated in the slice";
+      history_[id * capacity_ + ((samples_[id] - 1) & mask)] = prices[i];
+      continue;
+    }
+    row_slice_[id] = slice_count_;
+    history_[id * capacity_ + (samples_[id] & mask)] = prices[i];
+    ++samples_[id];
+    slice_ids_.push_back(id);
+  }
+  ++slice_count_;
+  UpdateColumns(slice_ids_.data(), static_cast<int>(slice_ids_.size()));
+}
+
+void CrossSectionalEngine::Update(const double* prices) {
+  if (!updated_) {
+    Allocate();
+  }
+  const int mask = capacity_ - 1;
+  const int count = size();
+  for (int id = 0; id < count; ++id) {
+    history_[id * capacity_ + (samples_[id] & mask)] = prices[id];
+    ++samples_[id];
+  }
+  UpdateColumns(NULL, count);
+}
+
+void CrossSectionalEngine::Allocate() {
+  int longest = 0;
+  for (int i = 0; i < columns(); ++i) {
+    longest = std::max(longest, columns_[i].period);
+  }
+  // One more slot than the longest period: the value leaving the window
+  // is still in the ring when the new one is written
+  capacity_ = 1;
+  while (capacity_ <= longest) {
+    capacity_ <<= 1;
+  }
+  history_.assign(static_cast<size_t>(size()) * capacity_, 0);
+  updated_ = true;
+}
+
+void CrossSectionalEngine::UpdateColumns(const int* ids, int count) {
+  const int mask = capacity_ - 1;
+  const double* history = history_.data();
+  const int64* samples = samples_.data();
+  // One loop over the rows per column, ids is NULL for a dense update
+  for (int c = 0; c < columns(); ++c) {
+    Column& column = columns_[c];
+    const int period = column.period;
+    const double k = column.smoothing_factor;
+    double* values = column.values.data();
+    double* sums = column.sums.data();
+    switch (column.kernel) {
+      case kSimpleMovingAverage:
+        for (int i = 0; i < count; ++i) {
+          const int id = ids == NULL ? i : ids[i];
+          const double* ring = history + id * capacity_;
+          const int64 n = samples[id];
+          // Same operations as SimpleMovingAverage
+          sums[id] += ring[(n - 1) & mask];
+          if (n > period) {
+            sums[id] -= ring[(n - 1 - period) & mask];
+          }
+          values[id] = sums[id] / (n < period ? n : period);
+        }
+        break;
+      case kExponentialMovingAverage:
+        for (int i = 0; i < count; ++i) {
+          const int id = ids == NULL ? i : ids[i];
+          const int64 n = samples[id];
+          const double price = history[id * capacity_ + ((n - 1) & mask)];
+          values[id] = n == 1 ? price : price * k + values[id] * (1 - k);
+        }
+        break;
+      case kMomentum:
+        for (int i = 0; i < count; ++i) {
+          const int id = ids == NULL ? i : ids[i];
+          const double* ring = history + id * capacity_;
+          const int64 n = samples[id];
+          // Until the window is full the change is from the first price
+          const int64 back = n > period ? period : n - 1;
+          values[id] = ring[(n - 1) & mask] - ring[(n - 1 - back) & mask];
+        }
+        break;
+      case kMomentumPercent:
+        for (int i = 0; i < count; ++i) {
+          const int id = ids == NULL ? i : ids[i];
+          const double* ring = history + id * capacity_;
+          const int64 n = samples[id];
+          const double price = ring[(n - 1) & mask];
+          sums[id] += price;
+          if (n > period) {
+            sums[id] -= ring[(n - 1 - period) & mask];
+          }
+          const double average = sums[id] / (n < period ? n : period);
+          const int64 back = n > period ? period : n - 1;
+          const double change = price - ring[(n - 1 - back) & mask];
+          values[id] = average == 0 ? 0 : change / average;
+        }
+        break;
+    }
+  }
+}
+
+int CrossSectionalEngine::ReadyCount(int column) const {
+  int ready = 0;
+  const int count = size();
+  for (int id = 0; id < count; ++id) {
+    if (is_ready(column, id)) {
+      ++ready;
+    }
+  }
+  return ready;
+}
+
+void CrossSectionalEngine::GetReadyRows(int column, vector<int>* ids) const {
+  ids->clear();
+  const int count = size();
+  for (int id = 0; id < count; ++id) {
+    if (is_ready(column, id)) {
+      ids->push_back(id);
+    }
+  }
+}
+
+void CrossSectionalEngine::Rank(int column, vector<double>* ranks) const {
+  ranks->assign(size(), kNaN);
+  vector<int> ids;
+  GetReadyRows(column, &ids);
+  const double* values = column_values(column);
+  std::sort(ids.begin(), ids.end(), ValueLess(values));
+  for (int i = 0; i < ids.size(); ++i) {
+    // Ties share the rank of the first row with the value
+    if (i > 0 && values[ids[i]] == values[ids[i - 1]]) {
+      (*ranks)[ids[i]] = (*ranks)[ids[i - 1]];
+    } else {
+      (*ranks)[ids[i]] = i;
+    }
+  }
+}
+
+void CrossSectionalEngine::Percentile(int column,
+                                      vector<double>* percentiles) const {
+  Rank(column, percentiles);
+  const int ready = ReadyCount(column);
+  if (ready < 2) {
+    // A single ready row is the whole distribution
+    for (int id = 0; id < percentiles->size(); ++id) {
+      if (!std::isnan((*percentiles)[id])) {
+        (*percentiles)[id] = 1;
+      }
+    }
+    return;
+  }
+  for (int id = 0; id < percentiles->size(); ++id) {
+    (*percentiles)[id] /= ready - 1;
+  }
+}
+
+void CrossSectionalEngine::ZScore(int column, vector<double>* scores) const {
+  scores->assign(size(), kNaN);
+  vector<int> ids;
+  GetReadyRows(column, &ids);
+  if (ids.empty()) {
+    return;
+  }
+  const double* values = column_values(column);
+  double sum = 0, sum_of_squares = 0;
+  for (int i = 0; i < ids.size(); ++i) {
+    sum += values[ids[i]];
+  }
+  const double mean = sum / ids.size();
+  for (int i = 0; i < ids.size(); ++i) {
+    double deviation = values[ids[i]] - mean;
+    sum_of_squares += deviation * deviation;
+  }
+  const double deviation = std::sqrt(sum_of_squares / ids.size());
+  for (int i = 0; i < ids.size(); ++i) {
+    (*scores)[ids[i]] = deviation == 0 ? 0 :
+        (values[ids[i]] - mean) / deviation;
+  }
+}
+
+void CrossSectionalEngine::TopK(int column, int k, vector<int>* ids) const {
+  GetReadyRows(column, ids);
+  k = std::min(std::max(k, 0), static_cast<int>(ids->size()));
+  ValueGreater greater(column_values(column));
+  std::partial_sort(ids->begin(), ids->begin() + k, ids->end(), greater);
+  ids->resize(k);
+}
+
+void CrossSectionalEngine::BottomK(int column, int k, vector<int>* ids) const {
+  GetReadyRows(column, ids);
+  k = std::min(std::max(k, 0), static_cast<int>(ids->size()));
+  ValueLess less(column_values(column));
+  std::partial_sort(ids->begin(), ids->begin() + k, ids->end(), less);
+  ids->resize(k);
+}
+}  // namespace indicators
+}  // namespace quantsystem
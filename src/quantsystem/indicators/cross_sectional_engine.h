@@ -0,0 +1,242 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_CROSS_SECTIONAL_ENGINE_H_
+#define QUANTSYSTEM_INDICATORS_CROSS_SECTIONAL_ENGINE_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/base/macros.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Indicators of a whole universe of symbols, computed column wise for
+ * cross-sectional queries (rank, z-score, percentile, top-k).
+ *
+ * Each registered symbol gets a dense row id and each indicator is a
+ * column with one value per row, in structure-of-arrays form. All the
+ * columns read one price history per row, a ring buffer sized for the
+ * longest period. A time slice of prices updates the history and then
+ * runs each column's kernel over the rows in one loop, instead of a
+ * virtual Update per symbol and indicator. Per row the values are
+ * those of the streaming SimpleMovingAverage, ExponentialMovingAverage,
+ * Momentum and MomentumPercent.
+ *
+ * Columns must be added before the first update. Queries only consider
+ * the rows whose column is ready, the other rows get NaN.
+ * @ingroup IndicatorsLayer
+ * @see SecurityHoldingsStore
+ */
+class CrossSectionalEngine {
+ public:
+  /**
+   * The indicator computed by a column.
+   */
+  enum Kernel {
+    kSimpleMovingAverage,
+    kExponentialMovingAverage,
+    kMomentum,
+    kMomentumPercent
+  };
+
+  /**
+   * Standard constructor.
+   */
+  CrossSectionalEngine();
+
+  /**
+   * Standard destructor.
+   */
+  virtual ~CrossSectionalEngine();
+
+  /**
+   * Register a symbol and get its row id. Registering an existing
+   * symbol returns the same id.
+   * @param symbol Symbol of the security
+   * @return Row id of the symbol
+   */
+  int Register(const string& symbol);
+
+  /**
+   * Get the row id of the symbol.
+   * @return Row id, or -1 if the symbol is not registered.
+   */
+  int GetId(const string& symbol) const;
+
+  /**
+   * Add an indicator column.
+   * @param kernel The indicator computed by the column
+   * @param period The period of the indicator
+   * @return Column id, or -1 if the engine was already updated.
+   */
+  int AddColumn(Kernel kernel, int period);
+
+  /**
+   * Apply the prices of one time slice in a single pass. A row gets one
+   * price per slice: a repeated id only replaces the price of the row,
+   * ids outside [0, size()) are skipped.
+   * @param ids Row ids of the securities with new data
+   * @param prices New prices, parallel to ids
+   */
+  void Update(const vector<int>& ids, const vector<double>& prices);
+
+  /**
+   * Apply a price to every row in a single pass.
+   * @param prices Dense price array of size() elements
+   */
+  void Update(const double* prices);
+
+  /**
+   * Number of rows in the engine.
+   */
+  int size() const { return static_cast<int>(symbols_.size()); }
+
+  /**
+   * Number of columns in the engine.
+   */
+  int columns() const { return static_cast<int>(columns_.size()); }
+
+  const string& symbol(int id) const { return symbols_[id]; }
+
+  /**
+   * Number of prices received by a row.
+   */
+  int64 samples(int id) const { return samples_[id]; }
+
+  /**
+   * Value of a column for one row.
+   */
+  double value(int column, int id) const {
+    return columns_[column].values[id];
+  }
+
+  /**
+   * Dense values of a column, size() elements.
+   */
+  const double* column_values(int column) const {
+    return columns_[column].values.data();
+  }
+
+  /**
+   * True if the row has received more prices than the column period,
+   * as the streaming indicator's is_ready().
+   */
+  bool is_ready(int column, int id) const {
+    return samples_[id] > columns_[column].period;
+  }
+
+  /**
+   * Number of rows whose column is ready.
+   */
+  int ReadyCount(int column) const;
+
+  /**
+   * Rank of every row in a column, 0 for the smallest value, ties get
+   * the same rank.
+   * @param column Column id
+   * @param ranks[out] size() ranks, NaN for the rows not ready
+   */
+  void Rank(int column, vector<double>* ranks) const;
+
+  /**
+   * Percentile of every row in a column: the rank divided by the
+   * number of ready rows less one, in [0, 1]. A single ready row
+   * gets 1.
+   * @param column Column id
+   * @param percentiles[out] size() percentiles, NaN for the rows not ready
+   */
+  void Percentile(int column, vector<double>* percentiles) const;
+
+  /**
+   * Z-score of every row in a column against the ready rows:
+   * (value - mean) / standard deviation.
+   * @param column Column id
+   * @param scores[out] size() scores, NaN for the rows not ready
+   */
+  void ZScore(int column, vector<double>* scores) const;
+
+  /**
+   * Rows with the largest values of a column, found with a partial
+   * selection rather than a full sort.
+   * @param column Column id
+   * @param k Number of rows
+   * @param ids[out] Up to k row ids, largest value first
+   */
+  void TopK(int column, int k, vector<int>* ids) const;
+
+  /**
+   * Rows with the smallest values of a column.
+   * @param column Column id
+   * @param k Number of rows
+   * @param ids[out] Up to k row ids, smallest value first
+   */
+  void BottomK(int column, int k, vector<int>* ids) const;
+
+ private:
+  /**
+   * One indicator column.
+   */
+  class Column {
+   public:
+    Kernel kernel;
+    int period;
+    double smoothing_factor;  // Exponential moving average only
+    vector<double> values;  // Indicator value of each row
+    vector<double> sums;  // Running sum of each row, SMA and momentum %
+  };
+  map<string, int> symbol_ids_;
+  vector<string> symbols_;
+  vector<int64> samples_;
+  // Price history ring of each row: history_[id * capacity_ + slot]
+  vector<double> history_;
+  // Power of two larger than the longest period
+  int capacity_;
+  vector<Column> columns_;
+  bool updated_;
+  // Number of sparse updates, and the last one each row took part in
+  int64 slice_count_;
+  vector<int64> row_slice_;
+  // Distinct valid row ids of the current sparse update
+  vector<int> slice_ids_;
+
+  /**
+   * Size the history ring for the longest period.
+   */
+  void Allocate();
+
+  /**
+   * Run the column kernels on the rows which just received a price.
+   */
+  void UpdateColumns(const int* ids, int count);
+
+  /**
+   * Ids of the rows whose column is ready.
+   */
+  void GetReadyRows(int column, vector<int>* ids) const;
+
+  DISALLOW_COPY_AND_ASSIGN(CrossSectionalEngine);
+};
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_CROSS_SECTIONAL_ENGINE_H_
@@ -30,13 +30,13 @@ Delay::Delay(const string& name, int period)
     : WindowIndicator(name, period) {
 }
 
-double Delay::ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                               IndicatorDataPoint input) {
+double Delay::ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                               const IndicatorSample& input) {
   if (!window->is_ready()) {
     // Grab the initial value until we're ready
-    return (*window)[window->count() - 1].value();
+    return (*window)[window->count() - 1].value;
   }
-  return (window->most_recently_removed()).value();
+  return (window->most_recently_removed()).value;
 }
 }  // namespace indicators
 }  // namespace quantsystem
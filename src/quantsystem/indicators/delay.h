@@ -23,7 +23,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/indicators/window_indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/iread_only_window.h"
 namespace quantsystem {
 namespace indicators {
@@ -31,7 +31,7 @@ namespace indicators {
  * An indicator that delays its input for a certain period.
  * @ingroup IndicatorsLayer
  */
-class Delay : public WindowIndicator<IndicatorDataPoint> {
+class Delay : public WindowIndicator<IndicatorSample> {
  public:
   /**
    * Creates a new Delay indicator that delays its input
@@ -54,8 +54,8 @@ class Delay : public WindowIndicator<IndicatorDataPoint> {
    * @param input The input value to this indicator on this time step
    * @return A new value for this indicator
    */
-  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                                  IndicatorDataPoint input);
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
 };
 
 }  // namespace indicators
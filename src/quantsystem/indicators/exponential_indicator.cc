@@ -51,11 +51,11 @@ ExponentialMovingAverage::ExponentialMovingAverage(
 }
 
 double ExponentialMovingAverage::ComputeNextValue(
-    const IndicatorDataPoint& input) {
+    const IndicatorSample& input) {
   if (samples() == 1) {
-    return input.value();
+    return input.value;
   }
-  return input.value() * k_ + current().value() * (1 - k_);
+  return input.value * k_ + current().value * (1 - k_);
 }
 }  // namespace indicators
 }  // namespace quantsystem
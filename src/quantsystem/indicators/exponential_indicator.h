@@ -23,7 +23,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/indicators/indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -70,7 +70,7 @@ class ExponentialMovingAverage : public Indicator {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return samples() > period_;
   }
 
@@ -80,7 +80,7 @@ class ExponentialMovingAverage : public Indicator {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(const IndicatorSample& input);
 
  private:
   double k_;
@@ -35,7 +35,7 @@ namespace indicators {
  * @ingroup IndicatorsLayer
  */
 template <typename T>
-class FunctionalIndicator : IndicatorBase<T> {
+class FunctionalIndicator : public IndicatorBase<T> {
  public:
   typedef function<bool()> ReadyHandler;
   typedef function<double(const T&)> ComputeNewHandler;  //NOLINT
@@ -24,8 +24,8 @@ Identity::Identity(const string& name)
     : Indicator(name) {
 }
 
-double Identity::ComputeNextValue(const IndicatorDataPoint& input) {
-  return input.value();
+double Identity::ComputeNextValue(const IndicatorSample& input) {
+  return input.value;
 }
 }  // namespace indicators
 }  // namespace quantsystem
@@ -23,7 +23,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/indicators/indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -43,7 +43,7 @@ class Identity : public Indicator {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return samples() > 0;
   }
 
@@ -53,7 +53,7 @@ class Identity : public Indicator {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(const IndicatorSample& input);
 };
 
 }  // namespace indicators
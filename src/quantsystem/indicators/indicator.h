@@ -23,7 +23,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/indicators/indicator_base.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 
 namespace quantsystem {
 namespace indicators {
@@ -33,14 +33,14 @@ namespace indicators {
  * and transform data into a new, more informative form.
  * @ingroup IndicatorsLayer
  */
-class Indicator : public IndicatorBase<IndicatorDataPoint> {
+class Indicator : public IndicatorBase<IndicatorSample> {
  protected:
   /**
    * Initializes a new instance of the Indicator class using the specified name.
    * @param name The name of this indicator.
    */
   explicit Indicator(const string& name)
-      : IndicatorBase<IndicatorDataPoint>(name) {
+      : IndicatorBase<IndicatorSample>(name) {
   }
 
   /**
@@ -48,7 +48,7 @@ class Indicator : public IndicatorBase<IndicatorDataPoint> {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(const IndicatorDataPoint& input) = 0;
+  virtual double ComputeNextValue(const IndicatorSample& input) = 0;
 };
 
 }  // namespace indicators
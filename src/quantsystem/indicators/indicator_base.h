@@ -27,8 +27,9 @@
 
 #include <string>
 using std::string;
+#include <glog/logging.h>
 #include "quantsystem/common/base/integral_types.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -38,6 +39,11 @@ namespace indicators {
 template <typename T>
 class IndicatorBase {
  public:
+  /**
+   * Standard destructor.
+   */
+  virtual ~IndicatorBase() {}
+
   /**
    * Get a name for this indicator.
    */
@@ -50,15 +56,15 @@ class IndicatorBase {
 
   /**
    * Gets the current state of this indicator. If the state has not been updated
-   * then the time on the value will equal DateTime.MinValue.
+   * then the time on the value will be 0.
    */
-  IndicatorDataPoint current() const { return current_; }
+  const IndicatorSample& current() const { return current_; }
 
   /**
    * Return the current value of this indicate.
    */
   virtual double value() const {
-    return current_.value();
+    return current_.value;
   }
 
   /**
@@ -73,6 +79,18 @@ class IndicatorBase {
    * @return True if this indicator is ready, false otherwise
    */
   bool Update(const T& input) {
+    const int64 time = GetSampleTime(input);
+    if (samples_ > 0 && time < previous_time_) {
+      LOG(ERROR) << "This is a forward only indicator: " << name_ <<
+          " Input: " << FromSampleTime(time).ToString() << " Previous: " <<
+          FromSampleTime(previous_time_).ToString();
+      return is_ready();
+    }
+    previous_time_ = time;
+    ++samples_;
+    double next_value = ComputeNextValue(input);
+    current_ = MakeIndicatorSample(time, next_value);
+    return is_ready();
   }
 
   /**
@@ -80,6 +98,8 @@ class IndicatorBase {
    */
   virtual void Reset() {
     samples_ = 0;
+    previous_time_ = 0;
+    current_ = MakeIndicatorSample(0, 0);
   }
 
  protected:
@@ -87,7 +107,11 @@ class IndicatorBase {
    * Initializes a new instance of the Indicator class using the specified name.
    */
   explicit IndicatorBase(const string& name)
-      : name_(name) {
+      : previous_time_(0),
+        name_(name),
+        is_ready_(false),
+        current_(MakeIndicatorSample(0, 0)),
+        samples_(0) {
   }
 
   /**
@@ -98,16 +122,16 @@ class IndicatorBase {
   virtual double ComputeNextValue(const T& input) = 0;
 
  private:
-  // The most recent input that was given to this indicator
-  T previous_input_;
+  // Time of the most recent input that was given to this indicator
+  int64 previous_time_;
   string name_;  // Indicator name
   bool is_ready_;  // Whether this indicator is ready
-  IndicatorDataPoint current_;  // Current state of this indicator
+  IndicatorSample current_;  // Current state of this indicator
   int64 samples_;  // The number of samples processed by this indicator
 
   void set_name(const string& name) { name_ = name; }
 
-  void set_current(const IndicatorDataPoint& current) { current_ = current; }
+  void set_current(const IndicatorSample& current) { current_ = current; }
 
   void set_samples(int64 samples) { samples_ = samples; }
 };
@@ -0,0 +1,181 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/indicator_batch.h"
+#include "quantsystem/indicators/monotonic_deque.h"
+namespace quantsystem {
+namespace indicators {
+void ComputeSimpleMovingAverage(int period, const double* values, int count,
+                                double* output) {
+  double sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += values[i];
+    if (i >= period) {
+      sum -= values[i - period];
+    }
+    output[i] = sum / (i < period ? i + 1 : period);
+  }
+}
+
+void ComputeExponentialMovingAverage(double smoothing_factor,
+                                     const double* values, int count,
+                                     double* output) {
+  if (count == 0) {
+    return;
+  }
+  const double k = smoothing_factor;
+  output[0] = values[0];
+  for (int i = 1; i < count; ++i) {
+    output[i] = values[i] * k + output[i - 1] * (1 - k);
+  }
+}
+
+void ComputeMovingAverage(MovingAverageType type, int period,
+                          const double* values, int count, double* output) {
+  switch (type) {
+    case kSimple:
+      ComputeSimpleMovingAverage(period, values, count, output);
+      break;
+    case kExponential:
+      ComputeExponentialMovingAverage(2.0 / (period + 1), values, count,
+                                      output);
+      break;
+    case kWilders:
+      ComputeExponentialMovingAverage(1.0 / period, values, count, output);
+      break;
+    default:
+      LOG(FATAL) << "Input problem? moving average type = " << type;
+  }
+}
+
+void ComputeMomentum(int period, const double* values, int count,
+                     double* output) {
+  // Until the window is full the change is from the first value
+  const int warm_up = std::min(period, count);
+  for (int i = 0; i < warm_up; ++i) {
+    output[i] = values[i] - values[0];
+  }
+  for (int i = warm_up; i < count; ++i) {
+    output[i] = values[i] - values[i - period];
+  }
+}
+
+void ComputeMomentumPercent(int period, const double* values, int count,
+                            double* output) {
+  vector<double> average(count);
+  ComputeSimpleMovingAverage(period, values, count, average.data());
+  ComputeMomentum(period, values, count, output);
+  const double* mean = average.data();
+  for (int i = 0; i < count; ++i) {
+    output[i] = mean[i] == 0 ? 0 : output[i] / mean[i];
+  }
+}
+
+void ComputeMovingAverageConvergenceDivergence(int fast_period,
+                                               int slow_period,
+                                               int signal_period,
+                                               MovingAverageType type,
+                                               const double* values,
+                                               int count, double* output,
+                                               double* signal) {
+  vector<double> fast(count), slow(count);
+  ComputeMovingAverage(type, fast_period, values, count, fast.data());
+  ComputeMovingAverage(type, slow_period, values, count, slow.data());
+  const double* fast_value = fast.data();
+  const double* slow_value = slow.data();
+  for (int i = 0; i < count; ++i) {
+    output[i] = fast_value[i] - slow_value[i];
+  }
+  if (signal == NULL) {
+    return;
+  }
+  // The signal only sees the values once both averages are ready
+  const int first = std::min(std::max(fast_period, slow_period), count);
+  std::fill(signal, signal + first, 0.0);
+  ComputeMovingAverage(type, signal_period, output + first, count - first,
+                       signal + first);
+}
+
+void ComputeRelativeStrengthIndex(int period, MovingAverageType type,
+                                  const double* values, int count,
+                                  double* output) {
+  if (count == 0) {
+    return;
+  }
+  // The averages see one gain and one loss per change
+  const int changes = count - 1;
+  vector<double> gain(changes), loss(changes);
+  for (int i = 0; i < changes; ++i) {
+    double change = values[i + 1] - values[i];
+    gain[i] = change >= 0 ? change : 0;
+    loss[i] = change >= 0 ? 0 : -change;
+  }
+  vector<double> average_gain(changes), average_loss(changes);
+  ComputeMovingAverage(type, period, gain.data(), changes,
+                       average_gain.data());
+  ComputeMovingAverage(type, period, loss.data(), changes,
+                       average_loss.data());
+  output[0] = 100;
+  const double* up = average_gain.data();
+  const double* down = average_loss.data();
+  for (int i = 0; i < changes; ++i) {
+    output[i + 1] = down[i] == 0 ? 100 : 100 - (100 / (1 + up[i] / down[i]));
+  }
+}
+
+void ComputeAverageTrueRange(int period, MovingAverageType type,
+                             const double* high, const double* low,
+                             const double* close, int count,
+                             double* output) {
+  if (count == 0) {
+    return;
+  }
+  vector<double> true_range(count);
+  double* range = true_range.data();
+  range[0] = high[0] - low[0];
+  for (int i = 1; i < count; ++i) {
+    range[i] = std::max(high[i] - low[i],
+                        std::max(std::fabs(high[i] - close[i - 1]),
+                                 std::fabs(low[i] - close[i - 1])));
+  }
+  ComputeMovingAverage(type, period, range, count, output);
+}
+
+void ComputeAroonOscillator(int up_period, int down_period,
+                            const double* high, const double* low,
+                            int count, double* output) {
+  // Windows of the current bar and the period before it
+  MaximumDeque max(up_period + 1);
+  MinimumDeque min(down_period + 1);
+  for (int i = 0; i < count; ++i) {
+    max.Add(high[i]);
+    min.Add(low[i]);
+    double aroon_up = 100.0 * (up_period - max.periods_since()) / up_period;
+    double aroon_down =
+        100.0 * (down_period - min.periods_since()) / down_period;
+    output[i] = aroon_up - aroon_down;
+  }
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,158 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_INDICATOR_BATCH_H_
+#define QUANTSYSTEM_INDICATORS_INDICATOR_BATCH_H_
+
+#include "quantsystem/indicators/moving_average_type.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Indicators computed over whole historical arrays, for warm up and
+ * research.
+ *
+ * Each function takes the inputs as contiguous arrays of count values
+ * (or OHLC columns) and writes output[i], the value the streaming
+ * indicator has after its update with input i. The results are bit
+ * for bit those of the streaming path: the same floating point
+ * operations are done in the same order. Where the streaming path has
+ * no loop carried state (momentum, true range, the RSI and percent
+ * ratios) the kernels are straight loops over the arrays which the
+ * compiler vectorizes. The running sum of the SMA and the exponential
+ * recurrences stay serial, reordering them with prefix sums would
+ * change the rounding.
+ * @ingroup IndicatorsLayer
+ */
+
+/**
+ * Simple moving average, as SimpleMovingAverage.
+ * @param period The period of the average
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count average values
+ */
+void ComputeSimpleMovingAverage(int period, const double* values, int count,
+                                double* output);
+
+/**
+ * Exponential moving average, as ExponentialMovingAverage.
+ * @param smoothing_factor Weight of the new value, 2 / (period + 1)
+ * for the standard average and 1 / period for Wilder's
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count average values
+ */
+void ComputeExponentialMovingAverage(double smoothing_factor,
+                                     const double* values, int count,
+                                     double* output);
+
+/**
+ * Moving average of the given type, as the indicator built by
+ * ToIndicator.
+ * @param type Type of the moving average
+ * @param period The period of the average
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count average values
+ */
+void ComputeMovingAverage(MovingAverageType type, int period,
+                          const double* values, int count, double* output);
+
+/**
+ * Momentum, as Momentum: the change over the period.
+ * @param period The period of the momentum
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count momentum values
+ */
+void ComputeMomentum(int period, const double* values, int count,
+                     double* output);
+
+/**
+ * Momentum scaled by the simple moving average, as MomentumPercent.
+ * @param period The period of the momentum and of the average
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count momentum percent values
+ */
+void ComputeMomentumPercent(int period, const double* values, int count,
+                            double* output);
+
+/**
+ * Moving average convergence divergence, as
+ * MovingAverageConvergenceDivergence.
+ * @param fast_period The period of the fast average
+ * @param slow_period The period of the slow average
+ * @param signal_period The period of the signal average
+ * @param type Type of the moving averages
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count MACD values
+ * @param signal[out] count signal values, may be NULL
+ */
+void ComputeMovingAverageConvergenceDivergence(int fast_period,
+                                               int slow_period,
+                                               int signal_period,
+                                               MovingAverageType type,
+                                               const double* values,
+                                               int count, double* output,
+                                               double* signal);
+
+/**
+ * Relative strength index, as RelativeStrengthIndex.
+ * @param period The period of the gain and loss averages
+ * @param type Type of the gain and loss averages
+ * @param values Input values
+ * @param count Number of values
+ * @param output[out] count RSI values
+ */
+void ComputeRelativeStrengthIndex(int period, MovingAverageType type,
+                                  const double* values, int count,
+                                  double* output);
+
+/**
+ * Average true range, as AverageTrueRange.
+ * @param period The smoothing period of the true range
+ * @param type Type of the smoothing average
+ * @param high High of each bar
+ * @param low Low of each bar
+ * @param close Close of each bar
+ * @param count Number of bars
+ * @param output[out] count ATR values
+ */
+void ComputeAverageTrueRange(int period, MovingAverageType type,
+                             const double* high, const double* low,
+                             const double* close, int count,
+                             double* output);
+
+/**
+ * Aroon oscillator, as AroonOscillator.
+ * @param up_period The look back period of AroonUp
+ * @param down_period The look back period of AroonDown
+ * @param high High of each bar
+ * @param low Low of each bar
+ * @param count Number of bars
+ * @param output[out] count oscillator values
+ */
+void ComputeAroonOscillator(int up_period, int down_period,
+                            const double* high, const double* low,
+                            int count, double* output);
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_INDICATOR_BATCH_H_
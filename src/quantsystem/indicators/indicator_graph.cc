@@ -0,0 +1,208 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/indicator_graph.h"
+#include "quantsystem/indicators/moving_average_type_extensions.h"
+namespace quantsystem {
+namespace indicators {
+IndicatorGraph::IndicatorGraph(const string& name_suffix)
+    : name_suffix_(name_suffix) {
+}
+
+IndicatorGraph::~IndicatorGraph() {
+  // Reverse order: a node is deleted before the nodes it reads
+  for (int i = size() - 1; i >= 0; --i) {
+    delete nodes_[i].indicator;
+    delete nodes_[i].tradebar_indicator;
+  }
+}
+
+IndicatorBase<IndicatorSample>* IndicatorGraph::MovingAverage(
+    MovingAverageType type, int period) {
+  string key = AverageKey(type, period);
+  IndicatorBase<IndicatorSample>* average =
+      Find<IndicatorBase<IndicatorSample> >(key);
+  if (average == NULL) {
+    average = ToIndicator(type, key + name_suffix_, period);
+    AddNode(key, average, NULL);
+  }
+  return average;
+}
+
+SimpleMovingAverage* IndicatorGraph::SMA(int period) {
+  return static_cast<SimpleMovingAverage*>(MovingAverage(kSimple, period));
+}
+
+ExponentialMovingAverage* IndicatorGraph::EMA(int period) {
+  return static_cast<ExponentialMovingAverage*>(
+      MovingAverage(kExponential, period));
+}
+
+MovingAverageConvergenceDivergence* IndicatorGraph::MACD(
+    int fast_period, int slow_period, int signal_period,
+    MovingAverageType type) {
+  string key = "MACD(" + to_string(fast_period) + "," +
+      to_string(slow_period) + "," + to_string(signal_period) + "," +
+      MovingAverageTypeToString(type) + ")";
+  MovingAverageConvergenceDivergence* macd =
+      Find<MovingAverageConvergenceDivergence>(key);
+  if (macd == NULL) {
+    // The averages come first so they are updated before the MACD
+    IndicatorBase<IndicatorSample>* fast = MovingAverage(type, fast_period);
+    IndicatorBase<IndicatorSample>* slow = MovingAverage(type, slow_period);
+    macd = new MovingAverageConvergenceDivergence(
+        key + name_suffix_, fast, slow, signal_period, type);
+    AddNode(key, macd, NULL);
+  }
+  return macd;
+}
+
+RelativeStrengthIndex* IndicatorGraph::RSI(int period,
+                                           MovingAverageType type) {
+  string key = "RSI" + to_string(period) + MovingAverageTypeToString(type);
+  RelativeStrengthIndex* rsi = Find<RelativeStrengthIndex>(key);
+  if (rsi == NULL) {
+    rsi = new RelativeStrengthIndex(key + name_suffix_, period, type);
+    AddNode(key, rsi, NULL);
+  }
+  return rsi;
+}
+
+Momentum* IndicatorGraph::MOM(int period) {
+  string key = "MOM" + to_string(period);
+  Momentum* momentum = Find<Momentum>(key);
+  if (momentum == NULL) {
+    momentum = new Momentum(key + name_suffix_, period);
+    AddNode(key, momentum, NULL);
+  }
+  return momentum;
+}
+
+MomentumPercent* IndicatorGraph::MOMP(int period) {
+  string key = "MOMP" + to_string(period);
+  MomentumPercent* momentum = Find<MomentumPercent>(key);
+  if (momentum == NULL) {
+    momentum = new MomentumPercent(key + name_suffix_, period);
+    AddNode(key, momentum, NULL);
+  }
+  return momentum;
+}
+
+Maximum* IndicatorGraph::MAX(int period) {
+  string key = "MAX" + to_string(period);
+  Maximum* maximum = Find<Maximum>(key);
+  if (maximum == NULL) {
+    maximum = new Maximum(key + name_suffix_, period);
+    AddNode(key, maximum, NULL);
+  }
+  return maximum;
+}
+
+Minimum* IndicatorGraph::MIN(int period) {
+  string key = "MIN" + to_string(period);
+  Minimum* minimum = Find<Minimum>(key);
+  if (minimum == NULL) {
+    minimum = new Minimum(key + name_suffix_, period);
+    AddNode(key, minimum, NULL);
+  }
+  return minimum;
+}
+
+AverageTrueRange* IndicatorGraph::ATR(int period, MovingAverageType type) {
+  string key = "ATR" + to_string(period) + MovingAverageTypeToString(type);
+  AverageTrueRange* atr = Find<AverageTrueRange>(key);
+  if (atr == NULL) {
+    atr = new AverageTrueRange(key + name_suffix_, period, type);
+    AddNode(key, NULL, atr);
+  }
+  return atr;
+}
+
+AroonOscillator* IndicatorGraph::AROON(int up_period, int down_period) {
+  string key = "AROON(" + to_string(up_period) + "," +
+      to_string(down_period) + ")";
+  AroonOscillator* aroon = Find<AroonOscillator>(key);
+  if (aroon == NULL) {
+    aroon = new AroonOscillator(key + name_suffix_, up_period, down_period);
+    AddNode(key, NULL, aroon);
+  }
+  return aroon;
+}
+
+void IndicatorGraph::Update(const BaseData& data) {
+  const IndicatorSample sample = ToIndicatorSample(data);
+  const TradeBar* bar = NULL;
+  bool is_bar_checked = false;
+  const int count = size();
+  for (int i = 0; i < count; ++i) {
+    const Node& node = nodes_[i];
+    if (node.indicator != NULL) {
+      node.indicator->Update(sample);
+      continue;
+    }
+    if (!is_bar_checked) {
+      bar = dynamic_cast<const TradeBar*>(&data);
+      is_bar_checked = true;
+    }
+    if (bar == NULL) {
+      LOG(ERROR) << "TradeBar indicator " << node.tradebar_indicator->name()
+                 << " on a stream which is not made of TradeBars";
+      continue;
+    }
+    node.tradebar_indicator->Update(*bar);
+  }
+}
+
+void IndicatorGraph::Reset() {
+  const int count = size();
+  for (int i = 0; i < count; ++i) {
+    if (nodes_[i].indicator != NULL) {
+      nodes_[i].indicator->Reset();
+    } else {
+      nodes_[i].tradebar_indicator->Reset();
+    }
+  }
+}
+
+void IndicatorGraph::AddNode(const string& key,
+                             IndicatorBase<IndicatorSample>* indicator,
+                             IndicatorBase<TradeBar>* tradebar_indicator) {
+  Node node = {indicator, tradebar_indicator};
+  keys_[key] = size();
+  nodes_.push_back(node);
+}
+
+string IndicatorGraph::AverageKey(MovingAverageType type, int period) {
+  switch (type) {
+    case kSimple:
+      return "SMA" + to_string(period);
+    case kExponential:
+      return "EMA" + to_string(period);
+    case kWilders:
+      return "RMA" + to_string(period);
+    default:
+      LOG(FATAL) << "Input problem? moving average type = " << type;
+      return "";
+  }
+}
+}  // namespace indicators
+}  // namespace quantsystem
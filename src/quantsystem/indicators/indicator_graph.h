@@ -0,0 +1,164 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_INDICATOR_GRAPH_H_
+#define QUANTSYSTEM_INDICATORS_INDICATOR_GRAPH_H_
+
+#include <map>
+using std::map;
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/macros.h"
+#include "quantsystem/common/data/base_data.h"
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/indicators/aroon_oscillator.h"
+#include "quantsystem/indicators/average_true_range.h"
+#include "quantsystem/indicators/exponential_indicator.h"
+#include "quantsystem/indicators/indicator_base.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/maximum.h"
+#include "quantsystem/indicators/minimum.h"
+#include "quantsystem/indicators/momentum.h"
+#include "quantsystem/indicators/momentum_percent.h"
+#include "quantsystem/indicators/moving_average_converagence_divergence.h"
+#include "quantsystem/indicators/moving_average_type.h"
+#include "quantsystem/indicators/relative_strength_index.h"
+#include "quantsystem/indicators/simple_moving_average.h"
+namespace quantsystem {
+using data::BaseData;
+using data::market::TradeBar;
+namespace indicators {
+/**
+ * The indicators computed on one consolidated data stream, shared
+ * between registrations.
+ *
+ * Every indicator is a node keyed by its type and parameters, e.g.
+ * "EMA12" or "MACD(12,26,9,Exponential)". Asking for a node which
+ * already exists returns the existing indicator, so registering
+ * EMA(12) and MACD(12,26,9) on the same stream computes the 12 period
+ * average once: the MACD reads the shared EMA12 and EMA26 nodes.
+ * Nodes are kept in creation order, which is a topological order as a
+ * node's inputs are created before it, and each Update runs every node
+ * once in that order.
+ * @ingroup IndicatorsLayer
+ */
+class IndicatorGraph {
+ public:
+  /**
+   * Creates an empty graph.
+   * @param name_suffix Appended to the node keys to name the
+   * indicators, e.g. "(SPY_min)"
+   */
+  explicit IndicatorGraph(const string& name_suffix);
+
+  /**
+   * Standard destructor, deletes every node.
+   */
+  virtual ~IndicatorGraph();
+
+  /**
+   * Moving average of the stream values.
+   */
+  IndicatorBase<IndicatorSample>* MovingAverage(MovingAverageType type,
+                                                int period);
+  SimpleMovingAverage* SMA(int period);
+  ExponentialMovingAverage* EMA(int period);
+  MovingAverageConvergenceDivergence* MACD(int fast_period, int slow_period,
+                                           int signal_period,
+                                           MovingAverageType type);
+  RelativeStrengthIndex* RSI(int period, MovingAverageType type);
+  Momentum* MOM(int period);
+  MomentumPercent* MOMP(int period);
+  Maximum* MAX(int period);
+  Minimum* MIN(int period);
+
+  /**
+   * TradeBar indicators, the stream must be made of TradeBars.
+   */
+  AverageTrueRange* ATR(int period, MovingAverageType type);
+  AroonOscillator* AROON(int up_period, int down_period);
+
+  /**
+   * Update every node once with the consolidated data, in topological
+   * order.
+   * @param data New consolidated data of the stream
+   */
+  void Update(const BaseData& data);
+
+  /**
+   * Reset every node to its initial state.
+   */
+  void Reset();
+
+  /**
+   * Number of distinct indicators in the graph.
+   */
+  int size() const { return static_cast<int>(nodes_.size()); }
+
+ private:
+  /**
+   * One indicator of the graph: a value indicator fed with the stream
+   * values or a TradeBar indicator fed with the bars.
+   */
+  class Node {
+   public:
+    IndicatorBase<IndicatorSample>* indicator;
+    IndicatorBase<TradeBar>* tradebar_indicator;
+  };
+  string name_suffix_;
+  // Nodes in topological order
+  vector<Node> nodes_;
+  // Node index of each key
+  map<string, int> keys_;
+
+  /**
+   * Existing indicator of the key, NULL if there is none.
+   */
+  template <typename T>
+  T* Find(const string& key) const {
+    map<string, int>::const_iterator found = keys_.find(key);
+    if (found == keys_.end()) {
+      return NULL;
+    }
+    const Node& node = nodes_[found->second];
+    if (node.indicator != NULL) {
+      return dynamic_cast<T*>(node.indicator);
+    }
+    return dynamic_cast<T*>(node.tradebar_indicator);
+  }
+
+  /**
+   * Append a node, the graph takes the ownership of the indicator.
+   */
+  void AddNode(const string& key, IndicatorBase<IndicatorSample>* indicator,
+               IndicatorBase<TradeBar>* tradebar_indicator);
+
+  /**
+   * Key of a moving average node: SMA, EMA or RMA (Wilder's) and the
+   * period.
+   */
+  static string AverageKey(MovingAverageType type, int period);
+
+  DISALLOW_COPY_AND_ASSIGN(IndicatorGraph);
+};
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_INDICATOR_GRAPH_H_
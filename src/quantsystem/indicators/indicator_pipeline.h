@@ -0,0 +1,277 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_INDICATOR_PIPELINE_H_
+#define QUANTSYSTEM_INDICATORS_INDICATOR_PIPELINE_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/indicators/indicator.h"
+#include "quantsystem/indicators/indicator_sample.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Indicators composed at compile time.
+ *
+ * A Pipeline chains stages such as EMA<12>, Delay<1> or Momentum<10>:
+ * the output of each stage feeds the next one once the stage is ready,
+ * with the same semantics and values as nested SequentialIndicators of
+ * the runtime indicators. The stages are plain classes with inline,
+ * non virtual updates and windows of a compile time size, so the whole
+ * pipeline compiles into a single update function. PipelineIndicator
+ * wraps a pipeline as an IndicatorBase<IndicatorSample> to use it
+ * wherever a runtime indicator is expected.
+ *
+ * Pipeline<EMA<12>, Delay<1>, Momentum<10> > momentum;
+ * momentum.Update(price);
+ * @ingroup IndicatorsLayer
+ */
+namespace pipeline {
+/**
+ * Fixed size window of the last Size values, with the semantics of
+ * RollingWindow: ready once a value has been pushed out.
+ */
+template <int Size>
+class FixedWindow {
+ public:
+  FixedWindow() { Reset(); }
+
+  /**
+   * Add a value, the oldest one is removed once the window is full.
+   */
+  void Add(double value) {
+    if (samples_ >= Size) {
+      most_recently_removed_ = values_[head_];
+    }
+    values_[head_] = value;
+    head_ = head_ + 1 == Size ? 0 : head_ + 1;
+    ++samples_;
+  }
+
+  bool is_ready() const { return samples_ > Size; }
+  int64 samples() const { return samples_; }
+  int count() const { return samples_ < Size ? samples_ : Size; }
+
+  /**
+   * Oldest value still in the window.
+   */
+  double oldest() const {
+    return samples_ < Size ? values_[0] : values_[head_];
+  }
+
+  double most_recently_removed() const { return most_recently_removed_; }
+
+  void Reset() {
+    head_ = 0;
+    samples_ = 0;
+    most_recently_removed_ = 0;
+  }
+
+ private:
+  double values_[Size];
+  int head_;
+  int64 samples_;
+  double most_recently_removed_;
+};
+
+/**
+ * Simple moving average, as SimpleMovingAverage.
+ */
+template <int Period>
+class SMA {
+ public:
+  SMA() { Reset(); }
+  double Update(double input) {
+    window_.Add(input);
+    sum_ += input;
+    if (window_.is_ready()) {
+      sum_ -= window_.most_recently_removed();
+    }
+    return sum_ / window_.count();
+  }
+  bool is_ready() const { return window_.is_ready(); }
+  void Reset() {
+    window_.Reset();
+    sum_ = 0;
+  }
+
+ private:
+  FixedWindow<Period> window_;
+  double sum_;
+};
+
+/**
+ * Exponential moving average with a smoothing factor of
+ * Numerator / (Period + Offset), as ExponentialMovingAverage.
+ */
+template <int Period, int Numerator, int Offset>
+class ExponentialAverage {
+ public:
+  ExponentialAverage() { Reset(); }
+  double Update(double input) {
+    static const double k = static_cast<double>(Numerator) /
+        (Period + Offset);
+    value_ = ++samples_ == 1 ? input : input * k + value_ * (1 - k);
+    return value_;
+  }
+  bool is_ready() const { return samples_ > Period; }
+  void Reset() {
+    samples_ = 0;
+    value_ = 0;
+  }
+
+ private:
+  int64 samples_;
+  double value_;
+};
+
+/**
+ * Standard exponential moving average, smoothing factor 2 / (n + 1).
+ */
+template <int Period>
+class EMA : public ExponentialAverage<Period, 2, 1> {
+};
+
+/**
+ * Wilder's moving average, smoothing factor 1 / n.
+ */
+template <int Period>
+class Wilders : public ExponentialAverage<Period, 1, 0> {
+};
+
+/**
+ * Value of Period samples ago, as Delay.
+ */
+template <int Period>
+class Delay {
+ public:
+  double Update(double input) {
+    window_.Add(input);
+    return window_.is_ready() ? window_.most_recently_removed() :
+        window_.oldest();
+  }
+  bool is_ready() const { return window_.is_ready(); }
+  void Reset() { window_.Reset(); }
+
+ private:
+  FixedWindow<Period> window_;
+};
+
+/**
+ * Change over Period samples, as Momentum.
+ */
+template <int Period>
+class Momentum {
+ public:
+  double Update(double input) {
+    window_.Add(input);
+    return input - (window_.is_ready() ? window_.most_recently_removed() :
+                    window_.oldest());
+  }
+  bool is_ready() const { return window_.is_ready(); }
+  void Reset() { window_.Reset(); }
+
+ private:
+  FixedWindow<Period> window_;
+};
+
+/**
+ * Chain of stages, each one fed with the output of the previous one
+ * once that one is ready.
+ */
+template <typename... Stages>
+class Pipeline;
+
+template <typename Stage>
+class Pipeline<Stage> {
+ public:
+  double Update(double input) { return stage_.Update(input); }
+  bool is_ready() const { return stage_.is_ready(); }
+  void Reset() { stage_.Reset(); }
+
+ private:
+  Stage stage_;
+};
+
+template <typename Stage, typename... Rest>
+class Pipeline<Stage, Rest...> {
+ public:
+  double Update(double input) {
+    double value = stage_.Update(input);
+    if (!stage_.is_ready()) {
+      // As SequentialIndicator: a default value until the stage is ready
+      return 0;
+    }
+    return rest_.Update(value);
+  }
+  bool is_ready() const { return rest_.is_ready() && stage_.is_ready(); }
+  void Reset() {
+    stage_.Reset();
+    rest_.Reset();
+  }
+
+ private:
+  Stage stage_;
+  Pipeline<Rest...> rest_;
+};
+}  // namespace pipeline
+
+/**
+ * A compile time pipeline used as a runtime indicator: one virtual call
+ * per update, the stages inside are inlined.
+ * @ingroup IndicatorsLayer
+ */
+template <typename PipelineType>
+class PipelineIndicator : public Indicator {
+ public:
+  /**
+   * Creates a new indicator running the pipeline.
+   * @param name The name of this indicator
+   */
+  explicit PipelineIndicator(const string& name)
+      : Indicator(name) {
+  }
+
+  /**
+   * Gets a flag indicating when this indicator is ready and fully initialized.
+   */
+  virtual bool is_ready() const { return pipeline_.is_ready(); }
+
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset() {
+    pipeline_.Reset();
+    Indicator::Reset();
+  }
+
+  const PipelineType& pipeline() const { return pipeline_; }
+
+ protected:
+  virtual double ComputeNextValue(const IndicatorSample& input) {
+    return pipeline_.Update(input.value);
+  }
+
+ private:
+  PipelineType pipeline_;
+};
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_INDICATOR_PIPELINE_H_
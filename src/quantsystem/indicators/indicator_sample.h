@@ -0,0 +1,130 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_INDICATOR_SAMPLE_H_
+#define QUANTSYSTEM_INDICATORS_INDICATOR_SAMPLE_H_
+
+#include "quantsystem/common/base/integral_types.h"
+#include "quantsystem/common/data/base_data.h"
+#include "quantsystem/common/time/date_time.h"
+#include "quantsystem/indicators/indicator_data_point.h"
+namespace quantsystem {
+using data::BaseData;
+namespace indicators {
+/**
+ * Plain time-value sample flowing through the indicators.
+ *
+ * Unlike IndicatorDataPoint it has no vtable, symbol or data type, so
+ * windows of samples are densely packed and composite indicators pass
+ * samples around without copying strings. Market data is converted
+ * with ToIndicatorSample at the algorithm boundary.
+ * @ingroup IndicatorsLayer
+ */
+class IndicatorSample {
+ public:
+  int64 time;  // Microseconds since the epoch
+  double value;  // Value of the sample
+};
+
+/**
+ * Paired time-value sample for the indicators of two series, e.g. the
+ * returns of a stock (y) against the returns of its benchmark (x).
+ * @ingroup IndicatorsLayer
+ */
+class IndicatorPairSample {
+ public:
+  int64 time;  // Microseconds since the epoch
+  double x;  // Value of the first (independent) series
+  double y;  // Value of the second (dependent) series
+};
+
+/**
+ * Build a sample from its time and value.
+ */
+inline IndicatorSample MakeIndicatorSample(int64 time, double value) {
+  IndicatorSample sample;
+  sample.time = time;
+  sample.value = value;
+  return sample;
+}
+
+/**
+ * Build a paired sample from its time and values.
+ */
+inline IndicatorPairSample MakeIndicatorPairSample(int64 time, double x,
+                                                   double y) {
+  IndicatorPairSample sample;
+  sample.time = time;
+  sample.x = x;
+  sample.y = y;
+  return sample;
+}
+
+/**
+ * Convert a date time to the sample time, microseconds since the epoch.
+ */
+inline int64 ToSampleTime(const DateTime& time) {
+  return time.ToEpochMicroseconds();
+}
+
+/**
+ * Convert a sample time back to a date time.
+ */
+inline DateTime FromSampleTime(int64 time) {
+  return DateTime::FromEpochMicroseconds(time);
+}
+
+/**
+ * Sample of the time and value of market data.
+ */
+inline IndicatorSample ToIndicatorSample(const BaseData& data) {
+  return MakeIndicatorSample(ToSampleTime(data.time()), data.value());
+}
+
+/**
+ * Sample of a date time and a value.
+ */
+inline IndicatorSample ToIndicatorSample(const DateTime& time,
+                                         double value) {
+  return MakeIndicatorSample(ToSampleTime(time), value);
+}
+
+/**
+ * Data point of a sample, for the consumers of BaseData.
+ */
+inline IndicatorDataPoint ToIndicatorDataPoint(
+    const IndicatorSample& sample) {
+  return IndicatorDataPoint(FromSampleTime(sample.time), sample.value);
+}
+
+/**
+ * Time of an indicator input in microseconds since the epoch.
+ */
+inline int64 GetSampleTime(const IndicatorSample& input) {
+  return input.time;
+}
+inline int64 GetSampleTime(const IndicatorPairSample& input) {
+  return input.time;
+}
+inline int64 GetSampleTime(const BaseData& input) {
+  return ToSampleTime(input.time());
+}
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_INDICATOR_SAMPLE_H_
@@ -20,6 +20,7 @@
 #ifndef QUANTSYSTEM_INDICATORS_IREADY_ONLY_WINDOW_H_
 #define QUANTSYSTEM_INDICATORS_IREADY_ONLY_WINDOW_H_
 
+#include "quantsystem/common/base/integral_types.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -30,19 +31,36 @@ namespace indicators {
 template <typename T>
 class IReadOnlyWindow {
  public:
-  int size() const { return size_; }
+  virtual ~IReadOnlyWindow() {
+  }
 
-  int count() const { return count_; }
+  /**
+   * Gets the size of this window.
+   */
+  virtual int size() const = 0;
+
+  /**
+   * Gets the current number of elements in this window.
+   */
+  virtual int count() const = 0;
 
-  double smaples() const { return samples_; }
+  /**
+   * Gets the number of samples that have been added to this window
+   * over its lifetime.
+   */
+  virtual int64 samples() const = 0;
 
-  bool is_ready() const { return is_ready_; }
+  /**
+   * Gets a value indicating whether or not this window is ready, i.e,
+   * it has been filled to its capacity and one has fallen off the back.
+   */
+  virtual bool is_ready() const = 0;
 
   /**
    * Gets the most recently removed item from the window. This is the piece
    * of data that just 'fell off' as a result of the most recent add.
    */
-  T most_recently_removed() const { return most_recently_removed_; }
+  virtual T most_recently_removed() const = 0;
 
   /**
    * Indexes into this window, where index 0 is the most recently entered value.
@@ -50,18 +68,6 @@ class IReadOnlyWindow {
    * @return The ith most recent entry
    */
   virtual T operator[] (int i) const = 0;
-
- private:
-  // The size of this window
-  int size_;
-  // The current number of elements in this window
-  int count_;
-  // The number of samples that have been added to this window over its lifetime
-  double samples_;
-  // Indicating whether or not this window is ready
-  bool is_ready_;
-  // The most recently removed item from the window
-  T most_recently_removed_;
 };
 
 }  // namespace indicators
@@ -0,0 +1,92 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/linear_regression_slope.h"
+namespace quantsystem {
+namespace indicators {
+LinearRegressionSlope::LinearRegressionSlope(const string& name, int period)
+    : WindowIndicator<IndicatorSample>(name, period),
+      resum_interval_(period > kMinResumInterval ? period
+                                                 : kMinResumInterval),
+      replacements_(0),
+      sum_(0),
+      weighted_sum_(0) {
+}
+
+LinearRegressionSlope::LinearRegressionSlope(int period)
+    : WindowIndicator<IndicatorSample>("LRS" + to_string(period), period),
+      resum_interval_(period > kMinResumInterval ? period
+                                                 : kMinResumInterval),
+      replacements_(0),
+      sum_(0),
+      weighted_sum_(0) {
+}
+
+void LinearRegressionSlope::Reset() {
+  WindowIndicator<IndicatorSample>::Reset();
+  replacements_ = 0;
+  sum_ = 0;
+  weighted_sum_ = 0;
+}
+
+double LinearRegressionSlope::ComputeNextValue(
+    IReadOnlyWindow<IndicatorSample>* window,
+    const IndicatorSample& input) {
+  const int count = window->count();
+  if (window->is_ready()) {
+    const double removed = window->most_recently_removed().value;
+    weighted_sum_ += (count - 1) * input.value - (sum_ - removed);
+    sum_ += input.value - removed;
+    if (++replacements_ >= resum_interval_) {
+      Resum();
+    }
+  } else {
+    weighted_sum_ += (count - 1) * input.value;
+    sum_ += input.value;
+  }
+  if (count < 2) {
+    return 0;
+  }
+  // Sums of the positions 0..count-1 and of their squares
+  const double n = count;
+  const double sum_x = n * (n - 1) / 2;
+  const double sum_xx = (n - 1) * n * (2 * n - 1) / 6;
+  return (n * weighted_sum_ - sum_x * sum_) / (n * sum_xx - sum_x * sum_x);
+}
+
+void LinearRegressionSlope::Resum() {
+  RollingWindow<IndicatorSample>::Span spans[2];
+  window().GetSpans(&spans[0], &spans[1]);
+  double sum = 0, weighted_sum = 0;
+  int position = 0;
+  for (int s = 0; s < 2; ++s) {
+    for (int i = 0; i < spans[s].size; ++i, ++position) {
+      sum += spans[s].data[i].value;
+      weighted_sum += position * spans[s].data[i].value;
+    }
+  }
+  sum_ = sum;
+  weighted_sum_ = weighted_sum;
+  replacements_ = 0;
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,88 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_LINEAR_REGRESSION_SLOPE_H_
+#define QUANTSYSTEM_INDICATORS_LINEAR_REGRESSION_SLOPE_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/window_indicator.h"
+#include "quantsystem/indicators/iread_only_window.h"
+#include "quantsystem/indicators/indicator_sample.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Least squares slope of the samples over a rolling period, per sample.
+ *
+ * The samples are regressed on their position in the window, 0 for the
+ * oldest. The sum of the samples and the sum of the samples weighted by
+ * their position are updated in O(1) when the window slides, since
+ * every remaining sample moves one position down, and both sums are
+ * recomputed from the window at regular intervals to stop rounding
+ * drift.
+ * @ingroup IndicatorsLayer
+ */
+class LinearRegressionSlope : public WindowIndicator<IndicatorSample> {
+ public:
+  /**
+   * Initializes a new instance of the LinearRegressionSlope class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the regression
+   */
+  LinearRegressionSlope(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the LinearRegressionSlope class with
+   * the default name and period.
+   * @param period The period of the regression
+   */
+  explicit LinearRegressionSlope(int period);
+
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
+ protected:
+  /**
+   * Computes the next value for this indicator from the given state.
+   * @param[out] window The window of data held in this indicator
+   * @param input The input value to this indicator on this time step
+   * @return A new value for this indicator
+   */
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
+
+ private:
+  static const int kMinResumInterval = 1024;
+  int resum_interval_;
+  int replacements_;
+  double sum_;  // Sum of the samples
+  double weighted_sum_;  // Sum of the samples times their position
+
+  /**
+   * Recompute both sums from the samples of the window.
+   */
+  void Resum();
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_LINEAR_REGRESSION_SLOPE_H_
@@ -23,21 +23,27 @@ using std::to_string;
 namespace quantsystem {
 namespace indicators {
 Maximum::Maximum(int period)
-    : WindowIndicator("Max" + to_string(period), period) {
+    : Indicator("Max" + to_string(period)),
+      periods_since_maximum_(0),
+      extremes_(period) {
 }
 
 Maximum::Maximum(const string& name, int period)
-    : WindowIndicator(name, period) {
+    : Indicator(name),
+      periods_since_maximum_(0),
+      extremes_(period) {
 }
 
-double Maximum::ComputeNextValue(
-    IReadOnlyWindow<IndicatorDataPoint>* window,
-    const IndicatorDataPoint& input) {
+double Maximum::ComputeNextValue(const IndicatorSample& input) {
+  extremes_.Add(input.value);
+  periods_since_maximum_ = extremes_.periods_since();
+  return extremes_.value();
 }
 
 void Maximum::Reset() {
   periods_since_maximum_ = 0;
-  WindowIndicator::Reset();
+  extremes_.Reset();
+  Indicator::Reset();
 }
 }  // namespace indicators
 }  // namespace quantsystem
@@ -0,0 +1,53 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_MEDIAN_H_
+#define QUANTSYSTEM_INDICATORS_MEDIAN_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/quantile.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Median of the samples over a rolling period, the mean of the two
+ * middle samples when the window holds an even number of samples.
+ * @ingroup IndicatorsLayer
+ */
+class Median : public Quantile {
+ public:
+  /**
+   * Initializes a new instance of the Median class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the median
+   */
+  Median(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the Median class with
+   * the default name and period.
+   * @param period The period of the median
+   */
+  explicit Median(int period);
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_MEDIAN_H_
@@ -23,21 +23,27 @@ using std::to_string;
 namespace quantsystem {
 namespace indicators {
 Minimum::Minimum(int period)
-    : WindowIndicator("Min" + to_string(period), period) {
+    : Indicator("Min" + to_string(period)),
+      periods_since_minimum_(0),
+      extremes_(period) {
 }
 
 Minimum::Minimum(const string& name, int period)
-    : WindowIndicator(name, period) {
+    : Indicator(name),
+      periods_since_minimum_(0),
+      extremes_(period) {
 }
 
-double Minimum::ComputeNextValue(
-    IReadOnlyWindow<IndicatorDataPoint>* window,
-    const IndicatorDataPoint& input) {
+double Minimum::ComputeNextValue(const IndicatorSample& input) {
+  extremes_.Add(input.value);
+  periods_since_minimum_ = extremes_.periods_since();
+  return extremes_.value();
 }
 
 void Minimum::Reset() {
   periods_since_minimum_ = 0;
-  WindowIndicator::Reset();
+  extremes_.Reset();
+  Indicator::Reset();
 }
 }  // namespace indicators
 }  // namespace quantsystem
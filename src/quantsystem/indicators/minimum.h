@@ -22,9 +22,9 @@
 
 #include <string>
 using std::string;
-#include "quantsystem/indicators/window_indicator.h"
-#include "quantsystem/indicators/iread_only_window.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/monotonic_deque.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -32,7 +32,7 @@ namespace indicators {
  * and how many periods ago it occurred.
  * @ingroup IndicatorsLayer
  */
-class Minimum : public WindowIndicator<IndicatorDataPoint> {
+class Minimum : public Indicator {
  public:
   /**
    * Creates a new Minimum indicator with the specified period.
@@ -55,10 +55,17 @@ class Minimum : public WindowIndicator<IndicatorDataPoint> {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return samples() >= period();
   }
 
+  /**
+   * Gets the period over which this indicator looks back.
+   */
+  int period() const {
+    return extremes_.period();
+  }
+
   int periods_since_minimum() const {
     return periods_since_minimum_;
   }
@@ -69,13 +76,13 @@ class Minimum : public WindowIndicator<IndicatorDataPoint> {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(
-      IReadOnlyWindow<IndicatorDataPoint>* window,
-      const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(const IndicatorSample& input);
 
  private:
   // The number of periods since the minimum value was encountered
   int periods_since_minimum_;
+  // Candidates for the minimum of the window
+  MinimumDeque extremes_;
 
   void set_periods_since_minimum(int periods_since_minimum) {
     periods_since_minimum_ = periods_since_minimum;
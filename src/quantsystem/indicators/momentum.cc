@@ -30,13 +30,13 @@ Momentum::Momentum(const string& name, int period)
     : WindowIndicator(name, period) {
 }
 
-double Momentum::ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                                  IndicatorDataPoint input) {
+double Momentum::ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input) {
   if (!window->is_ready()) {
     // keep returning the delta from the first item put in there to init
-    return input.value() - (*window)[window->count() - 1].value();
+    return input.value - (*window)[window->count() - 1].value;
   }
-  return input.value() - window->most_recently_removed().value();
+  return input.value - window->most_recently_removed().value;
 }
 }  // namespace indicators
 }  // namespace quantsystem
@@ -22,7 +22,7 @@
 
 #include <string>
 using std::string;
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/iread_only_window.h"
 #include "quantsystem/indicators/window_indicator.h"
 namespace quantsystem {
@@ -32,7 +32,7 @@ namespace indicators {
  * value_0 - value_n
  * @ingroup IndicatorsLayer
  */
-class Momentum : public WindowIndicator<IndicatorDataPoint> {
+class Momentum : public WindowIndicator<IndicatorSample> {
  public:
   /**
    * Creates a new Momentum indicator with the specified period.
@@ -54,8 +54,8 @@ class Momentum : public WindowIndicator<IndicatorDataPoint> {
    * @param input The input value to this indicator on this time step
    * @return A new value for this indicator
    */
-  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                                  IndicatorDataPoint input);
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
 };
 
 }  // namespace indicators
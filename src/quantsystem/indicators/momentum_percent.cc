@@ -33,8 +33,8 @@ MomentumPercent::MomentumPercent(const string& name, int period)
 }
 
 double MomentumPercent::ComputeNextValue(
-    IReadOnlyWindow<IndicatorDataPoint>* window,
-    IndicatorDataPoint input) {
+    IReadOnlyWindow<IndicatorSample>* window,
+    const IndicatorSample& input) {
   average_->Update(input);
   double absolute_change = Momentum::ComputeNextValue(window, input);
   if (average_->value() == 0) {
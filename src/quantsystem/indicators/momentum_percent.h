@@ -25,7 +25,7 @@ using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
 #include "quantsystem/indicators/iread_only_window.h"
 #include "quantsystem/indicators/window_indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/simple_moving_average.h"
 #include "quantsystem/indicators/momentum.h"
 namespace quantsystem {
@@ -70,8 +70,8 @@ class MomentumPercent : public Momentum {
    * @param input The input value to this indicator on this time step
    * @return A new value for this indicator
    */
-  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                                  IndicatorDataPoint input);
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
 
  private:
   // The average used in the denominator to scale the momentum
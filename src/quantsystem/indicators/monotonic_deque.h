@@ -0,0 +1,150 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_MONOTONIC_DEQUE_H_
+#define QUANTSYSTEM_INDICATORS_MONOTONIC_DEQUE_H_
+
+#include <functional>
+using std::greater_equal;
+using std::less_equal;
+#include <vector>
+using std::vector;
+#include <glog/logging.h>
+#include "quantsystem/common/base/integral_types.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Sliding window extreme (maximum or minimum) in amortized O(1).
+ *
+ * The deque holds the samples of the window which can still become the
+ * extreme, in order of arrival with monotonic values: a new sample
+ * removes every older sample it dominates from the back, and the
+ * sample at the front leaves once it is older than the period. Each
+ * sample is pushed and popped at most once, so a 252 period window
+ * costs the same per update as a 5 period one. The deque lives in a
+ * power-of-two ring buffer allocated at construction.
+ * @ingroup IndicatorsLayer
+ * @see Maximum
+ * @see Minimum
+ */
+template <typename Dominates>
+class MonotonicDeque {
+ public:
+  /**
+   * Initializes a new deque over the specified period.
+   * @param period The number of samples in the window
+   */
+  explicit MonotonicDeque(int period)
+      : period_(period > 0 ? period : 1),
+        head_(0),
+        tail_(0),
+        samples_(0) {
+    if (period < 1) {
+      LOG(ERROR) << "MonotonicDeque must have a period of at least 1: " <<
+          period;
+    }
+    uint32 capacity = 1;
+    while (capacity < static_cast<uint32>(period_)) {
+      capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    values_.resize(capacity);
+    indices_.resize(capacity);
+  }
+
+  /**
+   * Adds a sample and drops the one which left the window.
+   * @param value The new sample
+   */
+  void Add(double value) {
+    const int64 index = samples_++;
+    // Drop the front first so the deque never holds more than period_
+    if (tail_ != head_ && indices_[head_ & mask_] <= index - period_) {
+      ++head_;
+    }
+    while (tail_ != head_ && dominates_(value, values_[(tail_ - 1) & mask_])) {
+      --tail_;
+    }
+    values_[tail_ & mask_] = value;
+    indices_[tail_ & mask_] = index;
+    ++tail_;
+  }
+
+  /**
+   * Gets the extreme of the samples in the window.
+   */
+  double value() const {
+    DCHECK(samples_ > 0) << "No samples yet";
+    return values_[head_ & mask_];
+  }
+
+  /**
+   * Gets the number of samples added since the extreme, 0 when the
+   * most recent sample is the extreme.
+   */
+  int periods_since() const {
+    return static_cast<int>(samples_ - 1 - indices_[head_ & mask_]);
+  }
+
+  /**
+   * Gets the number of samples added over the lifetime of the deque.
+   */
+  int64 samples() const { return samples_; }
+
+  /**
+   * Gets the number of samples in the window.
+   */
+  int period() const { return period_; }
+
+  /**
+   * Clears the deque, the buffer is kept.
+   */
+  void Reset() {
+    head_ = 0;
+    tail_ = 0;
+    samples_ = 0;
+  }
+
+ private:
+  Dominates dominates_;
+  // Candidate values and their sample index, in ring buffers
+  vector<double> values_;
+  vector<int64> indices_;
+  uint32 mask_;
+  int period_;
+  // Front and back (one past) of the deque, wrapped with mask_
+  uint32 head_;
+  uint32 tail_;
+  int64 samples_;
+};
+
+/**
+ * Deque whose front is the maximum: a new sample at least as large
+ * replaces older ones, so ties report the most recent sample.
+ */
+typedef MonotonicDeque<greater_equal<double> > MaximumDeque;
+
+/**
+ * Deque whose front is the minimum: a new sample at most as small
+ * replaces older ones, so ties report the most recent sample.
+ */
+typedef MonotonicDeque<less_equal<double> > MinimumDeque;
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_MONOTONIC_DEQUE_H_
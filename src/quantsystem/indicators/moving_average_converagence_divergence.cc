@@ -43,31 +43,47 @@ MovingAverageConvergenceDivergence::MovingAverageConvergenceDivergence(
   Init(name, fast_period, slow_period, signal_period, type);
 }
 
+MovingAverageConvergenceDivergence::MovingAverageConvergenceDivergence(
+    const string& name,
+    IndicatorAverageType* fast,
+    IndicatorAverageType* slow,
+    int signal_period,
+    MovingAverageType type)
+    : Indicator(name),
+      fast_(fast),
+      slow_(slow) {
+  signal_.reset(ToIndicator(type, name + "_Signal", signal_period));
+}
+
 void MovingAverageConvergenceDivergence::Init(
     const string& name,
     int fast_period, int slow_period,
     int signal_period,
     MovingAverageType type) {
-  fast_.reset(ToIndicator(type, name + "_Fast", fast_period));
-  slow_.reset(ToIndicator(type, name + "_Slow", slow_period));
+  set_fast(ToIndicator(type, name + "_Fast", fast_period));
+  set_slow(ToIndicator(type, name + "_Slow", slow_period));
   signal_.reset(ToIndicator(type, name + "_Signal", signal_period));
 }
 
 void MovingAverageConvergenceDivergence::Reset() {
-  fast_->Reset();
-  slow_->Reset();
+  if (owned_fast_ != NULL) {
+    fast_->Reset();
+    slow_->Reset();
+  }
   signal_->Reset();
   Indicator::Reset();
 }
 
 double MovingAverageConvergenceDivergence::ComputeNextValue(
-    const IndicatorDataPoint& input) {
-  fast_->Update(input);
-  slow_->Update(input);
-  int macd = fast_->value() - slow_->value();
+    const IndicatorSample& input) {
+  // Shared averages are updated by their owner
+  if (owned_fast_ != NULL) {
+    fast_->Update(input);
+    slow_->Update(input);
+  }
+  double macd = fast_->value() - slow_->value();
   if (fast_->is_ready() && slow_->is_ready()) {
-    IndicatorDataPoint new_input(input.time(), macd);
-    signal_->Update(new_input);
+    signal_->Update(MakeIndicatorSample(input.time, macd));
   }
   return macd;
 }
@@ -24,7 +24,7 @@
 using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
 #include "quantsystem/indicators/indicator.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/moving_average_type.h"
 #include "quantsystem/indicators/indicator_base.h"
 namespace quantsystem {
@@ -36,7 +36,7 @@ namespace indicators {
  */
 class MovingAverageConvergenceDivergence : public Indicator {
  public:
-  typedef IndicatorBase<IndicatorDataPoint> IndicatorAverageType;
+  typedef IndicatorBase<IndicatorSample> IndicatorAverageType;
   /**
    * Creates a new MACD with the specified parameters.
    * @param fast_period The fast moving average period
@@ -61,6 +61,22 @@ class MovingAverageConvergenceDivergence : public Indicator {
                                      int signal_period,
                                      MovingAverageType type = kSimple);
 
+  /**
+   * Creates a new MACD over shared fast and slow averages, e.g. nodes
+   * of an IndicatorGraph. The averages are not owned and not updated by
+   * this indicator: they must receive the same input before it.
+   * @param name The name of this indicator
+   * @param fast The fast moving average
+   * @param slow The slow moving average
+   * @param signal_period The signal period
+   * @param type The type of moving average to use for the signal
+   */
+  MovingAverageConvergenceDivergence(const string& name,
+                                     IndicatorAverageType* fast,
+                                     IndicatorAverageType* slow,
+                                     int signal_period,
+                                     MovingAverageType type = kSimple);
+
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
@@ -73,9 +89,9 @@ class MovingAverageConvergenceDivergence : public Indicator {
    */
   virtual void Reset();
 
-  IndicatorAverageType* fast() const { return fast_.get();}
+  IndicatorAverageType* fast() const { return fast_; }
 
-  IndicatorAverageType* slow() const { return slow_.get(); }
+  IndicatorAverageType* slow() const { return slow_; }
 
   IndicatorAverageType* signal() const { return signal_.get(); }
 
@@ -85,22 +101,27 @@ class MovingAverageConvergenceDivergence : public Indicator {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(const IndicatorSample& input);
 
  private:
   // The fast average indicator
-  scoped_ptr<IndicatorAverageType> fast_;
+  IndicatorAverageType* fast_;
   // The slow average indicator
-  scoped_ptr<IndicatorAverageType> slow_;
+  IndicatorAverageType* slow_;
+  // Own the averages, NULL when they are shared
+  scoped_ptr<IndicatorAverageType> owned_fast_;
+  scoped_ptr<IndicatorAverageType> owned_slow_;
   // The signal of the MACD
   scoped_ptr<IndicatorAverageType> signal_;
 
   void set_fast(IndicatorAverageType* fast) {
-    fast_.reset(fast);
+    owned_fast_.reset(fast);
+    fast_ = fast;
   }
 
   void set_slow(IndicatorAverageType* slow) {
-    slow_.reset(slow);
+    owned_slow_.reset(slow);
+    slow_ = slow;
   }
 
   void set_signal(IndicatorAverageType* signal) {
@@ -23,7 +23,7 @@
 #include "quantsystem/indicators/exponential_indicator.h"
 namespace quantsystem {
 namespace indicators {
-IndicatorBase<IndicatorDataPoint>* ToIndicator(
+IndicatorBase<IndicatorSample>* ToIndicator(
     MovingAverageType moving_average_type,
     int period) {
   switch (moving_average_type) {
@@ -40,7 +40,7 @@ IndicatorBase<IndicatorDataPoint>* ToIndicator(
   }
 }
 
-IndicatorBase<IndicatorDataPoint>* ToIndicator(
+IndicatorBase<IndicatorSample>* ToIndicator(
     MovingAverageType moving_average_type,
     const string& name,
     int period) {
@@ -24,7 +24,7 @@
 using std::string;
 #include "quantsystem/indicators/moving_average_type.h"
 #include "quantsystem/indicators/indicator_base.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 namespace quantsystem {
 namespace indicators {
 /**
@@ -39,7 +39,7 @@ namespace indicators {
  * @param period The smoothing period
  * @return A new indicator that matches the MovingAverageType
  */
-IndicatorBase<IndicatorDataPoint>* ToIndicator(
+IndicatorBase<IndicatorSample>* ToIndicator(
     MovingAverageType moving_average_type,
     int period);
 
@@ -52,7 +52,7 @@ IndicatorBase<IndicatorDataPoint>* ToIndicator(
  * @param period The smoothing period
  * @return A new indicator that matches the MovingAverageType
  */
-IndicatorBase<IndicatorDataPoint>* ToIndicator(
+IndicatorBase<IndicatorSample>* ToIndicator(
     MovingAverageType moving_average_type,
     const string& name,
     int period);
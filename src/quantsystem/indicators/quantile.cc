@@ -0,0 +1,55 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/quantile.h"
+namespace quantsystem {
+namespace indicators {
+Quantile::Quantile(const string& name, int period, double quantile)
+    : WindowIndicator<IndicatorSample>(name, period),
+      samples_(quantile) {
+}
+
+Quantile::Quantile(int period, double quantile)
+    : WindowIndicator<IndicatorSample>(
+          "QUANTILE" + to_string(period) + "_" +
+          to_string(static_cast<int>(std::floor(quantile * 100 + 0.5))),
+          period),
+      samples_(quantile) {
+}
+
+void Quantile::Reset() {
+  WindowIndicator<IndicatorSample>::Reset();
+  samples_.Reset();
+}
+
+double Quantile::ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input) {
+  if (window->is_ready()) {
+    samples_.Replace(window->most_recently_removed().value, input.value);
+  } else {
+    samples_.Add(input.value);
+  }
+  return samples_.Value();
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,84 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_QUANTILE_H_
+#define QUANTSYSTEM_INDICATORS_QUANTILE_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/window_indicator.h"
+#include "quantsystem/indicators/iread_only_window.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/rolling_quantile.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Quantile of the samples over a rolling period, linearly interpolated
+ * between the two closest samples.
+ *
+ * The samples are kept ordered by RollingQuantile, so an update costs
+ * O(log period) and long lookbacks stay cheap.
+ * @ingroup IndicatorsLayer
+ */
+class Quantile : public WindowIndicator<IndicatorSample> {
+ public:
+  /**
+   * Initializes a new instance of the Quantile class
+   * with the specified name, period and quantile.
+   * @param name The name of this indicator
+   * @param period The period of the quantile
+   * @param quantile The quantile, between 0 and 1
+   */
+  Quantile(const string& name, int period, double quantile);
+
+  /**
+   * Initializes a new instance of the Quantile class with
+   * the default name.
+   * @param period The period of the quantile
+   * @param quantile The quantile, between 0 and 1
+   */
+  Quantile(int period, double quantile);
+
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
+  /**
+   * Gets the quantile computed by this indicator.
+   */
+  double quantile() const { return samples_.quantile(); }
+
+ protected:
+  /**
+   * Computes the next value for this indicator from the given state.
+   * @param[out] window The window of data held in this indicator
+   * @param input The input value to this indicator on this time step
+   * @return A new value for this indicator
+   */
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
+
+ private:
+  RollingQuantile samples_;
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_QUANTILE_H_
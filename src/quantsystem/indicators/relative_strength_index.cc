@@ -53,7 +53,23 @@ void RelativeStrengthIndex::Reset() {
 }
 
 double RelativeStrengthIndex::ComputeNextValue(
-    const IndicatorDataPoint& input) {
+    const IndicatorSample& input) {
+  if (samples() > 1) {
+    double change = input.value - previous_input_.value;
+    if (change >= 0) {
+      average_gain_->Update(MakeIndicatorSample(input.time, change));
+      average_loss_->Update(MakeIndicatorSample(input.time, 0));
+    } else {
+      average_gain_->Update(MakeIndicatorSample(input.time, 0));
+      average_loss_->Update(MakeIndicatorSample(input.time, -change));
+    }
+  }
+  previous_input_ = input;
+  if (average_loss_->value() == 0) {
+    return 100;
+  }
+  double rs = average_gain_->value() / average_loss_->value();
+  return 100 - (100 / (1 + rs));
 }
 
 }  // namespace indicators
@@ -25,7 +25,7 @@ using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
 #include "quantsystem/indicators/indicator.h"
 #include "quantsystem/indicators/indicator_base.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/moving_average_type.h"
 namespace quantsystem {
 namespace indicators {
@@ -37,7 +37,7 @@ namespace indicators {
  */
 class RelativeStrengthIndex : public Indicator {
  public:
-    typedef IndicatorBase<IndicatorDataPoint> IndicatorType;
+    typedef IndicatorBase<IndicatorSample> IndicatorType;
   /**
    * Initializes a new instance of the RelativeStrengthIndex class
    * with the specified name and period.
@@ -90,10 +90,10 @@ class RelativeStrengthIndex : public Indicator {
    * @param input The input given to the indicator.
    * @return A new value for this indicator.
    */
-  virtual double ComputeNextValue(const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(const IndicatorSample& input);
 
  private:
-  IndicatorDataPoint previous_input_;
+  IndicatorSample previous_input_;
   // The type of indicator used to compute AverageGain and AverageLoss
   MovingAverageType moving_average_type_;
   scoped_ptr<IndicatorType> average_loss_;
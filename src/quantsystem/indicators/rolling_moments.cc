@@ -0,0 +1,104 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include "quantsystem/indicators/rolling_moments.h"
+namespace quantsystem {
+namespace indicators {
+RollingMoments::RollingMoments(int period)
+    : resum_interval_(period > kMinResumInterval ? period
+                                                 : kMinResumInterval) {
+  Reset();
+}
+
+void RollingMoments::Resum(const RollingWindow<IndicatorSample>& window) {
+  RollingWindow<IndicatorSample>::Span spans[2];
+  window.GetSpans(&spans[0], &spans[1]);
+  double sum = 0;
+  for (int s = 0; s < 2; ++s) {
+    for (int i = 0; i < spans[s].size; ++i) {
+      sum += spans[s].data[i].value;
+    }
+  }
+  count_ = spans[0].size + spans[1].size;
+  mean_ = count_ > 0 ? sum / count_ : 0;
+  double m2 = 0;
+  for (int s = 0; s < 2; ++s) {
+    for (int i = 0; i < spans[s].size; ++i) {
+      const double delta = spans[s].data[i].value - mean_;
+      m2 += delta * delta;
+    }
+  }
+  m2_ = m2;
+  replacements_ = 0;
+}
+
+void RollingMoments::Reset() {
+  replacements_ = 0;
+  count_ = 0;
+  mean_ = 0;
+  m2_ = 0;
+}
+
+RollingComoments::RollingComoments(int period)
+    : resum_interval_(period > kMinResumInterval ? period
+                                                 : kMinResumInterval) {
+  Reset();
+}
+
+void RollingComoments::Resum(
+    const RollingWindow<IndicatorPairSample>& window) {
+  RollingWindow<IndicatorPairSample>::Span spans[2];
+  window.GetSpans(&spans[0], &spans[1]);
+  double sum_x = 0, sum_y = 0;
+  for (int s = 0; s < 2; ++s) {
+    for (int i = 0; i < spans[s].size; ++i) {
+      sum_x += spans[s].data[i].x;
+      sum_y += spans[s].data[i].y;
+    }
+  }
+  count_ = spans[0].size + spans[1].size;
+  mean_x_ = count_ > 0 ? sum_x / count_ : 0;
+  mean_y_ = count_ > 0 ? sum_y / count_ : 0;
+  double m2_x = 0, m2_y = 0, c_xy = 0;
+  for (int s = 0; s < 2; ++s) {
+    for (int i = 0; i < spans[s].size; ++i) {
+      const double delta_x = spans[s].data[i].x - mean_x_;
+      const double delta_y = spans[s].data[i].y - mean_y_;
+      m2_x += delta_x * delta_x;
+      m2_y += delta_y * delta_y;
+      c_xy += delta_x * delta_y;
+    }
+  }
+  m2_x_ = m2_x;
+  m2_y_ = m2_y;
+  c_xy_ = c_xy;
+  replacements_ = 0;
+}
+
+void RollingComoments::Reset() {
+  replacements_ = 0;
+  count_ = 0;
+  mean_x_ = 0;
+  mean_y_ = 0;
+  m2_x_ = 0;
+  m2_y_ = 0;
+  c_xy_ = 0;
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,214 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_ROLLING_MOMENTS_H_
+#define QUANTSYSTEM_INDICATORS_ROLLING_MOMENTS_H_
+
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/rolling_window.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Mean and sum of squared deviations of a sliding window in O(1).
+ *
+ * The moments follow Welford's update while the window fills, and a
+ * full window replaces its oldest sample in a single update instead of
+ * rescanning the period. Rounding errors of the running updates are
+ * bounded by recomputing the moments in two passes over the window
+ * every resum_interval() replacements, at least as many as the period
+ * so the rescan costs at most one sample per update.
+ * @ingroup IndicatorsLayer
+ * @see Variance
+ */
+class RollingMoments {
+ public:
+  /**
+   * Initializes empty moments for a window of the specified period.
+   * @param period The number of samples in the window
+   */
+  explicit RollingMoments(int period);
+
+  /**
+   * Add a sample to a window which is not full yet.
+   */
+  void Add(double x) {
+    ++count_;
+    const double delta = x - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (x - mean_);
+  }
+
+  /**
+   * Replace the oldest sample of a full window with a new one.
+   * @param removed The sample which fell off the window
+   * @param x The new sample
+   */
+  void Replace(double removed, double x) {
+    const double mean = mean_ + (x - removed) / count_;
+    m2_ += (x - mean_) * (x - mean) - (removed - mean_) * (removed - mean);
+    mean_ = mean;
+    if (m2_ < 0) {
+      m2_ = 0;
+    }
+    ++replacements_;
+  }
+
+  /**
+   * True when the running moments are due to be recomputed.
+   */
+  bool needs_resum() const { return replacements_ >= resum_interval_; }
+
+  /**
+   * Recompute the moments from the samples of the window.
+   */
+  void Resum(const RollingWindow<IndicatorSample>& window);
+
+  /**
+   * Clear the moments.
+   */
+  void Reset();
+
+  int count() const { return count_; }
+  double mean() const { return mean_; }
+
+  /**
+   * Sum of the squared deviations from the mean.
+   */
+  double m2() const { return m2_; }
+
+  /**
+   * Population variance of the window.
+   */
+  double variance() const { return count_ > 0 ? m2_ / count_ : 0; }
+
+  int resum_interval() const { return resum_interval_; }
+
+ private:
+  static const int kMinResumInterval = 1024;
+  int resum_interval_;
+  int replacements_;
+  int count_;
+  double mean_;
+  double m2_;
+};
+
+/**
+ * Means, squared deviations and co-deviation of a sliding window of
+ * paired samples in O(1), with the same update and resum scheme as
+ * RollingMoments.
+ * @ingroup IndicatorsLayer
+ * @see Covariance
+ */
+class RollingComoments {
+ public:
+  /**
+   * Initializes empty comoments for a window of the specified period.
+   * @param period The number of samples in the window
+   */
+  explicit RollingComoments(int period);
+
+  /**
+   * Add a sample to a window which is not full yet.
+   */
+  void Add(double x, double y) {
+    ++count_;
+    const double delta_x = x - mean_x_;
+    const double delta_y = y - mean_y_;
+    mean_x_ += delta_x / count_;
+    mean_y_ += delta_y / count_;
+    m2_x_ += delta_x * (x - mean_x_);
+    m2_y_ += delta_y * (y - mean_y_);
+    c_xy_ += delta_x * (y - mean_y_);
+  }
+
+  /**
+   * Replace the oldest sample of a full window with a new one.
+   * @param removed_x First value of the sample which fell off
+   * @param removed_y Second value of the sample which fell off
+   * @param x First value of the new sample
+   * @param y Second value of the new sample
+   */
+  void Replace(double removed_x, double removed_y, double x, double y) {
+    const double mean_x = mean_x_ + (x - removed_x) / count_;
+    const double mean_y = mean_y_ + (y - removed_y) / count_;
+    m2_x_ += (x - mean_x_) * (x - mean_x) -
+        (removed_x - mean_x_) * (removed_x - mean_x);
+    m2_y_ += (y - mean_y_) * (y - mean_y) -
+        (removed_y - mean_y_) * (removed_y - mean_y);
+    c_xy_ += (x - mean_x_) * (y - mean_y) -
+        (removed_x - mean_x_) * (removed_y - mean_y);
+    mean_x_ = mean_x;
+    mean_y_ = mean_y;
+    if (m2_x_ < 0) {
+      m2_x_ = 0;
+    }
+    if (m2_y_ < 0) {
+      m2_y_ = 0;
+    }
+    ++replacements_;
+  }
+
+  /**
+   * True when the running moments are due to be recomputed.
+   */
+  bool needs_resum() const { return replacements_ >= resum_interval_; }
+
+  /**
+   * Recompute the comoments from the samples of the window.
+   */
+  void Resum(const RollingWindow<IndicatorPairSample>& window);
+
+  /**
+   * Clear the comoments.
+   */
+  void Reset();
+
+  int count() const { return count_; }
+  double mean_x() const { return mean_x_; }
+  double mean_y() const { return mean_y_; }
+
+  /**
+   * Sum of the squared deviations of x from its mean.
+   */
+  double m2_x() const { return m2_x_; }
+
+  /**
+   * Sum of the squared deviations of y from its mean.
+   */
+  double m2_y() const { return m2_y_; }
+
+  /**
+   * Sum of the products of the deviations of x and y.
+   */
+  double c_xy() const { return c_xy_; }
+
+ private:
+  static const int kMinResumInterval = 1024;
+  int resum_interval_;
+  int replacements_;
+  int count_;
+  double mean_x_;
+  double mean_y_;
+  double m2_x_;
+  double m2_y_;
+  double c_xy_;
+};
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_ROLLING_MOMENTS_H_
@@ -0,0 +1,96 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <glog/logging.h>
+#include <cmath>
+#include "quantsystem/indicators/rolling_quantile.h"
+namespace quantsystem {
+namespace indicators {
+RollingQuantile::RollingQuantile(double quantile)
+    : quantile_(quantile) {
+  if (!(quantile >= 0 && quantile <= 1)) {
+    LOG(ERROR) << "Quantile must be between 0 and 1: " << quantile;
+    quantile_ = quantile > 1 ? 1 : 0;
+  }
+}
+
+void RollingQuantile::Add(double x) {
+  if (lower_.empty() || x <= *lower_.rbegin()) {
+    lower_.insert(x);
+  } else {
+    upper_.insert(x);
+  }
+  Balance();
+}
+
+void RollingQuantile::Remove(double x) {
+  // Every sample of upper is at least the largest sample of lower, so a
+  // sample up to that bound is held by lower.
+  if (!lower_.empty() && x <= *lower_.rbegin()) {
+    multiset<double>::iterator found = lower_.find(x);
+    if (found != lower_.end()) {
+      lower_.erase(found);
+      Balance();
+      return;
+    }
+  }
+  multiset<double>::iterator found = upper_.find(x);
+  if (found == upper_.end()) {
+    LOG(ERROR) << "Sample is not in the window: " << x;
+    return;
+  }
+  upper_.erase(found);
+  Balance();
+}
+
+void RollingQuantile::Balance() {
+  const int count = this->count();
+  const size_t target = count > 0 ?
+      static_cast<size_t>(std::floor(quantile_ * (count - 1))) + 1 : 0;
+  while (lower_.size() > target) {
+    multiset<double>::iterator largest = --lower_.end();
+    upper_.insert(upper_.begin(), *largest);
+    lower_.erase(largest);
+  }
+  while (lower_.size() < target) {
+    multiset<double>::iterator smallest = upper_.begin();
+    lower_.insert(lower_.end(), *smallest);
+    upper_.erase(smallest);
+  }
+}
+
+double RollingQuantile::Value() const {
+  if (lower_.empty()) {
+    return 0;
+  }
+  const double position = quantile_ * (count() - 1);
+  const double fraction = position - std::floor(position);
+  const double below = *lower_.rbegin();
+  if (fraction == 0 || upper_.empty()) {
+    return below;
+  }
+  return below + fraction * (*upper_.begin() - below);
+}
+
+void RollingQuantile::Reset() {
+  lower_.clear();
+  upper_.clear();
+}
+}  // namespace indicators
+}  // namespace quantsystem
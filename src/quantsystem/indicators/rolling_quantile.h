@@ -0,0 +1,98 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_ROLLING_QUANTILE_H_
+#define QUANTSYSTEM_INDICATORS_ROLLING_QUANTILE_H_
+
+#include <set>
+using std::multiset;
+#include "quantsystem/common/base/macros.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Quantile of a sliding window with O(log n) updates and O(1) queries.
+ *
+ * The samples are split between two ordered trees: lower holds the
+ * floor(quantile * (n - 1)) + 1 smallest samples and upper the rest, so
+ * the order statistics around the quantile are the largest sample of
+ * lower and the smallest sample of upper. Adding or removing a sample
+ * inserts or erases it in one tree and moves at most one sample across
+ * to restore the split. The quantile is linearly interpolated between
+ * the two order statistics.
+ * @ingroup IndicatorsLayer
+ * @see Quantile
+ */
+class RollingQuantile {
+ public:
+  /**
+   * Initializes an empty window for the specified quantile.
+   * @param quantile The quantile, between 0 and 1
+   */
+  explicit RollingQuantile(double quantile);
+
+  /**
+   * Add a sample to the window.
+   */
+  void Add(double x);
+
+  /**
+   * Remove a sample which was added to the window.
+   */
+  void Remove(double x);
+
+  /**
+   * Replace a sample of the window with a new one.
+   * @param removed The sample which fell off the window
+   * @param x The new sample
+   */
+  void Replace(double removed, double x) {
+    Remove(removed);
+    Add(x);
+  }
+
+  /**
+   * The quantile of the samples in the window, 0 if it is empty.
+   */
+  double Value() const;
+
+  /**
+   * Remove every sample.
+   */
+  void Reset();
+
+  int count() const {
+    return static_cast<int>(lower_.size() + upper_.size());
+  }
+  double quantile() const { return quantile_; }
+
+ private:
+  double quantile_;
+  multiset<double> lower_;  // Samples up to the quantile
+  multiset<double> upper_;  // Samples above the quantile
+
+  /**
+   * Move samples between the trees until lower holds its share.
+   */
+  void Balance();
+
+  DISALLOW_COPY_AND_ASSIGN(RollingQuantile);
+};
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_ROLLING_QUANTILE_H_
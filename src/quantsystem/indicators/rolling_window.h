@@ -23,6 +23,7 @@
 #include <vector>
 using std::vector;
 #include <glog/logging.h>
+#include "quantsystem/common/base/integral_types.h"
 #include "quantsystem/indicators/iread_only_window.h"
 namespace quantsystem {
 namespace indicators {
@@ -30,48 +31,78 @@ namespace indicators {
  * This is a window that allows for list access semantics,
  * where this[0] refers to the most recent item in the
  * window and this[Count-1] refers to the last item in the window
+ *
+ * The items are held in a ring buffer whose capacity is the window
+ * size rounded up to a power of two, so an index is wrapped with a
+ * mask instead of a division, and nothing is allocated after
+ * construction. The items can be read in bulk, oldest first, through
+ * at most two contiguous spans of the buffer.
  * @ingroup IndicatorsLayer
  */
 template <typename T>
 class RollingWindow : public IReadOnlyWindow<T> {
  public:
+  /**
+   * A contiguous run of items in the buffer, oldest first.
+   */
+  class Span {
+   public:
+    const T* data;  // First item of the run
+    int size;  // Number of items in the run
+    Span() : data(NULL), size(0) {
+    }
+  };
+
   /**
    * Initializes a new instance of the RollwingWindow class
    * with the specified window size.
    * @param size The  number of items to hold in the window
    */
-  explicit RollingWindow(int size) {
+  explicit RollingWindow(int size)
+      : size_(size),
+        head_(0),
+        count_(0),
+        samples_(0) {
     const int kDefaultSize = 10;
     if (size < 1) {
       LOG(FATAL) << "RollingWindow must have size of at least 1." << size;
-      size = kDefaultSize;
+      size_ = kDefaultSize;
+    }
+    uint32 capacity = 1;
+    while (capacity < static_cast<uint32>(size_)) {
+      capacity <<= 1;
     }
-    list_.resize(size);
+    mask_ = capacity - 1;
+    buffer_.resize(capacity);
   }
 
   /**
    * Gets the size of this window.
    */
-  int Size() const {
-    return list_.size();
-  }
+  virtual int size() const { return size_; }
+
+  /**
+   * Gets the number of items the buffer can hold, the window size
+   * rounded up to a power of two.
+   */
+  int capacity() const { return static_cast<int>(mask_ + 1); }
 
   /**
    * Gets the current number of elements in this window
    */
-  int Count() const { return count_; }
+  virtual int count() const { return count_; }
 
   /**
    * Gets the number of samples that have been added to this window
    * over its lifetime.
    */
-  double samples() const { return samples_; }
+  virtual int64 samples() const { return samples_; }
 
   /**
    * Gets the most recently removed item from the window. This is the piece
    * of data that just 'fell off' as a result of the most recent add.
    */
-  T most_recently_removed() const {
+  virtual T most_recently_removed() const {
     if (!is_ready()) {
       LOG(FATAL) << "No items have been removed yet!";
     }
@@ -84,14 +115,24 @@ class RollingWindow : public IReadOnlyWindow<T> {
    * @return The ith most recent entry
    */
   virtual T operator[] (int i) const {
+    return at(i);
+  }
+
+  /**
+   * Reference to the ith most recent entry, without a copy.
+   * @param i The index, 0 is the most recent entry
+   */
+  const T& at(int i) const {
+    DCHECK(i >= 0 && i < count_) << "Index out of range: " << i;
+    return buffer_[(head_ - 1 - i) & mask_];
   }
 
   /**
    * Gets a value indicating whether or not this window is ready, i.e,
    * it has been filled to its capacity and one has fallen off the back.
    */
-  bool is_ready() const {
-    return samples() > Size();
+  virtual bool is_ready() const {
+    return samples_ > size_;
   }
 
   /**
@@ -99,27 +140,71 @@ class RollingWindow : public IReadOnlyWindow<T> {
    * @param item The item to be added.
    */
   void Add(const T& item) {
+    if (count_ == size_) {
+      most_recently_removed_ = buffer_[(head_ - size_) & mask_];
+    } else {
+      ++count_;
+    }
+    buffer_[head_ & mask_] = item;
+    ++head_;
+    ++samples_;
   }
 
   /**
-   * Clears this window of all data.
+   * Gets the items of the window, oldest first, as at most two
+   * contiguous spans of the buffer.
+   * @param first[out] Oldest items
+   * @param second[out] Newer items which wrapped to the start of the
+   * buffer, empty if the items do not wrap
+   */
+  void GetSpans(Span* first, Span* second) const {
+    const uint32 start = (head_ - count_) & mask_;
+    const int to_end = static_cast<int>(mask_ + 1 - start);
+    first->data = buffer_.data() + start;
+    first->size = count_ < to_end ? count_ : to_end;
+    second->data = buffer_.data();
+    second->size = count_ - first->size;
+  }
+
+  /**
+   * Copy the items of the window, oldest first.
+   * @param out[out] Array of at least count() items
+   */
+  void CopyTo(T* out) const {
+    Span first, second;
+    GetSpans(&first, &second);
+    for (int i = 0; i < first.size; ++i) {
+      out[i] = first.data[i];
+    }
+    for (int i = 0; i < second.size; ++i) {
+      out[first.size + i] = second.data[i];
+    }
+  }
+
+  /**
+   * Clears this window of all data. The buffer is kept.
    */
   void Reset() {
+    head_ = 0;
+    count_ = 0;
     samples_ = 0;
-    list_.clear();
   }
 
  private:
-  // The backing vector object used to hold the data
-  vector<T> list_;
-  // The most recently removed item from the window (fell off the back)
-  T most_recently_removed_;
-  // The total number of samples taken by this indicator
-  double samples_;
-  // Used to locate the last item in the window as an indexer into the list_
-  int tail_;
+  // The backing ring buffer, power of two sized
+  vector<T> buffer_;
+  // Capacity of the buffer minus one
+  uint32 mask_;
+  // The number of items in the window when it is full
+  int size_;
+  // Position of the next item, wrapped with mask_ when indexing
+  uint32 head_;
   // The current number of elements in this window
   int count_;
+  // The total number of samples taken by this indicator
+  int64 samples_;
+  // The most recently removed item from the window (fell off the back)
+  T most_recently_removed_;
 };
 
 }  // namespace indicators
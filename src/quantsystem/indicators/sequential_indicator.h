@@ -23,7 +23,7 @@
 #include <string>
 using std::string;
 #include "quantsystem/common/base/scoped_ptr.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 #include "quantsystem/indicators/indicator_base.h"
 namespace quantsystem {
 namespace indicators {
@@ -38,7 +38,7 @@ template <typename TFirst>
 class SequentialIndicator : public IndicatorBase<TFirst> {
  public:
   typedef IndicatorBase<TFirst> FirstType;
-  typedef IndicatorBase<IndicatorDataPoint> SecondType;
+  typedef IndicatorBase<IndicatorSample> SecondType;
   /**
    * Creates a new SequentialIndicator that will pipe the output of
    * the first into the second.
@@ -46,9 +46,9 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
    * @param first The first indicator to receive data
    * @param second The indicator to receive the first's output data
    */
-  SequentialIndicator(const string& name, const FirstType* first,
-                      const SecondType* second)
-      : IndicatorBase(name),
+  SequentialIndicator(const string& name, FirstType* first,
+                      SecondType* second)
+      : IndicatorBase<TFirst>(name),
         first_(first),
         second_(second) {
   }
@@ -59,9 +59,9 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
    * @param first The first indicator to receive data
    * @param second The indicator to receive the first's output data
    */
-  SequentialIndicator(const FirstType* first,
-                      const SecondType* second)
-      : IndicatorBase("SEQUENTIAL(" + first->name() + "->" +
+  SequentialIndicator(FirstType* first,
+                      SecondType* second)
+      : IndicatorBase<TFirst>("SEQUENTIAL(" + first->name() + "->" +
                       second->name() + ")"),
         first_(first),
         second_(second) {
@@ -70,7 +70,7 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
   /**
    * Gets a flag indicating when this indicator is ready and fully initialized.
    */
-  virtual bool is_ready() {
+  virtual bool is_ready() const {
     return second_->is_ready() && first_->is_ready();
   }
 
@@ -80,12 +80,12 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
   virtual void Reset() {
     first_->Reset();
     second_->Reset();
-    IndicatorBase::Reset();
+    IndicatorBase<TFirst>::Reset();
   }
 
-  FirstType* first() const { return first_; }
+  FirstType* first() const { return first_.get(); }
 
-  SecondType* second() const { return second_; }
+  SecondType* second() const { return second_.get(); }
 
  protected:
   /**
@@ -94,13 +94,13 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
    * @return A new value for this indicator.
    */
   virtual double ComputeNextValue(const TFirst& input) {
-    first_->Updata(input);
+    first_->Update(input);
     if (!first_->is_ready()) {
       // if the first isn't ready just send out a default value
       return 0;
     }
     second_->Update(first_->current());
-    return second_->current().value();
+    return second_->current().value;
   }
 
  private:
@@ -110,9 +110,9 @@ class SequentialIndicator : public IndicatorBase<TFirst> {
   // as its input data
   scoped_ptr<SecondType> second_;
 
-  void set_first(FirstType* first) { first_ = first; }
+  void set_first(FirstType* first) { first_.reset(first); }
 
-  void set_second(SecondType* second) { second_ = second; }
+  void set_second(SecondType* second) { second_.reset(second); }
 };
 
 }  // namespace indicators
@@ -23,24 +23,29 @@ using std::to_string;
 namespace quantsystem {
 namespace indicators {
 SimpleMovingAverage::SimpleMovingAverage(const string&name, int period)
-    : WindowIndicator<IndicatorDataPoint>(name, period),
+    : WindowIndicator<IndicatorSample>(name, period),
       sum_(0) {
 }
 
 SimpleMovingAverage::SimpleMovingAverage(int period)
-    : WindowIndicator<IndicatorDataPoint>("SMA" + to_string(period), period),
+    : WindowIndicator<IndicatorSample>("SMA" + to_string(period), period),
       sum_(0) {
 }
 
 double SimpleMovingAverage::ComputeNextValue(
-    IReadOnlyWindow<IndicatorDataPoint>* window,
-    const IndicatorDataPoint& input) {
-  sum_ += input.value();
+    IReadOnlyWindow<IndicatorSample>* window,
+    const IndicatorSample& input) {
+  sum_ += input.value;
   if (window->is_ready()) {
-    sum_ -= window->most_recently_removed().value();
+    sum_ -= window->most_recently_removed().value;
   }
   return sum_ / window->count();
 }
 
+void SimpleMovingAverage::Reset() {
+  sum_ = 0;
+  WindowIndicator<IndicatorSample>::Reset();
+}
+
 }  // namespace indicators
 }  // namespace quantsystem
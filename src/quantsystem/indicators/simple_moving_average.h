@@ -24,14 +24,14 @@
 using std::string;
 #include "quantsystem/indicators/window_indicator.h"
 #include "quantsystem/indicators/iread_only_window.h"
-#include "quantsystem/indicators/indicator_data_point.h"
+#include "quantsystem/indicators/indicator_sample.h"
 namespace quantsystem {
 namespace indicators {
 /**
  * Represents the traditional simple moving average indicator (SMA)
  * @ingroup IndicatorsLayer
  */
-class SimpleMovingAverage : public  WindowIndicator<IndicatorDataPoint> {
+class SimpleMovingAverage : public  WindowIndicator<IndicatorSample> {
  public:
   /**
    * Initializes a new instance of the SimpleMovingAverage class
@@ -48,6 +48,11 @@ class SimpleMovingAverage : public  WindowIndicator<IndicatorDataPoint> {
    */
   explicit SimpleMovingAverage(int period);
 
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
  protected:
   /**
    * Computes the next value for this indicator from the given state.
@@ -55,8 +60,8 @@ class SimpleMovingAverage : public  WindowIndicator<IndicatorDataPoint> {
    * @param input The input value to this indicator on this time step
    * @return A new value for this indicator
    */
-  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorDataPoint>* window,
-                                  const IndicatorDataPoint& input);
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
 
  private:
   double sum_;
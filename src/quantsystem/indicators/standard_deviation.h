@@ -0,0 +1,63 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_STANDARD_DEVIATION_H_
+#define QUANTSYSTEM_INDICATORS_STANDARD_DEVIATION_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/variance.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Population standard deviation of the samples over a rolling period,
+ * the square root of the Variance.
+ * @ingroup IndicatorsLayer
+ */
+class StandardDeviation : public Variance {
+ public:
+  /**
+   * Initializes a new instance of the StandardDeviation class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the standard deviation
+   */
+  StandardDeviation(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the StandardDeviation class with
+   * the default name and period.
+   * @param period The period of the standard deviation
+   */
+  explicit StandardDeviation(int period);
+
+ protected:
+  /**
+   * Computes the next value for this indicator from the given state.
+   * @param[out] window The window of data held in this indicator
+   * @param input The input value to this indicator on this time step
+   * @return A new value for this indicator
+   */
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_STANDARD_DEVIATION_H_
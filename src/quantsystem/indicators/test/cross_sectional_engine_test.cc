@@ -0,0 +1,177 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/base/scoped_ptr.h"
+#include "quantsystem/indicators/cross_sectional_engine.h"
+#include "quantsystem/indicators/exponential_indicator.h"
+#include "quantsystem/indicators/momentum.h"
+#include "quantsystem/indicators/momentum_percent.h"
+#include "quantsystem/indicators/simple_moving_average.h"
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+TEST(CrossSectionalEngine, TestColumnsMatchStreaming) {
+  const int kSymbols = 8;
+  CrossSectionalEngine engine;
+  int sma = engine.AddColumn(CrossSectionalEngine::kSimpleMovingAverage, 10);
+  int ema = engine.AddColumn(
+      CrossSectionalEngine::kExponentialMovingAverage, 12);
+  int mom = engine.AddColumn(CrossSectionalEngine::kMomentum, 5);
+  int momp = engine.AddColumn(CrossSectionalEngine::kMomentumPercent, 20);
+  vector<SimpleMovingAverage*> smas;
+  vector<ExponentialMovingAverage*> emas;
+  vector<Momentum*> moms;
+  vector<MomentumPercent*> momps;
+  vector<double> prices;
+  for (int i = 0; i < kSymbols; ++i) {
+    EXPECT_EQ(i, engine.Register("S" + std::to_string(i)));
+    smas.push_back(new SimpleMovingAverage(10));
+    emas.push_back(new ExponentialMovingAverage(12));
+    moms.push_back(new Momentum(5));
+    momps.push_back(new MomentumPercent(20));
+    prices.push_back(100);
+  }
+  srand(20150101);
+  for (int t = 0; t < 300; ++t) {
+    // Every other slice only a part of the universe trades
+    vector<int> ids;
+    vector<double> slice;
+    for (int i = 0; i < kSymbols; ++i) {
+      prices[i] += (rand() % 201 - 100) / 100.0;
+      if (t % 2 == 0 || rand() % 3 == 0) {
+        ids.push_back(i);
+        slice.push_back(prices[i]);
+      }
+    }
+    engine.Update(ids, slice);
+    for (int j = 0; j < ids.size(); ++j) {
+      IndicatorSample sample = MakeIndicatorSample(t, slice[j]);
+      smas[ids[j]]->Update(sample);
+      emas[ids[j]]->Update(sample);
+      moms[ids[j]]->Update(sample);
+      momps[ids[j]]->Update(sample);
+    }
+    for (int i = 0; i < kSymbols; ++i) {
+      ASSERT_EQ(smas[i]->value(), engine.value(sma, i)) << t << " " << i;
+      ASSERT_EQ(emas[i]->value(), engine.value(ema, i)) << t << " " << i;
+      ASSERT_EQ(moms[i]->value(), engine.value(mom, i)) << t << " " << i;
+      ASSERT_EQ(momps[i]->value(), engine.value(momp, i)) << t << " " << i;
+      ASSERT_EQ(smas[i]->is_ready(), engine.is_ready(sma, i));
+    }
+  }
+  for (int i = 0; i < kSymbols; ++i) {
+    delete smas[i];
+    delete emas[i];
+    delete moms[i];
+    delete momps[i];
+  }
+  EXPECT_EQ(-1, engine.AddColumn(CrossSectionalEngine::kMomentum, 3));
+}
+
+TEST(CrossSectionalEngine, TestRepeatedAndInvalidIds) {
+  CrossSectionalEngine engine;
+  CrossSectionalEngine expected;
+  CrossSectionalEngine* engines[] = {&engine, &expected};
+  for (int e = 0; e < 2; ++e) {
+    engines[e]->AddColumn(CrossSectionalEngine::kSimpleMovingAverage, 3);
+    engines[e]->AddColumn(CrossSectionalEngine::kMomentumPercent, 2);
+    engines[e]->Register("SPY");
+    engines[e]->Register("IBM");
+  }
+  for (int t = 0; t < 10; ++t) {
+    // SPY twice, IBM once, then two unknown rows
+    const int ids[] = {0, 1, 0, 2, -1};
+    const double prices[] = {100.0 + t, 50.0 - t, 101.5 + 2 * t, 1, 1};
+    engine.Update(vector<int>(ids, ids + 5),
+                  vector<double>(prices, prices + 5));
+    // Only the newest price of a row counts
+    vector<int> expected_ids;
+    expected_ids.push_back(0);
+    expected_ids.push_back(1);
+    vector<double> expected_prices;
+    expected_prices.push_back(prices[2]);
+    expected_prices.push_back(prices[1]);
+    expected.Update(expected_ids, expected_prices);
+    for (int id = 0; id < 2; ++id) {
+      ASSERT_EQ(expected.samples(id), engine.samples(id));
+      for (int c = 0; c < 2; ++c) {
+        ASSERT_DOUBLE_EQ(expected.value(c, id), engine.value(c, id))
+            << t << " " << c << " " << id;
+      }
+    }
+  }
+  EXPECT_EQ(10, engine.samples(0));
+}
+
+TEST(CrossSectionalEngine, TestQueries) {
+  CrossSectionalEngine engine;
+  int mom = engine.AddColumn(CrossSectionalEngine::kMomentum, 1);
+  const int kSymbols = 6;
+  for (int i = 0; i < kSymbols; ++i) {
+    engine.Register("S" + std::to_string(i));
+  }
+  double first[kSymbols] = {10, 10, 10, 10, 10, 10};
+  double second[kSymbols] = {13, 9, 15, 11, 9, 10};
+  engine.Update(first);
+  vector<int> ids;
+  engine.TopK(mom, 3, &ids);
+  EXPECT_TRUE(ids.empty());
+  engine.Update(second);
+  // Changes: 3, -1, 5, 1, -1, 0
+  EXPECT_EQ(kSymbols, engine.ReadyCount(mom));
+  engine.TopK(mom, 3, &ids);
+  ASSERT_EQ(3, ids.size());
+  EXPECT_EQ(2, ids[0]);
+  EXPECT_EQ(0, ids[1]);
+  EXPECT_EQ(3, ids[2]);
+  engine.BottomK(mom, 10, &ids);
+  ASSERT_EQ(kSymbols, ids.size());
+  EXPECT_EQ(2, ids[kSymbols - 1]);
+  vector<double> ranks;
+  engine.Rank(mom, &ranks);
+  EXPECT_EQ(0, ranks[1]);
+  EXPECT_EQ(0, ranks[4]);
+  EXPECT_EQ(2, ranks[5]);
+  EXPECT_EQ(5, ranks[2]);
+  vector<double> percentiles;
+  engine.Percentile(mom, &percentiles);
+  EXPECT_EQ(1, percentiles[2]);
+  EXPECT_EQ(0.4, percentiles[5]);
+  vector<double> scores;
+  engine.ZScore(mom, &scores);
+  double mean = 7.0 / 6, sum_of_squares = 0;
+  for (int i = 0; i < kSymbols; ++i) {
+    sum_of_squares += (second[i] - 10 - mean) * (second[i] - 10 - mean);
+  }
+  EXPECT_NEAR((5 - mean) / std::sqrt(sum_of_squares / kSymbols), scores[2],
+              1e-12);
+  // A new row is not ready and is left out of the queries
+  int late = engine.Register("LATE");
+  engine.ZScore(mom, &scores);
+  EXPECT_TRUE(std::isnan(scores[late]));
+  engine.TopK(mom, 10, &ids);
+  EXPECT_EQ(kSymbols, ids.size());
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,177 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/indicators/aroon_oscillator.h"
+#include "quantsystem/indicators/average_true_range.h"
+#include "quantsystem/indicators/indicator_batch.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/momentum.h"
+#include "quantsystem/indicators/momentum_percent.h"
+#include "quantsystem/indicators/moving_average_converagence_divergence.h"
+#include "quantsystem/indicators/moving_average_type_extensions.h"
+#include "quantsystem/indicators/relative_strength_index.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+using data::market::TradeBar;
+namespace indicators {
+namespace {
+const int kCount = 2000;
+
+// Random walk of bars, the close is the value series
+class Bars {
+ public:
+  vector<double> open, high, low, close;
+  explicit Bars(int count) {
+    srand(20150101);
+    double price = 100;
+    for (int i = 0; i < count; ++i) {
+      double next = price + (rand() % 201 - 100) / 100.0;
+      open.push_back(price);
+      close.push_back(next);
+      high.push_back(std::max(price, next) + (rand() % 50) / 100.0);
+      low.push_back(std::min(price, next) - (rand() % 50) / 100.0);
+      price = next;
+    }
+  }
+  int64 time(int i) const { return i * 60000000LL; }
+  IndicatorSample sample(int i) const {
+    return MakeIndicatorSample(time(i), close[i]);
+  }
+};
+
+void ExpectStreamingEquals(IndicatorBase<IndicatorSample>* indicator,
+                           const Bars& bars, const vector<double>& batch) {
+  for (int i = 0; i < kCount; ++i) {
+    indicator->Update(bars.sample(i));
+    ASSERT_EQ(indicator->value(), batch[i]) << indicator->name() << " " << i;
+  }
+}
+
+void ExpectMovingAverageEquals(MovingAverageType type, int period,
+                               const Bars& bars) {
+  vector<double> batch(kCount);
+  ComputeMovingAverage(type, period, bars.close.data(), kCount, batch.data());
+  scoped_ptr<IndicatorBase<IndicatorSample> > indicator(
+      ToIndicator(type, period));
+  ExpectStreamingEquals(indicator.get(), bars, batch);
+}
+}  // namespace
+
+TEST(IndicatorBatch, TestMovingAveragesMatchStreaming) {
+  Bars bars(kCount);
+  ExpectMovingAverageEquals(kSimple, 20, bars);
+  ExpectMovingAverageEquals(kExponential, 20, bars);
+  ExpectMovingAverageEquals(kWilders, 14, bars);
+}
+
+TEST(IndicatorBatch, TestMomentumMatchesStreaming) {
+  Bars bars(kCount);
+  vector<double> batch(kCount);
+  ComputeMomentum(10, bars.close.data(), kCount, batch.data());
+  Momentum momentum(10);
+  ExpectStreamingEquals(&momentum, bars, batch);
+  ComputeMomentumPercent(10, bars.close.data(), kCount, batch.data());
+  MomentumPercent momentum_percent(10);
+  ExpectStreamingEquals(&momentum_percent, bars, batch);
+}
+
+TEST(IndicatorBatch, TestMacdMatchesStreaming) {
+  Bars bars(kCount);
+  vector<double> batch(kCount), signal(kCount);
+  ComputeMovingAverageConvergenceDivergence(
+      12, 26, 9, kExponential, bars.close.data(), kCount, batch.data(),
+      signal.data());
+  MovingAverageConvergenceDivergence macd(12, 26, 9, kExponential);
+  for (int i = 0; i < kCount; ++i) {
+    macd.Update(bars.sample(i));
+    ASSERT_EQ(macd.value(), batch[i]) << i;
+    ASSERT_EQ(macd.signal()->value(), signal[i]) << i;
+  }
+}
+
+TEST(IndicatorBatch, TestRsiMatchesStreaming) {
+  Bars bars(kCount);
+  vector<double> batch(kCount);
+  ComputeRelativeStrengthIndex(14, kWilders, bars.close.data(), kCount,
+                               batch.data());
+  RelativeStrengthIndex rsi(14, kWilders);
+  ExpectStreamingEquals(&rsi, bars, batch);
+}
+
+TEST(IndicatorBatch, TestBarIndicatorsMatchStreaming) {
+  Bars bars(kCount);
+  vector<double> atr_batch(kCount), aroon_batch(kCount);
+  ComputeAverageTrueRange(14, kWilders, bars.high.data(), bars.low.data(),
+                          bars.close.data(), kCount, atr_batch.data());
+  ComputeAroonOscillator(25, 25, bars.high.data(), bars.low.data(), kCount,
+                         aroon_batch.data());
+  AverageTrueRange atr(14, kWilders);
+  AroonOscillator aroon(25, 25);
+  for (int i = 0; i < kCount; ++i) {
+    TradeBar bar(FromSampleTime(bars.time(i)), "SPY", bars.open[i],
+                 bars.high[i], bars.low[i], bars.close[i], 1000);
+    atr.Update(bar);
+    aroon.Update(bar);
+    ASSERT_EQ(atr.value(), atr_batch[i]) << i;
+    ASSERT_EQ(aroon.value(), aroon_batch[i]) << i;
+  }
+}
+
+// Timing only, the equality is covered by the tests above. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(IndicatorBatch, DISABLED_BenchmarkBatchAgainstStreaming) {
+  const int kBenchmarkCount = 1000000;
+  Bars bars(kBenchmarkCount);
+  vector<double> batch(kBenchmarkCount);
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  ComputeSimpleMovingAverage(50, bars.close.data(), kBenchmarkCount,
+                             batch.data());
+  ComputeMomentum(50, bars.close.data(), kBenchmarkCount, batch.data());
+  ComputeRelativeStrengthIndex(14, kWilders, bars.close.data(),
+                               kBenchmarkCount, batch.data());
+  Clock::duration batch_time = Clock::now() - start;
+  start = Clock::now();
+  SimpleMovingAverage sma(50);
+  Momentum momentum(50);
+  RelativeStrengthIndex rsi(14, kWilders);
+  for (int i = 0; i < kBenchmarkCount; ++i) {
+    IndicatorSample sample = bars.sample(i);
+    sma.Update(sample);
+    momentum.Update(sample);
+    rsi.Update(sample);
+  }
+  Clock::duration streaming_time = Clock::now() - start;
+  EXPECT_EQ(rsi.value(), batch[kBenchmarkCount - 1]);
+  LOG(INFO) << "SMA, MOM and RSI over " << kBenchmarkCount << " values: " <<
+      "batch " << std::chrono::duration_cast<std::chrono::microseconds>(
+          batch_time).count() << "us, streaming " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          streaming_time).count() << "us";
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,75 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/indicators/indicator_graph.h"
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+TEST(IndicatorGraph, TestNodesAreShared) {
+  IndicatorGraph graph("(SPY_min)");
+  ExponentialMovingAverage* ema = graph.EMA(12);
+  MovingAverageConvergenceDivergence* macd = graph.MACD(12, 26, 9,
+                                                        kExponential);
+  EXPECT_EQ(3, graph.size());
+  EXPECT_EQ(ema, macd->fast());
+  EXPECT_EQ(macd, graph.MACD(12, 26, 9, kExponential));
+  EXPECT_EQ(macd->slow(), graph.EMA(26));
+  EXPECT_NE(static_cast<void*>(graph.SMA(12)), static_cast<void*>(ema));
+  EXPECT_EQ("EMA12(SPY_min)", ema->name());
+  EXPECT_EQ(4, graph.size());
+}
+
+TEST(IndicatorGraph, TestSharedNodesMatchStandalone) {
+  IndicatorGraph graph("(SPY_min)");
+  ExponentialMovingAverage* ema = graph.EMA(12);
+  MovingAverageConvergenceDivergence* macd = graph.MACD(12, 26, 9,
+                                                        kExponential);
+  AverageTrueRange* atr = graph.ATR(14, kWilders);
+  ExponentialMovingAverage standalone_ema(12);
+  MovingAverageConvergenceDivergence standalone_macd(12, 26, 9, kExponential);
+  AverageTrueRange standalone_atr(14, kWilders);
+  srand(20150101);
+  double price = 100;
+  for (int i = 0; i < 500; ++i) {
+    double next = price + (rand() % 201 - 100) / 100.0;
+    TradeBar bar(FromSampleTime(i * 60000000LL), "SPY", price,
+                 std::max(price, next) + 0.1, std::min(price, next) - 0.1,
+                 next, 1000);
+    graph.Update(bar);
+    standalone_ema.Update(ToIndicatorSample(bar));
+    standalone_macd.Update(ToIndicatorSample(bar));
+    standalone_atr.Update(bar);
+    ASSERT_EQ(standalone_ema.value(), ema->value()) << i;
+    ASSERT_EQ(standalone_macd.value(), macd->value()) << i;
+    ASSERT_EQ(standalone_macd.signal()->value(), macd->signal()->value())
+        << i;
+    ASSERT_EQ(standalone_macd.is_ready(), macd->is_ready()) << i;
+    ASSERT_EQ(standalone_atr.value(), atr->value()) << i;
+    price = next;
+  }
+  graph.Reset();
+  EXPECT_FALSE(macd->is_ready());
+  EXPECT_EQ(0, ema->samples());
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,115 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/delay.h"
+#include "quantsystem/indicators/exponential_indicator.h"
+#include "quantsystem/indicators/indicator_pipeline.h"
+#include "quantsystem/indicators/momentum.h"
+#include "quantsystem/indicators/sequential_indicator.h"
+#include "quantsystem/indicators/simple_moving_average.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+namespace {
+typedef pipeline::Pipeline<pipeline::EMA<12>, pipeline::Delay<1>,
+                           pipeline::Momentum<10> > EmaMomentum;
+
+// The same chain built from runtime indicators
+SequentialIndicator<IndicatorSample>* NewRuntimeChain() {
+  return new SequentialIndicator<IndicatorSample>(
+      new ExponentialMovingAverage(12),
+      new SequentialIndicator<IndicatorSample>(new Delay(1),
+                                               new Momentum(10)));
+}
+
+vector<double> RandomWalk(int count) {
+  srand(20150101);
+  vector<double> prices;
+  double price = 100;
+  for (int i = 0; i < count; ++i) {
+    price += (rand() % 201 - 100) / 100.0;
+    prices.push_back(price);
+  }
+  return prices;
+}
+}  // namespace
+
+TEST(IndicatorPipeline, TestPipelineMatchesRuntimeChain) {
+  vector<double> prices = RandomWalk(1000);
+  EmaMomentum pipeline;
+  PipelineIndicator<EmaMomentum> indicator("EMA12->DELAY1->MOM10");
+  scoped_ptr<SequentialIndicator<IndicatorSample> > chain(NewRuntimeChain());
+  pipeline::Pipeline<pipeline::SMA<5>, pipeline::Wilders<3> > smoothed;
+  SimpleMovingAverage sma(5);
+  ExponentialMovingAverage wilders(3, 1.0 / 3);
+  for (int i = 0; i < prices.size(); ++i) {
+    IndicatorSample sample = MakeIndicatorSample(i, prices[i]);
+    double value = pipeline.Update(prices[i]);
+    indicator.Update(sample);
+    chain->Update(sample);
+    ASSERT_EQ(chain->value(), value) << i;
+    ASSERT_EQ(chain->value(), indicator.value()) << i;
+    ASSERT_EQ(chain->is_ready(), pipeline.is_ready()) << i;
+    ASSERT_EQ(chain->is_ready(), indicator.is_ready()) << i;
+    sma.Update(sample);
+    double expected = 0;
+    if (sma.is_ready()) {
+      wilders.Update(sma.current());
+      expected = wilders.value();
+    }
+    ASSERT_EQ(expected, smoothed.Update(prices[i])) << i;
+  }
+  indicator.Reset();
+  EXPECT_FALSE(indicator.is_ready());
+}
+
+TEST(IndicatorPipeline, BenchmarkPipelineAgainstRuntimeChain) {
+  const int kCount = 1000000;
+  vector<double> prices = RandomWalk(kCount);
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  EmaMomentum pipeline;
+  double pipeline_sum = 0;
+  for (int i = 0; i < kCount; ++i) {
+    pipeline_sum += pipeline.Update(prices[i]);
+  }
+  Clock::duration pipeline_time = Clock::now() - start;
+  start = Clock::now();
+  scoped_ptr<SequentialIndicator<IndicatorSample> > chain(NewRuntimeChain());
+  double chain_sum = 0;
+  for (int i = 0; i < kCount; ++i) {
+    chain->Update(MakeIndicatorSample(i, prices[i]));
+    chain_sum += chain->value();
+  }
+  Clock::duration chain_time = Clock::now() - start;
+  EXPECT_EQ(chain_sum, pipeline_sum);
+  LOG(INFO) << "EMA12->DELAY1->MOM10 over " << kCount << " values: " <<
+      "pipeline " << std::chrono::duration_cast<std::chrono::microseconds>(
+          pipeline_time).count() << "us, runtime chain " <<
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          chain_time).count() << "us";
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,142 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/common/data/market/tradebar.h"
+#include "quantsystem/indicators/average_true_range.h"
+#include "quantsystem/indicators/moving_average_converagence_divergence.h"
+#include "quantsystem/indicators/relative_strength_index.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+namespace {
+using data::market::TradeBar;
+const time_t kStart = 1420119000;  // 2015-01-01 13:30:00 UTC
+
+vector<double> RandomWalk(int count, double start) {
+  srand(11);
+  vector<double> values;
+  double value = start;
+  for (int i = 0; i < count; ++i) {
+    value += (rand() % 201 - 100) / 100.0;
+    values.push_back(value);
+  }
+  return values;
+}
+
+// Exponential average seeded with its first input, as the indicator
+class Smoother {
+ public:
+  explicit Smoother(double k) : k_(k), samples_(0), value_(0) {}
+  void Add(double value) {
+    value_ = samples_++ == 0 ? value : value * k_ + value_ * (1 - k_);
+  }
+  double value() const { return value_; }
+ private:
+  double k_;
+  int samples_;
+  double value_;
+};
+}  // namespace
+
+TEST(IndicatorSample, TestRelativeStrengthIndex) {
+  const int period = 14;
+  const vector<double> closes = RandomWalk(300, 100);
+  RelativeStrengthIndex wilders(period);
+  RelativeStrengthIndex simple(period, kSimple);
+  Smoother gain(1.0 / period), loss(1.0 / period);
+  for (int i = 0; i < closes.size(); ++i) {
+    IndicatorSample sample = MakeIndicatorSample(i, closes[i]);
+    EXPECT_EQ(i > period, wilders.Update(sample));
+    simple.Update(sample);
+    if (i > 0) {
+      double change = closes[i] - closes[i - 1];
+      gain.Add(std::max(change, 0.0));
+      loss.Add(std::max(-change, 0.0));
+    }
+    double expected = loss.value() == 0
+        ? 100 : 100 - 100 / (1 + gain.value() / loss.value());
+    ASSERT_NEAR(expected, wilders.current().value, 1e-9) << i;
+    if (i >= period) {
+      // Simple averages of the last period changes
+      double gains = 0, losses = 0;
+      for (int j = i - period + 1; j <= i; ++j) {
+        double change = closes[j] - closes[j - 1];
+        gains += std::max(change, 0.0);
+        losses += std::max(-change, 0.0);
+      }
+      expected = losses == 0 ? 100 : 100 - 100 / (1 + gains / losses);
+      ASSERT_NEAR(expected, simple.current().value, 1e-9) << i;
+    }
+  }
+}
+
+TEST(IndicatorSample, TestAverageTrueRange) {
+  const int period = 5;
+  const vector<double> closes = RandomWalk(100, 50);
+  AverageTrueRange atr(period);
+  Smoother expected(1.0 / period);
+  for (int i = 0; i < closes.size(); ++i) {
+    double open = i > 0 ? closes[i - 1] + 0.3 : closes[i];
+    double high = std::max(open, closes[i]) + 0.25 * (i % 3);
+    double low = std::min(open, closes[i]) - 0.5 * (i % 2);
+    TradeBar bar(DateTime(kStart + 60 * i), "SPY", open, high, low,
+                 closes[i], 100);
+    atr.Update(bar);
+    double true_range = high - low;
+    if (i > 0) {
+      true_range = std::max(true_range,
+                            std::max(std::fabs(high - closes[i - 1]),
+                                     std::fabs(low - closes[i - 1])));
+    }
+    expected.Add(true_range);
+    ASSERT_NEAR(expected.value(), atr.current().value, 1e-9) << i;
+  }
+  EXPECT_TRUE(atr.is_ready());
+}
+
+TEST(IndicatorSample, TestMovingAverageConvergenceDivergence) {
+  MovingAverageConvergenceDivergence macd(2, 4, 3, kSimple);
+  const double closes[] = {10.1, 10.3, 10.2, 10.6, 10.5, 10.4, 10.9, 11.0};
+  vector<double> differences;
+  for (int i = 0; i < 8; ++i) {
+    macd.Update(MakeIndicatorSample(i, closes[i]));
+    if (i < 3) {
+      continue;
+    }
+    // The difference keeps its fraction
+    double fast = (closes[i] + closes[i - 1]) / 2;
+    double slow = (closes[i] + closes[i - 1] + closes[i - 2] +
+                   closes[i - 3]) / 4;
+    ASSERT_NEAR(fast - slow, macd.current().value, 1e-12) << i;
+    differences.push_back(fast - slow);
+  }
+  // The signal averages the last 3 differences
+  double signal = (differences[2] + differences[3] + differences[4]) / 3;
+  EXPECT_NEAR(signal, macd.signal()->value(), 1e-12);
+  EXPECT_NEAR(0.25, differences.back(), 1e-12);
+}
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,112 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/maximum.h"
+#include "quantsystem/indicators/minimum.h"
+#include "quantsystem/indicators/monotonic_deque.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+namespace {
+// Small integer values so the windows are full of ties
+vector<double> RandomValues(int count) {
+  srand(7);
+  vector<double> values;
+  for (int i = 0; i < count; ++i) {
+    values.push_back(rand() % 5);
+  }
+  return values;
+}
+
+// Brute force extreme of the last period values ending at end, ties
+// resolved to the most recent value
+class WindowExtreme {
+ public:
+  double maximum;
+  double minimum;
+  int periods_since_maximum;
+  int periods_since_minimum;
+  WindowExtreme(const vector<double>& values, int end, int period) {
+    const int start = end - period + 1 > 0 ? end - period + 1 : 0;
+    int max_index = start, min_index = start;
+    for (int i = start; i <= end; ++i) {
+      if (values[i] >= values[max_index]) max_index = i;
+      if (values[i] <= values[min_index]) min_index = i;
+    }
+    maximum = values[max_index];
+    minimum = values[min_index];
+    periods_since_maximum = end - max_index;
+    periods_since_minimum = end - min_index;
+  }
+};
+}  // namespace
+
+TEST(MonotonicDeque, TestMatchesBruteForceWindow) {
+  const vector<double> values = RandomValues(500);
+  const int periods[] = {1, 2, 3, 8, 13, 64};
+  for (int p = 0; p < 6; ++p) {
+    MaximumDeque maximum(periods[p]);
+    MinimumDeque minimum(periods[p]);
+    for (int i = 0; i < values.size(); ++i) {
+      maximum.Add(values[i]);
+      minimum.Add(values[i]);
+      WindowExtreme expected(values, i, periods[p]);
+      ASSERT_EQ(expected.maximum, maximum.value()) << periods[p] << " " << i;
+      ASSERT_EQ(expected.minimum, minimum.value()) << periods[p] << " " << i;
+      ASSERT_EQ(expected.periods_since_maximum, maximum.periods_since());
+      ASSERT_EQ(expected.periods_since_minimum, minimum.periods_since());
+    }
+    EXPECT_EQ(values.size(), maximum.samples());
+  }
+}
+
+TEST(MonotonicDeque, TestMaximumAndMinimumIndicators) {
+  const vector<double> values = RandomValues(200);
+  const int periods[] = {1, 5, 20};
+  for (int p = 0; p < 3; ++p) {
+    Maximum maximum(periods[p]);
+    Minimum minimum(periods[p]);
+    EXPECT_EQ(periods[p], maximum.period());
+    for (int i = 0; i < values.size(); ++i) {
+      IndicatorSample sample = MakeIndicatorSample(i, values[i]);
+      EXPECT_EQ(i + 1 >= periods[p], maximum.Update(sample));
+      EXPECT_EQ(i + 1 >= periods[p], minimum.Update(sample));
+      WindowExtreme expected(values, i, periods[p]);
+      ASSERT_EQ(expected.maximum, maximum.current().value);
+      ASSERT_EQ(expected.minimum, minimum.current().value);
+      ASSERT_EQ(expected.periods_since_maximum,
+                maximum.periods_since_maximum());
+      ASSERT_EQ(expected.periods_since_minimum,
+                minimum.periods_since_minimum());
+    }
+    // Reset starts a new window
+    maximum.Reset();
+    EXPECT_FALSE(maximum.is_ready());
+    maximum.Update(MakeIndicatorSample(0, -1));
+    EXPECT_EQ(-1, maximum.current().value);
+    EXPECT_EQ(0, maximum.periods_since_maximum());
+  }
+}
+}  // namespace indicators
+}  // namespace quantsystem
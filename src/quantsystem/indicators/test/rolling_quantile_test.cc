@@ -0,0 +1,94 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/median.h"
+#include "quantsystem/indicators/quantile.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+namespace {
+// Interpolated quantile of the last period values ending at end
+double SortedQuantile(const vector<double>& values, int end, int period,
+                      double quantile) {
+  const int start = end - period + 1 > 0 ? end - period + 1 : 0;
+  vector<double> sorted(values.begin() + start, values.begin() + end + 1);
+  std::sort(sorted.begin(), sorted.end());
+  const double position = quantile * (sorted.size() - 1);
+  const int below = static_cast<int>(std::floor(position));
+  if (below + 1 >= sorted.size()) {
+    return sorted[below];
+  }
+  return sorted[below] + (position - below) *
+      (sorted[below + 1] - sorted[below]);
+}
+}  // namespace
+
+TEST(RollingQuantile, TestMatchesSortedWindow) {
+  srand(20150101);
+  // Few distinct values so the window holds many duplicates
+  vector<double> values;
+  for (int i = 0; i < 2000; ++i) {
+    values.push_back(rand() % 50 - 25);
+  }
+  const double quantiles[] = {0, 0.1, 0.25, 0.5, 0.9, 1};
+  const int periods[] = {1, 2, 7, 50};
+  for (int p = 0; p < 4; ++p) {
+    for (int q = 0; q < 6; ++q) {
+      Quantile quantile(periods[p], quantiles[q]);
+      for (int i = 0; i < values.size(); ++i) {
+        quantile.Update(MakeIndicatorSample(i, values[i]));
+        ASSERT_DOUBLE_EQ(
+            SortedQuantile(values, i, periods[p], quantiles[q]),
+            quantile.value()) << quantile.name() << " at " << i;
+      }
+    }
+  }
+}
+
+TEST(RollingQuantile, TestMedianAndReset) {
+  Median median(4);
+  EXPECT_EQ("MEDIAN4", median.name());
+  median.Update(MakeIndicatorSample(0, 5));
+  EXPECT_EQ(5, median.value());
+  median.Update(MakeIndicatorSample(1, 1));
+  EXPECT_EQ(3, median.value());
+  median.Update(MakeIndicatorSample(2, 9));
+  EXPECT_EQ(5, median.value());
+  median.Update(MakeIndicatorSample(3, 7));
+  EXPECT_EQ(6, median.value());
+  EXPECT_FALSE(median.is_ready());
+  median.Update(MakeIndicatorSample(4, 2));
+  EXPECT_TRUE(median.is_ready());
+  EXPECT_EQ(4.5, median.value());
+  median.Reset();
+  EXPECT_FALSE(median.is_ready());
+  median.Update(MakeIndicatorSample(0, 8));
+  EXPECT_EQ(8, median.value());
+  Quantile upper(20, 0.9);
+  EXPECT_EQ("QUANTILE20_90", upper.name());
+}
+}  // namespace indicators
+}  // namespace quantsystem
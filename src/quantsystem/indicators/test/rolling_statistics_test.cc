@@ -0,0 +1,154 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/beta.h"
+#include "quantsystem/indicators/correlation.h"
+#include "quantsystem/indicators/covariance.h"
+#include "quantsystem/indicators/linear_regression_slope.h"
+#include "quantsystem/indicators/standard_deviation.h"
+#include "quantsystem/indicators/variance.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+namespace {
+// Two pass statistics of the last period values of x and y ending at end
+class Reference {
+ public:
+  double variance;
+  double covariance;
+  double correlation;
+  double beta;
+  double slope;
+  Reference(const vector<double>& x, const vector<double>& y, int end,
+            int period) {
+    const int start = end - period + 1 > 0 ? end - period + 1 : 0;
+    const int n = end - start + 1;
+    double mean_x = 0, mean_y = 0, mean_i = (n - 1) / 2.0;
+    for (int i = start; i <= end; ++i) {
+      mean_x += x[i] / n;
+      mean_y += y[i] / n;
+    }
+    double m2_x = 0, m2_y = 0, c_xy = 0, m2_i = 0, c_iy = 0;
+    for (int i = start; i <= end; ++i) {
+      m2_x += (x[i] - mean_x) * (x[i] - mean_x);
+      m2_y += (y[i] - mean_y) * (y[i] - mean_y);
+      c_xy += (x[i] - mean_x) * (y[i] - mean_y);
+      m2_i += (i - start - mean_i) * (i - start - mean_i);
+      c_iy += (i - start - mean_i) * (y[i] - mean_y);
+    }
+    variance = m2_y / n;
+    covariance = c_xy / n;
+    correlation = m2_x * m2_y > 0 ? c_xy / std::sqrt(m2_x * m2_y) : 0;
+    beta = m2_x > 0 ? c_xy / m2_x : 0;
+    slope = m2_i > 0 ? c_iy / m2_i : 0;
+  }
+};
+
+vector<double> RandomWalk(int count, double start) {
+  vector<double> values;
+  double value = start;
+  for (int i = 0; i < count; ++i) {
+    value += (rand() % 201 - 100) / 100.0;
+    values.push_back(value);
+  }
+  return values;
+}
+
+template <typename T>
+void ExpectClose(double expected, const IndicatorBase<T>& actual,
+                 double tolerance, int i) {
+  ASSERT_NEAR(expected, actual.value(),
+              tolerance * (1 + std::fabs(expected))) << actual.name() <<
+      " at " << i;
+}
+
+// The tolerance is relative to the statistic, the rounding error of the
+// running updates grows with the magnitude of the samples.
+void CheckAgainstReference(int count, int period, double start,
+                           double tolerance) {
+  vector<double> x = RandomWalk(count, start);
+  vector<double> y = RandomWalk(count, start);
+  Variance variance(period);
+  StandardDeviation deviation(period);
+  Covariance covariance(period);
+  Correlation correlation(period);
+  Beta beta(period);
+  LinearRegressionSlope slope(period);
+  for (int i = 0; i < count; ++i) {
+    IndicatorSample sample = MakeIndicatorSample(i, y[i]);
+    IndicatorPairSample pair = MakeIndicatorPairSample(i, x[i], y[i]);
+    variance.Update(sample);
+    deviation.Update(sample);
+    covariance.Update(pair);
+    correlation.Update(pair);
+    beta.Update(pair);
+    slope.Update(sample);
+    Reference expected(x, y, i, period);
+    ExpectClose(expected.variance, variance, tolerance, i);
+    ExpectClose(std::sqrt(expected.variance), deviation, tolerance, i);
+    ExpectClose(expected.covariance, covariance, tolerance, i);
+    ExpectClose(expected.correlation, correlation, tolerance, i);
+    ExpectClose(expected.beta, beta, tolerance, i);
+    ExpectClose(expected.slope, slope, tolerance, i);
+    if (::testing::Test::HasFatalFailure()) {
+      return;
+    }
+    ASSERT_EQ(i >= period, variance.is_ready());
+  }
+}
+}  // namespace
+
+TEST(RollingStatistics, TestMatchesTwoPassStatistics) {
+  srand(20150101);
+  CheckAgainstReference(3000, 20, 100, 1e-9);
+  CheckAgainstReference(3000, 1, 100, 1e-9);
+}
+
+TEST(RollingStatistics, TestResumBoundsDriftAtLargeOffsets) {
+  srand(20150102);
+  CheckAgainstReference(50000, 10, 1e6, 1e-5);
+}
+
+TEST(RollingStatistics, TestConstantSeriesAndReset) {
+  Correlation correlation(5);
+  Beta beta(5);
+  StandardDeviation deviation(5);
+  for (int i = 0; i < 10; ++i) {
+    correlation.Update(MakeIndicatorPairSample(i, 3, i));
+    beta.Update(MakeIndicatorPairSample(i, 3, i));
+    deviation.Update(MakeIndicatorSample(i, 42));
+  }
+  EXPECT_EQ(0, correlation.value());
+  EXPECT_EQ(0, beta.value());
+  EXPECT_EQ(0, deviation.value());
+  EXPECT_TRUE(deviation.is_ready());
+  deviation.Reset();
+  EXPECT_FALSE(deviation.is_ready());
+  deviation.Update(MakeIndicatorSample(0, 1));
+  deviation.Update(MakeIndicatorSample(1, 3));
+  EXPECT_DOUBLE_EQ(1, deviation.value());
+}
+}  // namespace indicators
+}  // namespace quantsystem
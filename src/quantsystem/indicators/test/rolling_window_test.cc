@@ -0,0 +1,87 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <vector>
+using std::vector;
+#include "quantsystem/indicators/rolling_window.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace quantsystem {
+namespace indicators {
+TEST(RollingWindow, TestCapacityIsPowerOfTwo) {
+  RollingWindow<int> window(5);
+  EXPECT_EQ(5, window.size());
+  EXPECT_EQ(8, window.capacity());
+  RollingWindow<int> exact(4);
+  EXPECT_EQ(4, exact.capacity());
+}
+
+TEST(RollingWindow, TestIndexingAndRemoval) {
+  RollingWindow<int> window(3);
+  window.Add(1);
+  window.Add(2);
+  EXPECT_EQ(2, window.count());
+  EXPECT_EQ(2, window[0]);
+  EXPECT_EQ(1, window[1]);
+  EXPECT_FALSE(window.is_ready());
+  window.Add(3);
+  window.Add(4);
+  EXPECT_TRUE(window.is_ready());
+  EXPECT_EQ(3, window.count());
+  EXPECT_EQ(4, window.samples());
+  EXPECT_EQ(4, window[0]);
+  EXPECT_EQ(3, window[1]);
+  EXPECT_EQ(2, window[2]);
+  EXPECT_EQ(1, window.most_recently_removed());
+  window.Add(5);
+  EXPECT_EQ(2, window.most_recently_removed());
+}
+
+TEST(RollingWindow, TestSpansAreOldestFirst) {
+  RollingWindow<int> window(5);
+  for (int i = 1; i <= 11; ++i) {
+    window.Add(i);
+    RollingWindow<int>::Span first, second;
+    window.GetSpans(&first, &second);
+    EXPECT_EQ(window.count(), first.size + second.size);
+    vector<int> items(window.count());
+    window.CopyTo(items.data());
+    for (int j = 0; j < window.count(); ++j) {
+      int expected = i - window.count() + 1 + j;
+      EXPECT_EQ(expected, items[j]);
+      EXPECT_EQ(expected, j < first.size ? first.data[j]
+                                         : second.data[j - first.size]);
+    }
+  }
+}
+
+TEST(RollingWindow, TestResetKeepsCapacity) {
+  RollingWindow<int> window(3);
+  window.Add(1);
+  window.Add(2);
+  window.Reset();
+  EXPECT_EQ(0, window.count());
+  EXPECT_EQ(0, window.samples());
+  EXPECT_EQ(4, window.capacity());
+  window.Add(7);
+  EXPECT_EQ(7, window[0]);
+}
+}  // namespace indicators
+}  // namespace quantsystem
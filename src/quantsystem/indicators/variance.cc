@@ -0,0 +1,54 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#include <string>
+using std::to_string;
+#include "quantsystem/indicators/variance.h"
+namespace quantsystem {
+namespace indicators {
+Variance::Variance(const string& name, int period)
+    : WindowIndicator<IndicatorSample>(name, period),
+      moments_(period) {
+}
+
+Variance::Variance(int period)
+    : WindowIndicator<IndicatorSample>("VAR" + to_string(period), period),
+      moments_(period) {
+}
+
+void Variance::Reset() {
+  WindowIndicator<IndicatorSample>::Reset();
+  moments_.Reset();
+}
+
+double Variance::ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input) {
+  if (window->is_ready()) {
+    moments_.Replace(window->most_recently_removed().value, input.value);
+    if (moments_.needs_resum()) {
+      moments_.Resum(this->window());
+    }
+  } else {
+    moments_.Add(input.value);
+  }
+  return moments_.variance();
+}
+
+}  // namespace indicators
+}  // namespace quantsystem
@@ -0,0 +1,82 @@
+/*
+ * \copyright Copyright 2015 All Rights Reserved.
+ * \license @{
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @}
+ */
+
+#ifndef QUANTSYSTEM_INDICATORS_VARIANCE_H_
+#define QUANTSYSTEM_INDICATORS_VARIANCE_H_
+
+#include <string>
+using std::string;
+#include "quantsystem/indicators/window_indicator.h"
+#include "quantsystem/indicators/iread_only_window.h"
+#include "quantsystem/indicators/indicator_sample.h"
+#include "quantsystem/indicators/rolling_moments.h"
+namespace quantsystem {
+namespace indicators {
+/**
+ * Population variance of the samples over a rolling period.
+ *
+ * The variance is maintained by RollingMoments, so an update costs the
+ * same for any period and the moments are resummed from the window at
+ * regular intervals to stop rounding drift.
+ * @ingroup IndicatorsLayer
+ */
+class Variance : public WindowIndicator<IndicatorSample> {
+ public:
+  /**
+   * Initializes a new instance of the Variance class
+   * with the specified name and period.
+   * @param name The name of this indicator
+   * @param period The period of the variance
+   */
+  Variance(const string& name, int period);
+
+  /**
+   * Initializes a new instance of the Variance class with
+   * the default name and period.
+   * @param period The period of the variance
+   */
+  explicit Variance(int period);
+
+  /**
+   * Resets this indicator to its initial state.
+   */
+  virtual void Reset();
+
+ protected:
+  /**
+   * Computes the next value for this indicator from the given state.
+   * @param[out] window The window of data held in this indicator
+   * @param input The input value to this indicator on this time step
+   * @return A new value for this indicator
+   */
+  virtual double ComputeNextValue(IReadOnlyWindow<IndicatorSample>* window,
+                                  const IndicatorSample& input);
+
+  /**
+   * Moments of the samples of the window.
+   */
+  const RollingMoments& moments() const { return moments_; }
+
+ private:
+  RollingMoments moments_;
+};
+
+}  // namespace indicators
+}  // namespace quantsystem
+#endif  // QUANTSYSTEM_INDICATORS_VARIANCE_H_
@@ -57,6 +57,13 @@ class WindowIndicator : public IndicatorBase<T> {
     return window_.size();
   }
 
+  /**
+   * Gets the window of data held in this indicator.
+   */
+  const RollingWindow<T>& window() const {
+    return window_;
+  }
+
  protected:
   /**
    * Initializes a new instance of the WindowIndicator class.
@@ -65,8 +72,8 @@ class WindowIndicator : public IndicatorBase<T> {
    */
   WindowIndicator(const string& name, int period)
       : IndicatorBase<T>(name),
-      window_(RollingWindow<T>(period)) {
-}
+        window_(period) {
+  }
 
   /**
    * Computes the next value of this indicator from the given state.